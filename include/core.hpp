@@ -34,13 +34,7 @@ SOFTWARE.
 #include <cmath>
 #include <algorithm>
 #include "utils.hpp"
-
-// sort entries in an array in parallel
-void parallelSort(int size, int rank, MPI_Comm comm,
-      int N, void *vv, size_t sz,
-      int (*compare)(const void *, const void *),
-      void (*match)(void *, void *)
-      );
+#include "parallelSort.hpp"
 
 // find a factorization n = nx*ny such that
 //  nx>=ny are 'close' to one another
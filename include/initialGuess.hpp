@@ -44,6 +44,9 @@ public:
 
   virtual void FormInitialGuess(occa::memory& o_x, occa::memory& o_rhs) = 0;
   virtual void Update(solver_t& solver, occa::memory& o_x, occa::memory& o_rhs) = 0;
+
+  // Iteration count of the solve that followed FormInitialGuess.
+  virtual void RecordIterations(const int Niter) {}
 };
 
 // Default initial guess strategy:  use whatever the user gave us.
@@ -125,6 +128,54 @@ public:
   void Update(solver_t &solver, occa::memory& o_x, occa::memory& o_rhs);
 };
 
+// Adaptive projection strategy. The dimension of the space is chosen from the
+// observed iteration savings, all basis inner products of an update are
+// batched into one reduction, and the bases can be held in single precision.
+class igAdaptiveProjectionStrategy : public initialGuessStrategy_t {
+private:
+  dlong curDim;           // Current dimension of the initial guess space
+  dlong targetDim;        // Dimension at which the space is restarted
+  dlong maxDim;           // Maximum dimension of the initial guess space
+
+  size_t igfloatSize;     // Size of a basis entry
+
+  occa::memory o_btilde;  // New RHS vector (e.g., to be added to space)
+  occa::memory o_xtilde;  // Solution vector corresponding to o_btilde
+  occa::memory o_Btilde;  // RHS space (orthonormal)
+  occa::memory o_Xtilde;  // Solution space corresponding to RHS space
+
+  // temporary buffers for the fused inner products
+  dlong        ctmpNblocks;
+  occa::memory o_ctmp;
+
+  dfloat *alphas;         // Basis inner products, followed by b.b
+  dfloat *alphasThisRank;
+  occa::memory o_alphas;
+
+  // Iteration history used to pick targetDim
+  int    Nsolves;         // solves in the current restart cycle
+  int    NiterCycle;      // iterations in the current restart cycle
+  dfloat lastAvgIter;     // average iterations per solve of the last accepted cycle
+  int    growing;         // currently probing a larger space
+  int    Ncycles;         // restart cycles since targetDim was last changed
+
+  occa::kernel igFusedInnerProductsKernel;
+  occa::kernel igFusedBlockSumKernel;
+  occa::kernel igFusedUpdateKernel;
+  occa::kernel igFusedReconstructKernel;
+
+  void igFusedInnerProducts(occa::memory& o_b, const dlong dim);
+  void AdaptDimension();
+
+public:
+  igAdaptiveProjectionStrategy(dlong _N, platform_t& _platform, settings_t& _settings, MPI_Comm _comm);
+  ~igAdaptiveProjectionStrategy();
+
+  void FormInitialGuess(occa::memory& o_x, occa::memory& o_rhs);
+  void Update(solver_t &solver, occa::memory& o_x, occa::memory& o_rhs);
+  void RecordIterations(const int Niter);
+};
+
 // Extrapolation initial guess strategy.
 class igExtrapStrategy : public initialGuessStrategy_t {
 private:
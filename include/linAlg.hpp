@@ -122,6 +122,11 @@ public:
   dfloat innerProd(const dlong N, occa::memory& o_x, occa::memory& o_y,
                     MPI_Comm comm);
 
+  // o_x.o_y of each of Nsets interleaved sets, entry n is in set (n/stride)%Nsets
+  void innerProdMulti(const dlong N, const int Nsets, const dlong stride,
+                      occa::memory& o_x, occa::memory& o_y,
+                      MPI_Comm comm, dfloat *dots);
+
   // ||o_a||_w2
   dfloat weightedNorm2(const dlong N, occa::memory& o_w, occa::memory& o_a,
                        MPI_Comm comm);
@@ -147,6 +152,7 @@ public:
   occa::kernel norm2Kernel;
   occa::kernel weightedNorm2Kernel;
   occa::kernel innerProdKernel;
+  occa::kernel innerProdMultiKernel;
   occa::kernel weightedInnerProdKernel;
 };
 
@@ -189,4 +189,109 @@ public:
             const dfloat tol, const int MAXIT, const int verbose);
 };
 
+//virtual base block linear solver class. Solves A*X = B for Nrhs
+// right-hand sides at once. Block vectors are stored one column after
+// another, each column holding N+Nhalo entries.
+class blockLinearSolver_t {
+public:
+  platform_t& platform;
+  settings_t& settings;
+  MPI_Comm comm;
+
+  dlong N;
+  dlong Nhalo;
+  int maxNrhs;
+
+  blockLinearSolver_t(dlong _N, dlong _Nhalo, int _maxNrhs,
+                      platform_t& _platform, settings_t& _settings, MPI_Comm _comm);
+
+  static blockLinearSolver_t* Setup(dlong _N, dlong _Nhalo, int _maxNrhs,
+                                    platform_t& platform, settings_t& settings, MPI_Comm _comm);
+
+  virtual int Solve(solver_t& solver, precon_t& precon, const int Nrhs,
+                    occa::memory& o_x, occa::memory& o_rhs,
+                    const dfloat tol, const int MAXIT, const int verbose)=0;
+
+  virtual ~blockLinearSolver_t();
+
+protected:
+  dfloat* tmpdots;
+  occa::memory h_tmpdots;
+  occa::memory o_tmpdots;
+
+  occa::memory o_C;
+  occa::memory o_swap;
+
+  occa::kernel blockInnerProdsKernel;
+  occa::kernel blockUpdateKernel;
+
+  //G = X^T*Y, for the first Nx columns of X and Ny columns of Y.
+  // G is Nx x Ny and column major. One global reduction.
+  void BlockInnerProds(const int Nx, occa::memory& o_X,
+                       const int Ny, occa::memory& o_Y, dfloat *G);
+
+  //Y = beta*Y + alpha*X*C, for Nx columns of X and Ny columns of Y.
+  // C is Nx x Ny and column major.
+  void BlockUpdate(const int Nx, const dfloat alpha, occa::memory& o_X,
+                   const dfloat *C,
+                   const int Ny, const dfloat beta, occa::memory& o_Y);
+
+  //small dense Cholesky factorization and solve, column major. A column
+  // whose pivot is below tol times its diagonal entry is (numerically)
+  // dependent on the columns before it, and is returned in dependent
+  static int Cholesky(const int n, dfloat *A, const dfloat tol=0.0, int *dependent=nullptr);
+  static void CholeskySolve(const int n, const dfloat *L, const int m, dfloat *B);
+
+  //swap columns i and j of the block vector o_X
+  void SwapColumns(occa::memory& o_X, const int i, const int j);
+
+  //column n of the block vector o_X
+  occa::memory Column(occa::memory& o_X, const int n) {
+    return o_X + n*(N+Nhalo)*sizeof(dfloat);
+  }
+};
+
+//Block Preconditioned Conjugate Gradient
+class bpcg: public blockLinearSolver_t {
+private:
+  occa::memory o_p, o_z, o_Ap, o_Ax;
+
+  dfloat *PAP, *PAP0, *alpha, *beta, *rdotr;
+
+  int FactorSearchDirections(int Np);
+
+public:
+  bpcg(dlong _N, dlong _Nhalo, int _maxNrhs,
+       platform_t& _platform, settings_t& _settings, MPI_Comm _comm);
+  ~bpcg();
+
+  int Solve(solver_t& solver, precon_t& precon, const int Nrhs,
+            occa::memory& o_x, occa::memory& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
+//Block Preconditioned GMRES
+class bpgmres: public blockLinearSolver_t {
+private:
+  occa::memory *o_V=nullptr;
+  occa::memory o_Ax, o_z, o_r;
+
+  int restart;
+
+  dfloat *H=nullptr, *S=nullptr, *G=nullptr, *Y=nullptr;
+  dfloat *sn=nullptr, *cs=nullptr;
+
+  int CholeskyQR(const int Nrhs, occa::memory& o_W, occa::memory& o_Q, dfloat *R);
+  void UpdateBlockGMRES(const int Nrhs, occa::memory& o_x, const int I);
+
+public:
+  bpgmres(dlong _N, dlong _Nhalo, int _maxNrhs,
+          platform_t& _platform, settings_t& _settings, MPI_Comm _comm);
+  ~bpgmres();
+
+  int Solve(solver_t& solver, precon_t& precon, const int Nrhs,
+            occa::memory& o_x, occa::memory& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
 #endif
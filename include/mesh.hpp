@@ -36,6 +36,8 @@ SOFTWARE.
 #define TETRAHEDRA 6
 #define HEXAHEDRA 12
 
+class meshHierarchy_t;
+
 class meshSettings_t: public settings_t {
 public:
   meshSettings_t(MPI_Comm& _comm);
@@ -86,6 +88,9 @@ public:
   dlong NhaloElements=0;     // number of elements that cannot update without halo exchange
   dlong  totalHaloPairs=0;   // number of elements to be received in halo exchange
   dlong  totalRingElements=0;// number of elements to be received in ring halo exchange
+  // Solvers launch the surface kernels on the internal elements while the
+  // trace halo exchange is in flight, and on the halo elements after it
+  // completes, so the exchange overlaps device work.
   dlong *internalElementIds;  // list of elements that can update without halo exchange
   dlong *haloElementIds;      // list of elements to be sent in halo exchange
   occa::memory o_internalElementIds;  // list of elements that can update without halo exchange
@@ -182,6 +187,10 @@ public:
   dlong *nonPmlElements;
   dlong *pmlIds;
 
+  // pml lists are ordered with elements that can update without halo exchange first
+  dlong NnonPmlInternalElements=0;
+  dlong NpmlInternalElements=0;
+
   //multirate lists
   int mrNlevels=0;
   int *mrLevel;
@@ -222,9 +231,17 @@ public:
   // volume, surface, and second order geometric factors
   occa::memory o_vgeo, o_sgeo, o_ggeo;
 
+  // affine factors do not depend on the degree, so levels of a mesh
+  // hierarchy share them with the mesh they were made from
+  bool sharedGeometricFactors=false;
+
   //face node mappings
   occa::memory o_vmapM, o_vmapP, o_mapP;
 
+  //trace connectivity used by face kernels (see include/mesh/meshTrace.h)
+  bool compactTrace=false;
+  occa::memory o_traceM, o_traceP;
+
   //element boundary mappings
   occa::memory o_EToB;
 
@@ -250,6 +267,11 @@ public:
   occa::memory o_nonPmlElements;
   occa::memory o_pmlIds;
 
+  // halo portions of the pml lists
+  occa::memory o_pmlHaloElements;
+  occa::memory o_nonPmlHaloElements;
+  occa::memory o_pmlHaloIds;
+
   //multirate lists
   occa::memory o_mrLevel;
   occa::memory o_mrNelements, o_mrInterfaceNelements;
@@ -283,6 +305,14 @@ public:
   // repartition elements in parallel
   virtual void GeometricPartition() = 0;
 
+  // repartition elements with a multilevel graph partitioner
+  void GraphPartition(dfloat *weights=NULL, int Ncon=1);
+  void GraphPartitionParts(dfloat *weights, int Ncon, int *part);
+  dfloat* PartitionWeights();
+
+  // renumber local elements along a Hilbert curve or by reverse Cuthill-McKee
+  void ReorderElements();
+
   /* build parallel face connectivity */
   void ParallelConnect();
   void Connect();
@@ -315,21 +345,46 @@ public:
   /* build global connectivity in parallel */
   void ParallelConnectNodes();
 
+  /* build global connectivity from the edge/face numbering of a hierarchy */
+  void ParallelConnectNodes(meshHierarchy_t& meshHierarchy);
+
   /* build global gather scatter ops */
   void ParallelGatherScatterSetup();
 
+  // persist partitioned connectivity and node numbering across runs
+  string setupCacheDir;
+  string SetupCacheFile(const string stage);
+  bool LoadConnectivityCache();
+  void SaveConnectivityCache();
+  bool LoadNodeCache();
+  void SaveNodeCache();
+
   //Setup PML elements
   void PmlSetup();
   void MultiRatePmlSetup();
 
   //Multirate partitioning
   void MultiRateSetup(dfloat *EToDT);
+  void MultiRateLevels(dfloat *EToDT);
+
+  //repartition to balance each multirate level across ranks
+  void MultiRatePartition(dfloat* &EToDT);
+  void FreePartitionData();
 
   // Multirate trace halo
   halo_t** MultiRateHaloTraceSetup(int Nfields);
 
   virtual void OccaSetup();
 
+  // build o_traceM/o_traceP for face kernels
+  void TraceSetup();
+
+  // device storage of geometric factors (see GEOMETRIC FACTOR PRECISION)
+  bool FloatGeometricFactors();
+  occa::memory MallocGeometricFactors(size_t Nentries, const dfloat *geo);
+  void GeometricFactorAx(const dfloat *G, const dfloat *q, dfloat *Aq);
+  void GeometricFactorAccuracyCheck();
+
   virtual void CubatureSetup()=0;
 
   virtual void CubatureNodes()=0;
@@ -341,6 +396,16 @@ public:
 
   dfloat MinCharacteristicLength();
 
+  // free host copies of device-resident data after setup, and download
+  // them again on demand (e.g. for plotting)
+  bool hostMirrorsReleased=false;
+  dfloat cachedHmin=0.0;
+  void ReleaseHostMirrors();
+  void RestoreHostMirrors();
+
+  // register this mesh's host and device footprint with the platform
+  void RegisterMemory();
+
   virtual void PlotInterp(const dfloat* q, dfloat* Iq, dfloat* scratch=nullptr)=0;
 
   void RecursiveSpectralBisectionPartition();
@@ -351,6 +416,9 @@ public:
   //create a new mesh object with the same geometry, but different degree
   mesh_t& SetupNewDegree(int Nf);
 
+  // degree levels made from this mesh (see include/mesh/meshHierarchy.hpp)
+  meshHierarchy_t *hierarchy=nullptr;
+
   mesh_t* SetupRingPatch();
 
   mesh_t* SetupSEMFEM(hlong **globalIds, int *Nfp, int **faceNodes);
@@ -364,6 +432,10 @@ public:
 
 public:
   //1D
+  // index along a Hilbert space-filling curve
+  static unsigned long long int HilbertIndex(int _dim, int bits,
+                                             unsigned int x, unsigned int y, unsigned int z=0);
+
   static void Nodes1D(int N, dfloat *r);
   static void EquispacedNodes1D(int _N, dfloat *_r);
   static void OrthonormalBasis1D(dfloat a, int i, dfloat *P);
@@ -0,0 +1,63 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MESHHIERARCHY_HPP
+#define MESHHIERARCHY_HPP 1
+
+#include <map>
+
+// Degree levels of a mesh (e.g. for p-multigrid). Levels share the element
+// connectivity and halo of the mesh they are made from, and a global
+// numbering of its edges and faces. The node numbering of every level is
+// derived locally from the vertex, edge, and face ids.
+class meshHierarchy_t {
+public:
+  mesh_t& mesh; // mesh the hierarchy is built from
+
+  // edges and faces of the reference element, as sorted local vertex
+  // indices padded with -1
+  int Nentities=0;
+  int *entityVerts=nullptr;
+
+  // global edge/face ids of each element
+  hlong NentitiesGlobal=0;
+  hlong *entityIds=nullptr;
+
+  // mesh of each degree built so far
+  std::map<int, mesh_t*> levels;
+
+  meshHierarchy_t(mesh_t& _mesh);
+  ~meshHierarchy_t();
+
+  // mesh of degree N, built on first request
+  mesh_t& Level(int N);
+
+private:
+  void LocalEntities();
+  void ConnectEntities();
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef MESH_TRACE_H
+#define MESH_TRACE_H 1
+
+/* Trace connectivity for face kernels.
+
+   In nodal mode traceM/traceP are vmapM/vmapP. In compact mode
+   (quads and hexes) traceM holds the Nfaces*Nfp face nodes of the
+   reference element and traceP holds one code per element face,
+   (eP*p_Nfaces + fP)*8 + orientation, where the orientation bits are
+   applied to the (a,b) position of a node on the tensor product face:
+     bit 0 swaps a and b, bit 1 reverses a, bit 2 reverses b
+*/
+
+#if p_compactTrace
+int meshTracePermute(const int n, const int code){
+  int a = n%p_Nq;
+  int b = n/p_Nq;
+  if(code&1){ const int t = a; a = b; b = t; }
+  if(code&2) a = p_Nq-1-a;
+  if(code&4) b = p_Nq-1-b;
+  return b*p_Nq + a;
+}
+#endif
+
+// volume node ids of the interior and exterior traces of face node sk of element e
+void meshTraceIds(const dlong e,
+                  const dlong sk,
+                  const dlong *traceM,
+                  const dlong *traceP,
+                  dlong *idM,
+                  dlong *idP){
+#if p_compactTrace
+  const int nf   = sk%p_NfacesNfp;
+  const int face = nf/p_Nfp;
+  const dlong code = traceP[e*p_Nfaces + face];
+  const dlong eP = (code/8)/p_Nfaces;
+  const int   fP = (code/8)%p_Nfaces;
+
+  *idM = e*p_Np  + traceM[nf];
+  *idP = eP*p_Np + traceM[fP*p_Nfp + meshTracePermute(nf%p_Nfp, code%8)];
+#else
+  *idM = traceM[sk];
+  *idP = traceP[sk];
+#endif
+}
+
+#endif
@@ -88,6 +88,26 @@ public:
   virtual void coarsen(occa::memory& o_x, occa::memory& o_Cx)=0;
   virtual void prolongate(occa::memory& o_x, occa::memory& o_Px)=0;
   virtual void Report()=0;
+
+  //smooth and form the residual of Nrhs vectors stored stride entries
+  // apart. Levels without blocked versions apply them one vector at a time
+  virtual void smoothBlock(const int Nrhs, const dlong stride,
+                           occa::memory& o_rhs, occa::memory& o_x, bool x_is_zero) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_rhsn = o_rhs + n*stride*sizeof(dfloat);
+      occa::memory o_xn   = o_x   + n*stride*sizeof(dfloat);
+      smooth(o_rhsn, o_xn, x_is_zero);
+    }
+  }
+  virtual void residualBlock(const int Nrhs, const dlong stride,
+                             occa::memory& o_rhs, occa::memory& o_x, occa::memory& o_res) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_rhsn = o_rhs + n*stride*sizeof(dfloat);
+      occa::memory o_xn   = o_x   + n*stride*sizeof(dfloat);
+      occa::memory o_resn = o_res + n*stride*sizeof(dfloat);
+      residual(o_rhsn, o_xn, o_resn);
+    }
+  }
 };
 
 //forward declaration
@@ -111,6 +131,9 @@ public:
 
   void Operator(occa::memory& o_rhs, occa::memory& o_x);
 
+  void BlockOperator(const int Nrhs, const dlong stride,
+                     occa::memory& o_rhs, occa::memory& o_x);
+
   void Report();
 
   dlong getNumCols(int k);
@@ -76,6 +76,15 @@ public:
 
   KrylovType ktype;
 
+  //coarse rhs, x, and residual of the blocked V-cycle
+  int NblockRhs=0;
+  dlong blockStride=0;
+  occa::memory o_rhsBlock[PARALMOND_MAX_LEVELS];
+  occa::memory o_xBlock[PARALMOND_MAX_LEVELS];
+  occa::memory o_resBlock;
+
+  void BlockSetup(const int Nrhs, const dlong stride);
+
   occa::memory o_ck[PARALMOND_MAX_LEVELS];
   occa::memory o_vk[PARALMOND_MAX_LEVELS];
   occa::memory o_wk[PARALMOND_MAX_LEVELS];
@@ -93,9 +102,16 @@ public:
 
   void Operator(occa::memory& o_RHS, occa::memory& o_X);
 
+  void BlockOperator(const int Nrhs, const dlong stride,
+                     occa::memory& o_RHS, occa::memory& o_X);
+
   void vcycle(const int k, occa::memory& o_RHS, occa::memory& o_X);
   void kcycle(const int k, occa::memory& o_RHS, occa::memory& o_X);
 
+  //V-cycle on Nrhs vectors at once
+  void blockVcycle(const int k, const int Nrhs, const dlong stride,
+                   occa::memory& o_RHS, occa::memory& o_X);
+
 private:
   void kcycleOp1(multigridLevel* level,
                  occa::memory& o_X,  occa::memory& o_RHS,
@@ -0,0 +1,159 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef PARALLELSORT_HPP
+#define PARALLELSORT_HPP
+
+#include <mpi.h>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include "utils.hpp"
+
+// distributed sample sort of N entries of v by key(v[n]).
+//  Entries may be unevenly distributed across ranks. On return v is
+//  reallocated to hold this rank's contiguous slice of the globally
+//  sorted sequence and N is updated. Entries with equal keys end up on
+//  the same rank. type is the MPI datatype describing one entry. The key
+//  type must support operator< and be trivially copyable.
+template<typename T, typename KeyFunction>
+void parallelSort(MPI_Comm comm, dlong &N, T* &v, MPI_Datatype type,
+                  KeyFunction key){
+
+  typedef typename std::decay<decltype(key(*v))>::type K;
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  // sort keys locally, moving only an index to the payload
+  std::vector<std::pair<K,dlong> > keys(N);
+  for(dlong n=0;n<N;++n)
+    keys[n] = std::make_pair(key(v[n]), n);
+
+  std::sort(keys.begin(), keys.end(),
+            [](const std::pair<K,dlong>& a, const std::pair<K,dlong>& b) {
+              if(a.first < b.first) return true;
+              if(b.first < a.first) return false;
+              return a.second < b.second;
+            });
+
+  // take up to size regularly spaced samples from each rank
+  int Nsamples = (int) mymin((dlong) size, N);
+  std::vector<K> samples(Nsamples);
+  for(int i=0;i<Nsamples;++i)
+    samples[i] = keys[((2*(dlong)i+1)*N)/(2*Nsamples)].first;
+
+  int *sampleCounts = (int*) calloc(size, sizeof(int));
+  int *sampleOffsets = (int*) calloc(size+1, sizeof(int));
+
+  int sampleBytes = Nsamples*sizeof(K);
+  MPI_Allgather(&sampleBytes, 1, MPI_INT, sampleCounts, 1, MPI_INT, comm);
+
+  for(int rr=0;rr<size;++rr)
+    sampleOffsets[rr+1] = sampleOffsets[rr] + sampleCounts[rr];
+
+  int NallSamples = sampleOffsets[size]/sizeof(K);
+  std::vector<K> allSamples(NallSamples);
+
+  MPI_Allgatherv(samples.data(), sampleBytes, MPI_BYTE,
+                 allSamples.data(), sampleCounts, sampleOffsets, MPI_BYTE,
+                 comm);
+
+  free(sampleCounts);
+  free(sampleOffsets);
+
+  // nothing to sort anywhere
+  if(NallSamples==0) return;
+
+  // pick size-1 splitters from the global sample
+  std::sort(allSamples.begin(), allSamples.end(),
+            [](const K& a, const K& b) { return a < b; });
+
+  std::vector<K> splitters(size-1);
+  for(int rr=0;rr<size-1;++rr)
+    splitters[rr] = allSamples[((dlong)(rr+1)*NallSamples)/size];
+
+  int *Nsend = (int*) calloc(size, sizeof(int));
+  int *Nrecv = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size, sizeof(int));
+  int *recvOffsets = (int*) calloc(size+1, sizeof(int));
+
+  // locally sorted keys give monotone destinations
+  int rr = 0;
+  for(dlong n=0;n<N;++n){
+    while(rr<size-1 && !(keys[n].first < splitters[rr])) ++rr;
+    ++Nsend[rr];
+  }
+
+  // find send offsets
+  for(int r=1;r<size;++r)
+    sendOffsets[r] = sendOffsets[r-1] + Nsend[r-1];
+
+  // pack payload in sorted order
+  T *sendv = (T*) calloc(N, sizeof(T));
+  for(dlong n=0;n<N;++n)
+    sendv[n] = v[keys[n].second];
+
+  // exchange counts
+  MPI_Alltoall(Nsend, 1, MPI_INT,
+               Nrecv, 1, MPI_INT,
+               comm);
+
+  for(int r=0;r<size;++r)
+    recvOffsets[r+1] = recvOffsets[r] + Nrecv[r];
+
+  dlong Nnew = recvOffsets[size];
+  T *recvv = (T*) calloc(Nnew, sizeof(T));
+
+  MPI_Alltoallv(sendv, Nsend, sendOffsets, type,
+                recvv, Nrecv, recvOffsets, type,
+                comm);
+
+  // merge the size sorted runs received from each rank
+  for(int width=1;width<size;width*=2){
+    for(int r=0;r+width<size;r+=2*width){
+      int rEnd = mymin(r+2*width, size);
+      std::inplace_merge(recvv+recvOffsets[r],
+                         recvv+recvOffsets[r+width],
+                         recvv+recvOffsets[rEnd],
+                         [&](const T& a, const T& b) { return key(a) < key(b); });
+    }
+  }
+
+  free(sendv);
+  free(Nsend);
+  free(Nrecv);
+  free(sendOffsets);
+  free(recvOffsets);
+
+  // replace entries with the sorted slice
+  free(v);
+  v = recvv;
+  N = Nnew;
+}
+
+#endif
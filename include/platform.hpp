@@ -88,23 +88,48 @@ public:
   occa::kernel buildKernel(std::string fileName, std::string kernelName,
                            occa::properties& kernelInfo);
 
+  //true if adaptive time steppers should keep their step controller on the device
+  bool deviceStepController() {
+    return settings.compareSetting("DEVICE STEP CONTROLLER", "TRUE");
+  }
+
   occa::memory malloc(const size_t bytes,
                       const void *src = NULL,
                       const occa::properties &prop = occa::properties()) {
-    return device.malloc(bytes, src, prop);
+    occa::memory o_mem = device.malloc(bytes, src, prop);
+    TrackMemory();
+    return o_mem;
   }
 
   occa::memory malloc(const size_t bytes,
                       const occa::memory &src,
                       const occa::properties &prop = occa::properties()) {
-    return device.malloc(bytes, src, prop);
+    occa::memory o_mem = device.malloc(bytes, src, prop);
+    TrackMemory();
+    return o_mem;
   }
 
   occa::memory malloc(const size_t bytes,
                       const occa::properties &prop) {
-    return device.malloc(bytes, prop);
+    occa::memory o_mem = device.malloc(bytes, prop);
+    TrackMemory();
+    return o_mem;
+  }
+
+  //transient device buffers. reserve returns a buffer of at least bytes,
+  // reusing a released one of the same power-of-two size class if possible
+  occa::memory reserve(const size_t bytes);
+  void release(occa::memory &o_mem);
+
+  //record the host and device bytes currently held by a subsystem
+  void RegisterMemory(const std::string tag, const size_t hostBytes,
+                      const size_t deviceBytes) {
+    memoryRegistry[tag] = std::make_pair(hostBytes, deviceBytes);
   }
 
+  //print the current and peak device memory footprint across ranks
+  void MemoryReport();
+
   void *hostMalloc(const size_t bytes,
                    const void *src,
                    occa::memory &h_mem){
@@ -115,6 +140,18 @@ public:
   }
 
 private:
+  //released transient buffers, keyed by size class
+  std::map<size_t, std::vector<occa::memory> > freeBuffers;
+  size_t pooledBytes=0;
+  size_t peakBytes=0;
+
+  //host and device bytes registered per subsystem
+  std::map<std::string, std::pair<size_t,size_t> > memoryRegistry;
+
+  void TrackMemory() {
+    peakBytes = std::max(peakBytes, (size_t) device.memoryAllocated());
+  }
+
   void DeviceConfig();
   void DeviceProperties();
 
@@ -36,6 +36,16 @@ public:
 
   virtual void Operator(occa::memory &o_r, occa::memory &o_Mr)=0;
 
+  //apply the preconditioner to Nrhs vectors stored stride entries apart
+  virtual void BlockOperator(const int Nrhs, const dlong stride,
+                             occa::memory &o_r, occa::memory &o_Mr) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_rn  = o_r  + n*stride*sizeof(dfloat);
+      occa::memory o_Mrn = o_Mr + n*stride*sizeof(dfloat);
+      Operator(o_rn, o_Mrn);
+    }
+  }
+
   virtual ~precon_t() {}
 };
 
@@ -50,6 +60,11 @@ public:
   void Operator(occa::memory &o_r, occa::memory &o_Mr){
     o_Mr.copyFrom(o_r, N*sizeof(dfloat)); //identity
   }
+
+  void BlockOperator(const int Nrhs, const dlong stride,
+                     occa::memory &o_r, occa::memory &o_Mr){
+    o_Mr.copyFrom(o_r, ((Nrhs-1)*stride+N)*sizeof(dfloat)); //identity
+  }
 };
 
 #endif
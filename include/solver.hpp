@@ -100,6 +100,17 @@ public:
   virtual void Operator(occa::memory& o_q, occa::memory& o_Aq) {
     LIBP_ABORT(string("Operator not implemented in this solver"))
   }
+
+  //Evaluation of the operator on Nrhs vectors stored stride entries apart.
+  // Solvers without a blocked operator apply A one column at a time.
+  virtual void BlockOperator(const int Nrhs, const dlong stride,
+                             occa::memory& o_q, occa::memory& o_Aq) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_qn  = o_q  + n*stride*sizeof(dfloat);
+      occa::memory o_Aqn = o_Aq + n*stride*sizeof(dfloat);
+      Operator(o_qn, o_Aqn);
+    }
+  }
 };
 
 #endif
\ No newline at end of file
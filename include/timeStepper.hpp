@@ -44,19 +44,30 @@ public:
 
   dfloat dt;
 
+  //report the solution during Run. Cleared when used as a propagator
+  int output;
+
   timeStepper_t(dlong Nelements, dlong NhaloElements,
                  int Np, int Nfields, solver_t& _solver):
     N(Nelements*Np*Nfields),
     Nhalo(NhaloElements*Np*Nfields),
-    solver(_solver) {}
+    solver(_solver),
+    output(1) {}
 
   virtual ~timeStepper_t() {};
   virtual void Run(occa::memory& o_q, dfloat start, dfloat end)=0;
 
   void SetTimeStep(dfloat dt_) {dt = dt_;};
   dfloat GetTimeStep() {return dt;};
+
+  void SetOutput(int output_) {output = output_;};
+  void Report(dfloat time, int tstep) {if (output) solver.Report(time, tstep);};
 };
 
+// phi-functions of a real diagonal stiff term z = lambda*dt, phi_0(z),...,phi_kmax(z).
+//  Used to build the semi-analytic integrators' coefficients
+void phiFunctions(const dfloat z, const int kmax, dfloat *phi);
+
 /* Adams Bashforth, order 3 */
 class ab3: public timeStepper_t {
 protected:
@@ -101,31 +112,19 @@ public:
   void Run(occa::memory& o_q, dfloat start, dfloat end);
 };
 
-/* Dormand-Prince method */
-/* Explict Runge-Kutta, order 5 with embedded order 4 and adaptive time-stepping */
-class dopri5: public timeStepper_t {
+/* Base of the embedded Runge-Kutta methods with adaptive time-stepping */
+class adaptiveRk_t: public timeStepper_t {
 protected:
   MPI_Comm comm;
-  int Nrk;
 
   dlong Nblock;
 
-  dfloat *rkC, *rkA, *rkE;
-  occa::memory o_rkA, o_rkE;
-
   dfloat *errtmp;
   occa::memory o_errtmp, h_errtmp;
 
-  occa::memory o_rhsq;
   occa::memory o_rkq;
-  occa::memory o_rkrhsq;
   occa::memory o_rkerr;
 
-  occa::memory o_saveq;
-
-
-  occa::kernel rkUpdateKernel;
-  occa::kernel rkStageKernel;
   occa::kernel rkErrorEstimateKernel;
 
   dfloat dtMIN; //minumum allowed timestep
@@ -144,14 +143,64 @@ protected:
   dfloat facold;
   dfloat sqrtinvNtotal;
 
+  //device-side step controller
+  int speculate;
+  dfloat dtnext;
+  dfloat *errnorm;
+  occa::memory o_errnorm, h_errnorm;
+  occa::streamTag errTag;
+  dfloat localerr, globalerr;
+  MPI_Request errRequest;
+
+  occa::kernel errorReduceKernel;
+
+  virtual void Backup(occa::memory &o_Q)=0;
+  virtual void Restore(occa::memory &o_Q)=0;
+  virtual void AcceptStep(occa::memory &o_q, occa::memory &o_rq)=0;
+
+  virtual void Step(occa::memory& o_q, dfloat time, dfloat dt)=0;
+
+  //rebuild the coefficients which depend on dt
+  virtual void UpdateCoefficients() {};
+
+  dfloat Estimater(occa::memory& o_q);
+
+  void ErrorEstimateStart(occa::memory& o_q);
+  void ErrorEstimateReduce();
+  dfloat ErrorEstimateFinish();
+
+  void RunSpeculative(occa::memory& o_q, dfloat start, dfloat end);
+
+public:
+  adaptiveRk_t(dlong Nelements, dlong NhaloElements,
+               int Np, int Nfields, solver_t& solver, MPI_Comm _comm);
+  virtual ~adaptiveRk_t();
+};
+
+/* Dormand-Prince method */
+/* Explict Runge-Kutta, order 5 with embedded order 4 and adaptive time-stepping */
+class dopri5: public adaptiveRk_t {
+protected:
+  int Nrk;
+
+  dfloat *rkC, *rkA, *rkE;
+  occa::memory o_rkA, o_rkE;
+
+  occa::memory o_rhsq;
+  occa::memory o_rkrhsq;
+
+  occa::memory o_saveq;
+
+
+  occa::kernel rkUpdateKernel;
+  occa::kernel rkStageKernel;
+
   virtual void Backup(occa::memory &o_Q);
   virtual void Restore(occa::memory &o_Q);
   virtual void AcceptStep(occa::memory &o_q, occa::memory &o_rq);
 
   virtual void Step(occa::memory& o_q, dfloat time, dfloat dt);
 
-  virtual dfloat Estimater(occa::memory& o_q);
-
 public:
   dopri5(dlong Nelements, dlong NhaloElements,
          int Np, int Nfields, solver_t& solver, MPI_Comm _comm);
@@ -169,7 +218,10 @@ protected:
   int Np, Nfields;
   dlong Nblock, Nelements, NhaloElements;
 
+  //elements are grouped by their diagonal stiff terms, lambda[g*Nfields+f]
   dfloat *lambda;
+  int Ngroups;
+  occa::memory o_group;
 
   dfloat *saab_x, *saab_a;
   occa::memory o_saab_x, o_saab_a;
@@ -189,55 +241,36 @@ public:
         solver_t& _solver);
   ~saab3();
 
+  void SetLambdaGroups(int _Ngroups, dfloat *_lambda, dlong *elementGroup);
+
   void Run(occa::memory& o_q, dfloat start, dfloat end);
 };
 
 /* Semi-Analytic Explict Runge-Kutta, order 4 with embedded order 3 and adaptive time-stepping */
-class sark4: public timeStepper_t {
+class sark4: public adaptiveRk_t {
 protected:
-  MPI_Comm comm;
   int Nrk;
   int order, embeddedOrder;
 
   int Np, Nfields;
-  dlong Nblock, Nelements, NhaloElements;
+  dlong Nelements, NhaloElements;
 
+  //elements are grouped by their diagonal stiff terms, lambda[g*Nfields+f]
   dfloat *lambda;
+  int Ngroups;
+  occa::memory o_group;
 
   dfloat *rkC, *rkX, *rkA, *rkE;
   occa::memory h_rkX, h_rkA, h_rkE;
   occa::memory o_rkX, o_rkA, o_rkE;
 
-  dfloat *errtmp;
-
   occa::memory o_rhsq;
-  occa::memory o_rkq;
   occa::memory o_rkrhsq;
-  occa::memory o_rkerr;
 
   occa::memory o_saveq;
 
-  occa::memory o_errtmp;
-
   occa::kernel rkUpdateKernel;
   occa::kernel rkStageKernel;
-  occa::kernel rkErrorEstimateKernel;
-
-  dfloat dtMIN; //minumum allowed timestep
-  dfloat ATOL;  //absolute error tolerance
-  dfloat RTOL;  //relative error tolerance
-  dfloat safe;   //safety factor
-
-  //error control parameters
-  dfloat beta;
-  dfloat factor1;
-  dfloat factor2;
-
-  dfloat exp1;
-  dfloat invfactor1;
-  dfloat invfactor2;
-  dfloat facold;
-  dfloat sqrtinvNtotal;
 
   virtual void Backup(occa::memory &o_Q);
   virtual void Restore(occa::memory &o_Q);
@@ -245,8 +278,6 @@ protected:
 
   virtual void Step(occa::memory& o_q, dfloat time, dfloat dt);
 
-  dfloat Estimater(occa::memory& o_q);
-
   void UpdateCoefficients();
 
 public:
@@ -256,55 +287,36 @@ public:
         solver_t& _solver, MPI_Comm _comm);
   ~sark4();
 
+  void SetLambdaGroups(int _Ngroups, dfloat *_lambda, dlong *elementGroup);
+
   void Run(occa::memory& o_q, dfloat start, dfloat end);
 };
 
 /* Semi-Analytic Explict Runge-Kutta, order 5 with embedded order 4 and adaptive time-stepping */
-class sark5: public timeStepper_t {
+class sark5: public adaptiveRk_t {
 protected:
-  MPI_Comm comm;
   int Nrk;
   int order, embeddedOrder;
 
   int Np, Nfields;
-  dlong Nblock, Nelements, NhaloElements;
+  dlong Nelements, NhaloElements;
 
+  //elements are grouped by their diagonal stiff terms, lambda[g*Nfields+f]
   dfloat *lambda;
+  int Ngroups;
+  occa::memory o_group;
 
   dfloat *rkC, *rkX, *rkA, *rkE;
   occa::memory h_rkX, h_rkA, h_rkE;
   occa::memory o_rkX, o_rkA, o_rkE;
 
-  dfloat *errtmp;
-
   occa::memory o_rhsq;
-  occa::memory o_rkq;
   occa::memory o_rkrhsq;
-  occa::memory o_rkerr;
 
   occa::memory o_saveq;
 
-  occa::memory o_errtmp;
-
   occa::kernel rkUpdateKernel;
   occa::kernel rkStageKernel;
-  occa::kernel rkErrorEstimateKernel;
-
-  dfloat dtMIN; //minumum allowed timestep
-  dfloat ATOL;  //absolute error tolerance
-  dfloat RTOL;  //relative error tolerance
-  dfloat safe;   //safety factor
-
-  //error control parameters
-  dfloat beta;
-  dfloat factor1;
-  dfloat factor2;
-
-  dfloat exp1;
-  dfloat invfactor1;
-  dfloat invfactor2;
-  dfloat facold;
-  dfloat sqrtinvNtotal;
 
   virtual void Backup(occa::memory &o_Q);
   virtual void Restore(occa::memory &o_Q);
@@ -312,8 +324,6 @@ protected:
 
   virtual void Step(occa::memory& o_q, dfloat time, dfloat dt);
 
-  dfloat Estimater(occa::memory& o_q);
-
   void UpdateCoefficients();
 
 public:
@@ -323,6 +333,8 @@ public:
         solver_t& _solver, MPI_Comm _comm);
   ~sark5();
 
+  void SetLambdaGroups(int _Ngroups, dfloat *_lambda, dlong *elementGroup);
+
   void Run(occa::memory& o_q, dfloat start, dfloat end);
 };
 
@@ -382,6 +394,86 @@ public:
   void Run(occa::memory& o_q, dfloat start, dfloat end);
 };
 
+/* Additive (IMEX) Runge-Kutta, explicit first stage ESDIRK implicit part */
+/* with embedded error estimate and adaptive time-stepping */
+class ark: public timeStepper_t {
+protected:
+  MPI_Comm comm;
+  int Nrk;
+  int order, embeddedOrder;
+
+  dlong Nblock;
+
+  dfloat *rkC, *rkAE, *rkAI, *rkB, *rkE;
+  occa::memory o_rkAE, o_rkAI, o_rkB, o_rkE;
+
+  dfloat rkGamma; //diagonal of implicit tableau
+
+  dfloat *errtmp;
+  occa::memory o_errtmp, h_errtmp;
+
+  occa::memory o_rkq;    //stage solution
+  occa::memory o_rkrhs;  //explicit part of stage
+  occa::memory o_rhs;    //implicit solve rhs
+  occa::memory o_rkF;    //explicit stage evaluations
+  occa::memory o_rkG;    //implicit stage evaluations
+  occa::memory o_rkerr;
+
+  occa::memory o_saveq;
+
+  occa::kernel rkStageKernel;
+  occa::kernel rkImplicitUpdateKernel;
+  occa::kernel rkUpdateKernel;
+  occa::kernel rkErrorEstimateKernel;
+
+  dfloat dtMIN; //minumum allowed timestep
+  dfloat ATOL;  //absolute error tolerance
+  dfloat RTOL;  //relative error tolerance
+  dfloat safe;   //safety factor
+
+  //error control parameters
+  dfloat beta;
+  dfloat factor1;
+  dfloat factor2;
+
+  dfloat exp1;
+  dfloat invfactor1;
+  dfloat invfactor2;
+  dfloat facold;
+  dfloat sqrtinvNtotal;
+
+  void Step(occa::memory& o_q, dfloat time, dfloat dt);
+
+  dfloat Estimater(occa::memory& o_q);
+
+  ark(dlong Nelements, dlong NhaloElements,
+      int Np, int Nfields, solver_t& solver, MPI_Comm _comm,
+      int _Nrk, int _order, int _embeddedOrder,
+      const dfloat *_rkC, const dfloat *_rkAE, const dfloat *_rkAI,
+      const dfloat *_rkBhat);
+
+public:
+  ~ark();
+
+  dfloat getGamma();
+
+  void Run(occa::memory& o_q, dfloat start, dfloat end);
+};
+
+/* Kennedy-Carpenter ARK3(2)4L[2]SA */
+class ark3: public ark {
+public:
+  ark3(dlong Nelements, dlong NhaloElements,
+       int Np, int Nfields, solver_t& solver, MPI_Comm _comm);
+};
+
+/* Kennedy-Carpenter ARK4(3)6L[2]SA */
+class ark4: public ark {
+public:
+  ark4(dlong Nelements, dlong NhaloElements,
+       int Np, int Nfields, solver_t& solver, MPI_Comm _comm);
+};
+
 /* Multi-rate Adams-Bashforth, order 3 */
 class mrab3: public timeStepper_t {
 protected:
@@ -457,6 +549,74 @@ public:
 };
 
 
+/* Parallel-in-time driver, Parareal or two-level MGRIT with FCF-relaxation */
+// Each rank of the time communicator owns one slice of [start,end] and
+// corrects a coarse propagator with fine propagations of its slice.
+class parareal: public timeStepper_t {
+private:
+  MPI_Comm comm;     //space communicator
+  MPI_Comm timeComm;
+  int timeRank, Nslices;
+
+  timeStepper_t* coarse;
+  timeStepper_t* fine;
+
+  int fcf;          //add FCF-relaxation (MGRIT) to each iteration
+  int maxIterations;
+  dfloat tol;
+  dfloat coarseFactor; //coarse dt = coarseFactor*dt*coarseDtScale
+
+  //coarse propagator on a lower degree mesh, owned by the driver
+  solver_t* coarseSolver=nullptr;
+  settings_t* coarseSettings=nullptr;
+  dlong NtransferElements=0;
+  dfloat coarseDtScale=1.0; //stable step of the coarse mesh over the fine one
+  occa::memory o_qc;        //coarse space state
+  occa::memory o_R, o_P;    //restriction and prolongation of one element
+  occa::kernel restrictKernel, prolongKernel;
+
+  //wall time spent in each propagator
+  double fineTime=0.0, coarseTime=0.0;
+  int Nfine=0, Ncoarse=0;
+
+  dfloat *sendq, *recvq;
+  occa::memory h_sendq, h_recvq;
+
+  occa::memory o_U;    //solution at the start of this slice
+  occa::memory o_Unext;//solution at the end of this slice
+  occa::memory o_F;    //fine propagation of o_U
+  occa::memory o_G;    //coarse propagation of o_U
+  occa::memory o_prop; //propagator workspace
+
+  void Propagate(timeStepper_t* stepper, occa::memory& o_q0,
+                 dfloat start, dfloat end);
+
+  void SendNext(occa::memory& o_q);
+  void RecvPrev(occa::memory& o_q);
+
+public:
+  //_comm is the space communicator SplitComm made from _globalComm
+  parareal(dlong Nelements, dlong NhaloElements,
+           int Np, int Nfields, solver_t& solver,
+           MPI_Comm _comm, MPI_Comm _globalComm,
+           timeStepper_t* _coarse, timeStepper_t* _fine);
+  ~parareal();
+
+  //run the coarse propagator on meshC, a lower degree copy of mesh. The
+  // driver takes ownership of the coarse solver and its settings
+  void SetCoarseSpace(mesh_t& mesh, mesh_t& meshC,
+                      solver_t* _coarseSolver, settings_t* _coarseSettings);
+
+  void Run(occa::memory& o_q, dfloat start, dfloat end);
+
+  //split comm into Nslices space communicators of contiguous ranks
+  static MPI_Comm SplitComm(MPI_Comm comm, int Nslices);
+
+  //settings shared by the solvers which offer a parallel-in-time driver
+  static void AddSettings(settings_t& settings);
+  static void ReportSettings(settings_t& settings);
+};
+
 /**************************************************/
 /* Derived Time Integrators which step PML fields */
 /**************************************************/
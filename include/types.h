@@ -37,8 +37,8 @@ SOFTWARE.
 #endif
 
 
-//float data type
-#if 0
+//float data type (build with LIBP_PRECISION=single for float)
+#ifdef LIBP_DFLOAT_FLOAT
 #define dfloat float
 #define ogs_dfloat ogs_float
 #define MPI_DFLOAT MPI_FLOAT
@@ -190,13 +190,13 @@ void matrixRightSolve(int NrowsA, int NcolsA, float *A, int NrowsB, int NcolsB,
 void matrixUnderdeterminedRightSolveMinNorm(int NrowsA, int NcolsA, dfloat *A, dfloat *b, dfloat *x)
 {
   int     LWORK, INFO = 0;
-  dfloat* WORK;
+  double* WORK;
 
-  dfloat* tmpA = new dfloat[NrowsA*NcolsA]();
+  double* tmpA = new double[NrowsA*NcolsA]();
   for (int i = 0; i < NrowsA*NcolsA; i++)
     tmpA[i] = A[i];
 
-  dfloat* tmpb = new dfloat[NrowsA]();
+  double* tmpb = new double[NrowsA]();
   for (int i = 0; i < NcolsA; i++)
     tmpb[i] = b[i];
 
@@ -205,7 +205,7 @@ void matrixUnderdeterminedRightSolveMinNorm(int NrowsA, int NcolsA, dfloat *A, d
   int  NRHS = 1;
 
   LWORK = 2*NrowsA*NcolsA;
-  WORK = new dfloat[LWORK]();
+  WORK = new double[LWORK]();
   dgels_(&TRANS, &NcolsA, &NrowsA, &NRHS, tmpA, &NcolsA, tmpb, &NrowsA, WORK, &LWORK, &INFO);
 
   if (INFO != 0) {
@@ -236,22 +236,22 @@ void matrixUnderdeterminedRightSolveMinNorm(int NrowsA, int NcolsA, dfloat *A, d
 void matrixUnderdeterminedRightSolveCPQR(int NrowsA, int NcolsA, dfloat *A, dfloat *b, dfloat *x)
 {
   int     LWORK, INFO = 0;
-  dfloat* WORK;
+  double* WORK;
 
-  dfloat* tmpA = new dfloat[NrowsA*NcolsA]();
+  double* tmpA = new double[NrowsA*NcolsA]();
   for (int i = 0; i < NrowsA*NcolsA; i++)
     tmpA[i] = A[i];
 
-  dfloat* tmpb = new dfloat[NrowsA]();
+  double* tmpb = new double[NrowsA]();
   for (int i = 0; i < NcolsA; i++)
     tmpb[i] = b[i];
 
   // Compute A^T * P = Q * R.
   int*    JPVT = new int[NrowsA]();
-  dfloat* TAU = new dfloat[mymin(NrowsA, NcolsA)]();
+  double* TAU = new double[mymin(NrowsA, NcolsA)]();
 
   LWORK = 3*NrowsA + 1;
-  WORK  = new dfloat[LWORK]();
+  WORK  = new double[LWORK]();
   dgeqp3_(&NcolsA, &NrowsA, tmpA, &NcolsA, JPVT, TAU, WORK, &LWORK, &INFO);
 
   if (INFO != 0) {
@@ -269,7 +269,7 @@ void matrixUnderdeterminedRightSolveCPQR(int NrowsA, int NcolsA, dfloat *A, dflo
   int  NREFLS = NcolsA;
 
   LWORK = 1;
-  WORK  = new dfloat[LWORK]();
+  WORK  = new double[LWORK]();
   dormqr_(&SIDE, &TRANS, &NcolsA, &NRHS, &NREFLS, tmpA, &NcolsA, TAU, tmpb, &NcolsA, WORK, &LWORK, &INFO);
 
   if (INFO != 0) {
@@ -286,7 +286,7 @@ void matrixUnderdeterminedRightSolveCPQR(int NrowsA, int NcolsA, dfloat *A, dflo
   char TRANSA = 'N';
   char DIAG = 'N';
   NRHS = 1;
-  dfloat ALPHA = 1.0;
+  double ALPHA = 1.0;
 
   dtrsm_(&SIDE, &UPLO, &TRANSA, &DIAG, &NcolsA, &NRHS, &ALPHA, tmpA, &NcolsA, tmpb, &NcolsA);
 
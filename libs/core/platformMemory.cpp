@@ -0,0 +1,103 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "platform.hpp"
+
+//smallest power of two no less than bytes
+static size_t sizeClass(const size_t bytes) {
+  size_t c = 256;
+  while (c<bytes) c <<= 1;
+  return c;
+}
+
+occa::memory platform_t::reserve(const size_t bytes) {
+
+  const size_t c = sizeClass(bytes);
+
+  auto search = freeBuffers.find(c);
+  if (search != freeBuffers.end() && search->second.size()) {
+    occa::memory o_mem = search->second.back();
+    search->second.pop_back();
+    pooledBytes -= c;
+    return o_mem;
+  }
+
+  return malloc(c);
+}
+
+void platform_t::release(occa::memory &o_mem) {
+
+  const size_t c = o_mem.size();
+
+  //buffers that do not match a size class are simply freed
+  if (c != sizeClass(c)) {
+    o_mem.free();
+    return;
+  }
+
+  freeBuffers[c].push_back(o_mem);
+  pooledBytes += c;
+  o_mem = occa::memory();
+}
+
+void platform_t::MemoryReport() {
+
+  if (!settings.compareSetting("MEMORY REPORT","TRUE")) return;
+
+  TrackMemory();
+
+  hlong localBytes[3] = {(hlong) device.memoryAllocated(),
+                         (hlong) peakBytes,
+                         (hlong) pooledBytes};
+  hlong minBytes[3], maxBytes[3], sumBytes[3];
+
+  MPI_Reduce(localBytes, minBytes, 3, MPI_HLONG, MPI_MIN, 0, comm);
+  MPI_Reduce(localBytes, maxBytes, 3, MPI_HLONG, MPI_MAX, 0, comm);
+  MPI_Reduce(localBytes, sumBytes, 3, MPI_HLONG, MPI_SUM, 0, comm);
+
+  if (rank==0) {
+    const double MB = 1024.*1024.;
+    const char *names[3] = {"current", "peak   ", "pooled "};
+    printf("Device memory (MB)     min        max        total\n");
+    for (int n=0;n<3;++n)
+      printf("  %s       %10.2f %10.2f %10.2f\n", names[n],
+             minBytes[n]/MB, maxBytes[n]/MB, sumBytes[n]/MB);
+  }
+
+  //registered subsystems. Every rank registers the same tags
+  if (rank==0 && memoryRegistry.size())
+    printf("Registered memory (MB, max per rank)   host     device\n");
+
+  for (auto it=memoryRegistry.begin(); it!=memoryRegistry.end(); ++it) {
+    hlong bytes[2] = {(hlong) it->second.first, (hlong) it->second.second};
+    hlong maxTagBytes[2];
+    MPI_Reduce(bytes, maxTagBytes, 2, MPI_HLONG, MPI_MAX, 0, comm);
+
+    if (rank==0)
+      printf("  %-30s %10.2f %10.2f\n", it->first.c_str(),
+             maxTagBytes[0]/(1024.*1024.), maxTagBytes[1]/(1024.*1024.));
+  }
+}
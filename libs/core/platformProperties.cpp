@@ -51,6 +51,16 @@ void platform_t::DeviceProperties(){
     props["defines/" "dfloat8"]="double8";
   }
 
+  //accumulation type of time stepper updates. Single precision
+  // builds can keep float state and accumulate updates in double
+  if(sizeof(dfloat)==4 && settings.compareSetting("ACCUMULATION PRECISION","DOUBLE"))
+    props["defines/" "afloat"]="double";
+  else
+    props["defines/" "afloat"]=dfloatString;
+
+  //storage type of geometric factors, meshes may select float
+  props["defines/" "gfloat"]=dfloatString;
+
   if(sizeof(pfloat)==4){
     props["defines/" "pfloat"]="float";
     props["defines/" "pfloat2"]="float2";
@@ -51,6 +51,21 @@ platformSettings_t::platformSettings_t(MPI_Comm _comm):
   newSetting("CACHE DIR",
              LIBP_DIR "/.occa",
              "Path for OCCA to place kernel cache");
+
+  newSetting("DEVICE STEP CONTROLLER",
+             "FALSE",
+             "Reduce the adaptive step error on the device and accept steps speculatively",
+             {"TRUE", "FALSE"});
+
+  newSetting("ACCUMULATION PRECISION",
+             "DFLOAT",
+             "Precision of time stepper update arithmetic. DOUBLE accumulates float state in double in single precision builds",
+             {"DFLOAT", "DOUBLE"});
+
+  newSetting("MEMORY REPORT",
+             "FALSE",
+             "Print the current and peak device memory footprint at the end of a run",
+             {"TRUE", "FALSE"});
 }
 
 void platformSettings_t::report() {
@@ -66,6 +81,12 @@ void platformSettings_t::report() {
     if (compareSetting("THREAD MODEL","OpenCL"))
       reportSetting("PLATFORM NUMBER");
 
+    reportSetting("DEVICE STEP CONTROLLER");
+    reportSetting("MEMORY REPORT");
+
+    if (sizeof(dfloat)==4)
+      reportSetting("ACCUMULATION PRECISION");
+
     int size;
     MPI_Comm_size(comm, &size);
     if ((size==1)
@@ -203,6 +203,37 @@ dfloat linAlg_t::innerProd(const dlong N, occa::memory& o_x, occa::memory& o_y,
   return globaldot;
 }
 
+// o_x.o_y of each set, entry n is in set (n/stride)%Nsets
+void linAlg_t::innerProdMulti(const dlong N, const int Nsets, const dlong stride,
+                              occa::memory& o_x, occa::memory& o_y,
+                              MPI_Comm comm, dfloat *dots) {
+  //partial sums of all sets must fit in the scratch space
+  if (Nsets>blocksize) {
+    std::stringstream ss;
+    ss << "innerProdMulti supports at most " << blocksize << " sets";
+    LIBP_ABORT(ss.str());
+  }
+
+  int Nblock = (N/Nsets+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize/Nsets) ? blocksize/Nsets : Nblock; //limit to blocksize entries
+  Nblock = (Nblock<1) ? 1 : Nblock;
+
+  innerProdMultiKernel(Nblock, N, Nsets, stride, o_x, o_y, o_scratch);
+
+  o_scratch.copyTo(scratch, Nsets*Nblock*sizeof(dfloat));
+
+  dfloat *localdots = (dfloat*) calloc(Nsets, sizeof(dfloat));
+  for(int m=0;m<Nsets;++m){
+    for(dlong n=0;n<Nblock;++n){
+      localdots[m] += scratch[m*Nblock+n];
+    }
+  }
+
+  MPI_Allreduce(localdots, dots, Nsets, MPI_DFLOAT, MPI_SUM, comm);
+
+  free(localdots);
+}
+
 // o_w.o_x.o_y
 dfloat linAlg_t::weightedInnerProd(const dlong N, occa::memory& o_w,
                                    occa::memory& o_x, occa::memory& o_y,
@@ -156,6 +156,12 @@ void linAlg_t::InitKernels(vector<string> kernels) {
                                         "linAlgInnerProd.okl",
                                         "innerProd",
                                         kernelInfo);
+    } else if (name=="innerProdMulti") {
+      if (innerProdMultiKernel.isInitialized()==false)
+        innerProdMultiKernel = platform->buildKernel(LINALG_DIR "/okl/"
+                                        "linAlgInnerProdMulti.okl",
+                                        "innerProdMulti",
+                                        kernelInfo);
     } else if (name=="weightedInnerProd") {
       if (weightedInnerProdKernel.isInitialized()==false)
         weightedInnerProdKernel = platform->buildKernel(LINALG_DIR "/okl/"
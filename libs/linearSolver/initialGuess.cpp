@@ -26,6 +26,7 @@ SOFTWARE.
 
 #include "initialGuess.hpp"
 #include "mesh.hpp"
+#include <limits>
 
 initialGuessSolver_t* initialGuessSolver_t::Setup(dlong N, dlong Nhalo, platform_t& platform, settings_t& settings, MPI_Comm comm)
 {
@@ -41,6 +42,8 @@ initialGuessSolver_t* initialGuessSolver_t::Setup(dlong N, dlong Nhalo, platform
     initialGuessSolver->igStrategy = new igClassicProjectionStrategy(N, platform, settings, comm);
   } else if (settings.compareSetting("INITIAL GUESS STRATEGY", "QR")) {
     initialGuessSolver->igStrategy = new igRollingQRProjectionStrategy(N, platform, settings, comm);
+  } else if (settings.compareSetting("INITIAL GUESS STRATEGY", "ADAPTIVE")) {
+    initialGuessSolver->igStrategy = new igAdaptiveProjectionStrategy(N, platform, settings, comm);
   } else if (settings.compareSetting("INITIAL GUESS STRATEGY", "EXTRAP")) {
     initialGuessSolver->igStrategy = new igExtrapStrategy(N, platform, settings, comm);
   } else {
@@ -70,6 +73,7 @@ int initialGuessSolver_t::Solve(solver_t& solver, precon_t& precon, occa::memory
 
   igStrategy->FormInitialGuess(o_x, o_rhs);
   iter = linearSolver->Solve(solver, precon, o_x, o_rhs, tol, MAXIT, verbose);
+  igStrategy->RecordIterations(iter);
   igStrategy->Update(solver, o_x, o_rhs);
 
   return iter;
@@ -82,12 +86,17 @@ void initialGuessAddSettings(settings_t& settings, const string prefix)
   settings.newSetting(prefix + "INITIAL GUESS STRATEGY",
                       "NONE",
                       "Strategy for selecting initial guess for linear solver",
-                      {"NONE", "ZERO", "CLASSIC", "QR", "EXTRAP"});
+                      {"NONE", "ZERO", "CLASSIC", "QR", "EXTRAP", "ADAPTIVE"});
 
   settings.newSetting(prefix + "INITIAL GUESS HISTORY SPACE DIMENSION",
                       "-1",
                       "Dimension of the initial guess space");
 
+  settings.newSetting(prefix + "INITIAL GUESS BASIS PRECISION",
+                      "FLOAT",
+                      "Storage precision of the ADAPTIVE initial guess space",
+                      {"FLOAT", "DOUBLE"});
+
   settings.newSetting(prefix + "INITIAL GUESS EXTRAP DEGREE",
                       "-1",
                       "Degree used for EXTRAP initial guess schemes.");
@@ -452,6 +461,226 @@ void igRollingQRProjectionStrategy::givensRotation(dfloat a, dfloat b, dfloat *c
 
 /*****************************************************************************/
 
+igAdaptiveProjectionStrategy::igAdaptiveProjectionStrategy(dlong _N, platform_t& _platform, settings_t& _settings, MPI_Comm _comm):
+  initialGuessStrategy_t(_N, _platform, _settings, _comm)
+{
+  curDim = 0;
+  settings.getSetting("INITIAL GUESS HISTORY SPACE DIMENSION", maxDim);
+
+  if (maxDim < 1 || maxDim >= BLOCKSIZE) {
+    std::stringstream ss;
+    ss << "Initial guess space dimension (" << maxDim << ") must be between 1 and " << BLOCKSIZE-1 << ".";
+    LIBP_ABORT(ss.str());
+  }
+
+  // Start with a small space and let the iteration history grow it.
+  targetDim = mymin(2, maxDim);
+
+  Nsolves = 0;
+  NiterCycle = 0;
+  lastAvgIter = -1.0;
+  growing = 1;
+  Ncycles = 0;
+
+  occa::properties kernelInfo = platform.props;
+  kernelInfo["defines/" "p_igNhist"] = maxDim;
+
+  if (settings.compareSetting("INITIAL GUESS BASIS PRECISION", "FLOAT")) {
+    igfloatSize = sizeof(float);
+    kernelInfo["defines/" "igfloat"] = "float";
+  } else {
+    igfloatSize = sizeof(double);
+    kernelInfo["defines/" "igfloat"] = "double";
+  }
+
+  o_btilde = platform.malloc(Ntotal*sizeof(dfloat));
+  o_xtilde = platform.malloc(Ntotal*sizeof(dfloat));
+  o_Btilde = platform.malloc(Ntotal*maxDim*igfloatSize);
+  o_Xtilde = platform.malloc(Ntotal*maxDim*igfloatSize);
+
+  // one extra slot for b.b
+  alphas = new dfloat[maxDim+1]();
+  alphasThisRank = new dfloat[maxDim+1]();
+  o_alphas = platform.malloc((maxDim+1)*sizeof(dfloat));
+
+  ctmpNblocks = (Ntotal + BLOCKSIZE - 1)/BLOCKSIZE;
+  o_ctmp = platform.malloc(ctmpNblocks*(maxDim+1)*sizeof(dfloat));
+
+  igFusedInnerProductsKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/igFusedInnerProducts.okl", "igFusedInnerProducts", kernelInfo);
+  igFusedBlockSumKernel      = platform.buildKernel(LINEARSOLVER_DIR "/okl/igFusedInnerProducts.okl", "igFusedBlockSum",      kernelInfo);
+  igFusedUpdateKernel        = platform.buildKernel(LINEARSOLVER_DIR "/okl/igFusedUpdate.okl",        "igFusedUpdate",        kernelInfo);
+  igFusedReconstructKernel   = platform.buildKernel(LINEARSOLVER_DIR "/okl/igFusedUpdate.okl",        "igFusedReconstruct",   kernelInfo);
+
+  return;
+}
+
+igAdaptiveProjectionStrategy::~igAdaptiveProjectionStrategy()
+{
+  if (alphas)
+    delete[] alphas;
+  if (alphasThisRank)
+    delete[] alphasThisRank;
+
+  if (o_btilde.size()) o_btilde.free();
+  if (o_xtilde.size()) o_xtilde.free();
+  if (o_Btilde.size()) o_Btilde.free();
+  if (o_Xtilde.size()) o_Xtilde.free();
+  if (o_alphas.size()) o_alphas.free();
+  if (o_ctmp.size())   o_ctmp.free();
+
+  igFusedInnerProductsKernel.free();
+  igFusedBlockSumKernel.free();
+  igFusedUpdateKernel.free();
+  igFusedReconstructKernel.free();
+
+  return;
+}
+
+void igAdaptiveProjectionStrategy::FormInitialGuess(occa::memory& o_x, occa::memory& o_rhs)
+{
+  if (curDim > 0) {
+    igFusedInnerProducts(o_rhs, curDim);
+    igFusedReconstructKernel(Ntotal, curDim, o_alphas, o_Xtilde, o_x);
+  }
+
+  return;
+}
+
+// alphas[m] = b.Btilde[m] for m < dim, and alphas[dim] = b.b, with a single MPI_Allreduce
+void igAdaptiveProjectionStrategy::igFusedInnerProducts(occa::memory& o_b, const dlong dim)
+{
+  igFusedInnerProductsKernel(Ntotal, ctmpNblocks, dim, o_b, o_Btilde, o_ctmp);
+  igFusedBlockSumKernel(ctmpNblocks, dim, o_ctmp, o_alphas);
+
+  o_alphas.copyTo(alphasThisRank, (dim+1)*sizeof(dfloat));
+
+  MPI_Allreduce(alphasThisRank, alphas, dim+1, MPI_DFLOAT, MPI_SUM, comm);
+  o_alphas.copyFrom(alphas, (dim+1)*sizeof(dfloat));
+
+  return;
+}
+
+void igAdaptiveProjectionStrategy::Update(solver_t &solver, occa::memory& o_x, occa::memory& o_rhs)
+{
+  // Compute RHS corresponding to the approximate solution obtained.
+  solver.Operator(o_x, o_btilde);
+
+  // Restart the space once it is full, resizing it from the iteration history.
+  if (curDim >= targetDim) {
+    AdaptDimension();
+    curDim = 0;
+  }
+
+  o_x.copyTo(o_xtilde, Ntotal*sizeof(dfloat));
+
+  // Projections onto the space and b.b in one reduction. Since the basis is
+  // orthonormal the norm of the projected vector follows without another pass.
+  igFusedInnerProducts(o_btilde, curDim);
+
+  const dfloat normbtilde2 = alphas[curDim];
+
+  dfloat normbtildeproj2 = normbtilde2;
+  for (int i = 0; i < curDim; i++)
+    normbtildeproj2 -= alphas[i]*alphas[i];
+
+  // Severe cancellation makes the estimate unreliable, so orthogonalize once
+  // more and recompute ("twice is enough").
+  if (curDim > 0 && normbtildeproj2 < 0.5*normbtilde2) {
+    igFusedUpdateKernel(Ntotal, curDim, o_alphas, (dfloat)1.0, o_btilde, o_xtilde, 0, o_Btilde, o_Xtilde);
+
+    igFusedInnerProducts(o_btilde, curDim);
+
+    normbtildeproj2 = alphas[curDim];
+    for (int i = 0; i < curDim; i++)
+      normbtildeproj2 -= alphas[i]*alphas[i];
+  }
+
+  // Only add if the remainder after projection is resolvable. The subtraction
+  // above loses about eps*normbtilde2 in the coarser of dfloat and the basis type.
+  const bool singleBasis = (igfloatSize == sizeof(float)) || (sizeof(dfloat) == sizeof(float));
+  const dfloat eps = singleBasis ? std::numeric_limits<float>::epsilon()
+                                 : std::numeric_limits<double>::epsilon();
+
+  if (normbtilde2 > 0 && normbtildeproj2 > 100*eps*normbtilde2) {
+    const dfloat invnormbtildeproj = 1.0/sqrt(normbtildeproj2);
+    igFusedUpdateKernel(Ntotal, curDim, o_alphas, invnormbtildeproj, o_btilde, o_xtilde, 1, o_Btilde, o_Xtilde);
+
+    curDim++;
+  }
+
+  return;
+}
+
+void igAdaptiveProjectionStrategy::RecordIterations(const int Niter)
+{
+  // A solve without a projected guess says nothing about the space size.
+  if (curDim == 0) return;
+
+  Nsolves++;
+  NiterCycle += Niter;
+
+  return;
+}
+
+// Choose the restart dimension by hill climbing on the average iteration
+// count per solve over a restart cycle. Iteration counts are global, so
+// every rank makes the same choice.
+void igAdaptiveProjectionStrategy::AdaptDimension()
+{
+  // An extra basis vector streams about four more vectors per solve, a small
+  // fraction of one preconditioned iteration. Keep it only if it saves at
+  // least this many iterations per solve.
+  const dfloat minSavings = 0.5;
+
+  // Cycles at a settled dimension before a larger space is probed again.
+  const int NcyclesProbe = 16;
+
+  if (Nsolves == 0) return;
+
+  const dfloat avgIter = ((dfloat) NiterCycle)/Nsolves;
+
+  Nsolves = 0;
+  NiterCycle = 0;
+  Ncycles++;
+
+  if (lastAvgIter < 0) {
+    // First full cycle, nothing to compare against yet.
+    lastAvgIter = avgIter;
+    if (targetDim < maxDim) {
+      targetDim++;
+    } else {
+      growing = 0;
+    }
+    Ncycles = 0;
+  } else if (growing) {
+    if (lastAvgIter - avgIter >= minSavings) {
+      // The larger space paid for itself, try another.
+      lastAvgIter = avgIter;
+      if (targetDim < maxDim) {
+        targetDim++;
+      } else {
+        growing = 0;
+      }
+    } else {
+      // No worthwhile savings, fall back to the previous size.
+      targetDim = mymax(1, targetDim - 1);
+      growing = 0;
+    }
+    Ncycles = 0;
+  } else {
+    lastAvgIter = avgIter;
+    if (Ncycles >= NcyclesProbe && targetDim < maxDim) {
+      targetDim++;
+      growing = 1;
+      Ncycles = 0;
+    }
+  }
+
+  return;
+}
+
+/*****************************************************************************/
+
 igExtrapStrategy::igExtrapStrategy(dlong _N, platform_t& _platform, settings_t& _settings, MPI_Comm _comm):
   initialGuessStrategy_t(_N, _platform, _settings, _comm)
 {
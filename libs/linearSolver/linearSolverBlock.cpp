@@ -0,0 +1,173 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "linearSolver.hpp"
+
+#define BLOCK_BLOCKSIZE 256
+
+//virtual base block linear solver class
+blockLinearSolver_t* blockLinearSolver_t::Setup(dlong N, dlong Nhalo, int maxNrhs,
+                                                platform_t& platform, settings_t& settings, MPI_Comm comm) {
+
+  blockLinearSolver_t *linearSolver=NULL;
+
+  if (settings.compareSetting("LINEAR SOLVER","PCG")){
+    linearSolver = new bpcg(N, Nhalo, maxNrhs, platform, settings, comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","PGMRES")){
+    linearSolver = new bpgmres(N, Nhalo, maxNrhs, platform, settings, comm);
+  } else {
+    LIBP_ABORT(string("Requested LINEAR SOLVER has no multiple right-hand side version."));
+  }
+
+  return linearSolver;
+}
+
+blockLinearSolver_t::blockLinearSolver_t(dlong _N, dlong _Nhalo, int _maxNrhs,
+                                         platform_t& _platform, settings_t& _settings, MPI_Comm _comm):
+  platform(_platform), settings(_settings), comm(_comm),
+  N(_N), Nhalo(_Nhalo), maxNrhs(_maxNrhs) {
+
+  if (maxNrhs<1)
+    LIBP_ABORT(string("Block linear solver needs at least one right-hand side."));
+
+  //pinned tmp buffer for reductions
+  tmpdots = (dfloat*) platform.hostMalloc(BLOCK_BLOCKSIZE*maxNrhs*maxNrhs*sizeof(dfloat),
+                                          NULL, h_tmpdots);
+  o_tmpdots = platform.malloc(BLOCK_BLOCKSIZE*maxNrhs*maxNrhs*sizeof(dfloat));
+
+  //small dense coefficient matrices
+  o_C = platform.malloc(maxNrhs*maxNrhs*sizeof(dfloat));
+
+  //scratch column for reordering block vectors
+  o_swap = platform.malloc((N+Nhalo)*sizeof(dfloat));
+
+  /* build kernels */
+  occa::properties kernelInfo = platform.props; //copy base properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)BLOCK_BLOCKSIZE;
+  kernelInfo["defines/" "p_maxNrhs"] = maxNrhs;
+
+  blockInnerProdsKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverBlockInnerProds.okl",
+                                               "blockInnerProds", kernelInfo);
+  blockUpdateKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverBlockUpdate.okl",
+                                           "blockUpdate", kernelInfo);
+}
+
+void blockLinearSolver_t::BlockInnerProds(const int Nx, occa::memory& o_X,
+                                          const int Ny, occa::memory& o_Y, dfloat *G){
+
+  int Nblocks = (N+BLOCK_BLOCKSIZE-1)/BLOCK_BLOCKSIZE;
+  Nblocks = (Nblocks>BLOCK_BLOCKSIZE) ? BLOCK_BLOCKSIZE : Nblocks; //limit to BLOCK_BLOCKSIZE entries
+
+  const int Ndots = Nx*Ny;
+
+  if (Nblocks) {
+    blockInnerProdsKernel(N, Nblocks, Nx, Ny, N+Nhalo, o_X, o_Y, o_tmpdots);
+    o_tmpdots.copyTo(tmpdots, Nblocks*Ndots*sizeof(dfloat));
+  }
+
+  dfloat *localdots = (dfloat*) calloc(Ndots, sizeof(dfloat));
+  for(int m=0;m<Ndots;++m)
+    for(int n=0;n<Nblocks;++n)
+      localdots[m] += tmpdots[n + Nblocks*m];
+
+  //all Nx*Ny inner products in one reduction
+  MPI_Allreduce(localdots, G, Ndots, MPI_DFLOAT, MPI_SUM, comm);
+  free(localdots);
+}
+
+void blockLinearSolver_t::BlockUpdate(const int Nx, const dfloat alpha, occa::memory& o_X,
+                                      const dfloat *C,
+                                      const int Ny, const dfloat beta, occa::memory& o_Y){
+
+  o_C.copyFrom(C, Nx*Ny*sizeof(dfloat));
+
+  if (N)
+    blockUpdateKernel(N, Nx, Ny, N+Nhalo, alpha, o_X, o_C, beta, o_Y);
+}
+
+// Cholesky factorization A = L*L^T of a small SPD matrix, in place.
+// A is n x n and column major. Returns 0 if A is (numerically) singular,
+// which signals a breakdown of the block iteration. Column j is taken as
+// singular once its pivot drops to tol*A(j,j), and j is then returned in
+// dependent.
+int blockLinearSolver_t::Cholesky(const int n, dfloat *A, const dfloat tol, int *dependent) {
+
+  for(int j=0;j<n;++j){
+    dfloat d = A[j+j*n];
+    const dfloat dmin = tol*d;
+    for(int k=0;k<j;++k) d -= A[j+k*n]*A[j+k*n];
+    if (d<=dmin) {
+      if (dependent) *dependent = j;
+      return 0;
+    }
+    d = sqrt(d);
+    A[j+j*n] = d;
+    for(int i=j+1;i<n;++i){
+      dfloat a = A[i+j*n];
+      for(int k=0;k<j;++k) a -= A[i+k*n]*A[j+k*n];
+      A[i+j*n] = a/d;
+    }
+  }
+  return 1;
+}
+
+// Solve L*L^T*X = B in place, with L from Cholesky. B is n x m.
+void blockLinearSolver_t::CholeskySolve(const int n, const dfloat *L,
+                                        const int m, dfloat *B) {
+
+  for(int c=0;c<m;++c){
+    dfloat *b = B + c*n;
+    //forward solve with L
+    for(int i=0;i<n;++i){
+      for(int k=0;k<i;++k) b[i] -= L[i+k*n]*b[k];
+      b[i] /= L[i+i*n];
+    }
+    //backward solve with L^T
+    for(int i=n-1;i>=0;--i){
+      for(int k=i+1;k<n;++k) b[i] -= L[k+i*n]*b[k];
+      b[i] /= L[i+i*n];
+    }
+  }
+}
+
+void blockLinearSolver_t::SwapColumns(occa::memory& o_X, const int i, const int j) {
+
+  if (i==j || N==0) return;
+
+  occa::memory o_Xi = Column(o_X, i);
+  occa::memory o_Xj = Column(o_X, j);
+  o_swap.copyFrom(o_Xi, N*sizeof(dfloat));
+  o_Xi.copyFrom(o_Xj, N*sizeof(dfloat));
+  o_Xj.copyFrom(o_swap, N*sizeof(dfloat));
+}
+
+blockLinearSolver_t::~blockLinearSolver_t() {
+  blockInnerProdsKernel.free();
+  blockUpdateKernel.free();
+}
@@ -0,0 +1,238 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "linearSolver.hpp"
+#include <limits>
+
+bpcg::bpcg(dlong _N, dlong _Nhalo, int _maxNrhs,
+           platform_t& _platform, settings_t& _settings, MPI_Comm _comm):
+  blockLinearSolver_t(_N, _Nhalo, _maxNrhs, _platform, _settings, _comm) {
+
+  // Make sure LinAlg has the necessary kernels
+  platform.linAlg.InitKernels({"axpy"});
+
+  dlong Ntotal = (N + Nhalo)*maxNrhs;
+
+  /*aux variables */
+  dfloat *dummy = (dfloat *) calloc(Ntotal,sizeof(dfloat)); //need this to avoid uninitialized memory warnings
+  o_p  = platform.malloc(Ntotal*sizeof(dfloat),dummy);
+  o_z  = platform.malloc(Ntotal*sizeof(dfloat),dummy);
+  o_Ax = platform.malloc(Ntotal*sizeof(dfloat),dummy);
+  o_Ap = platform.malloc(Ntotal*sizeof(dfloat),dummy);
+  free(dummy);
+
+  PAP   = (dfloat *) calloc(maxNrhs*maxNrhs, sizeof(dfloat));
+  PAP0  = (dfloat *) calloc(maxNrhs*maxNrhs, sizeof(dfloat));
+  alpha = (dfloat *) calloc(maxNrhs*maxNrhs, sizeof(dfloat));
+  beta  = (dfloat *) calloc(maxNrhs*maxNrhs, sizeof(dfloat));
+  rdotr = (dfloat *) calloc(maxNrhs*maxNrhs, sizeof(dfloat));
+}
+
+/* Block PCG with deflation, in the Hestenes-Stiefel form
+
+   P_k     = Z_k - P_{k-1} (P^T A P)_{k-1}^{-1} (A P_{k-1})^T Z_k
+   alpha_k = (P^T A P)_k^{-1} P_k^T R_k
+
+   which holds for any number of search directions. Converged right-hand
+   sides are moved behind the active columns of X and R and dropped from
+   the block, and search directions that are (numerically) dependent in
+   the A-inner product are dropped before P^T A P is factored, so the
+   iteration does not break down when right-hand sides converge at
+   different rates or are linearly dependent. */
+int bpcg::Solve(solver_t& solver, precon_t& precon, const int Nrhs,
+                occa::memory &o_x, occa::memory &o_r,
+                const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  linAlg_t &linAlg = platform.linAlg;
+
+  if (Nrhs>maxNrhs)
+    LIBP_ABORT(string("Too many right-hand sides for this block solver."));
+
+  const dlong stride = N + Nhalo;
+  const int s = Nrhs;
+
+  //tolerance, squared residual norm, and original index of each column
+  dfloat *TOL = (dfloat *) calloc(s, sizeof(dfloat));
+  dfloat *rr  = (dfloat *) calloc(s, sizeof(dfloat));
+  int *perm   = (int *) calloc(s, sizeof(int));
+  for(int j=0;j<s;++j) perm[j] = j;
+
+  // Comput norm of RHS (for stopping tolerance).
+  if (settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-RHS-2NORM")) {
+    BlockInnerProds(s, o_r, s, o_r, rdotr);
+    for(int j=0;j<s;++j)
+      TOL[j] = mymax(tol*tol*rdotr[j+j*s], tol*tol);
+  }
+
+  // compute A*X
+  solver.BlockOperator(s, stride, o_x, o_Ax);
+
+  // subtract R = R - A*X
+  for(int j=0;j<s;++j){
+    occa::memory o_Axj = Column(o_Ax, j);
+    occa::memory o_rj  = Column(o_r, j);
+    linAlg.axpy(N, -1.f, o_Axj, 1.f, o_rj);
+  }
+
+  // all residual norms in one reduction
+  BlockInnerProds(s, o_r, s, o_r, rdotr);
+  for(int j=0;j<s;++j) rr[j] = rdotr[j+j*s];
+
+  if (settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-INITRESID")) {
+    for(int j=0;j<s;++j)
+      TOL[j] = mymax(tol*tol*rr[j], tol*tol);
+  }
+
+  if (verbose&&(rank==0))
+    for(int j=0;j<s;++j)
+      printf("BPCG: rhs %d initial res norm %12.12f \n", j, sqrt(rr[j]));
+
+  int Na = s; //active right-hand sides
+  int Np = 0; //search directions
+
+  int iter;
+  for(iter=0;iter<MAXIT;++iter){
+
+    // Drop the right-hand sides that have reached their tolerance, taking
+    // at least one step. They are kept behind the Na active columns.
+    for(int j=0;j<Na;){
+      if (((iter == 0) && (rr[j] == 0.0)) ||
+          ((iter > 0) && (rr[j] <= TOL[j]))) {
+        Na--;
+        SwapColumns(o_x, j, Na);
+        SwapColumns(o_r, j, Na);
+        std::swap(TOL[j], TOL[Na]);
+        std::swap(rr[j], rr[Na]);
+        std::swap(perm[j], perm[Na]);
+      } else {
+        ++j;
+      }
+    }
+    if (Na==0) break;
+
+    // Z = Precon^{-1} R
+    precon.BlockOperator(Na, stride, o_r, o_z);
+
+    if (Np>0) {
+      // beta = (P^T*A*P)^{-1} (A*P)^T Z, with P^T*A*P factored last step
+      BlockInnerProds(Np, o_Ap, Na, o_z, beta);
+      CholeskySolve(Np, PAP, Na, beta);
+
+      // Z = Z - P*beta
+      BlockUpdate(Np, -1.0, o_p, beta, Na, 1.0, o_z);
+    }
+
+    // P = Z
+    occa::memory o_tmp = o_p; o_p = o_z; o_z = o_tmp;
+    Np = Na;
+
+    // A*P
+    solver.BlockOperator(Np, stride, o_p, o_Ap);
+
+    // P^T*A*P, dropping dependent search directions
+    BlockInnerProds(Np, o_p, Np, o_Ap, PAP);
+    Np = FactorSearchDirections(Np);
+    if (Np==0) {
+      if (verbose&&(rank==0))
+        printf("BPCG: breakdown, no independent search directions left\n");
+      break;
+    }
+
+    // alpha = (P^T*A*P)^{-1} (P^T*R)
+    BlockInnerProds(Np, o_p, Na, o_r, alpha);
+    CholeskySolve(Np, PAP, Na, alpha);
+
+    //  X <= X + P*alpha
+    //  R <= R - A*P*alpha
+    BlockUpdate(Np,  1.0, o_p,  alpha, Na, 1.0, o_x);
+    BlockUpdate(Np, -1.0, o_Ap, alpha, Na, 1.0, o_r);
+
+    // R^T*R
+    BlockInnerProds(Na, o_r, Na, o_r, rdotr);
+    for(int j=0;j<Na;++j) rr[j] = rdotr[j+j*Na];
+
+    if (verbose&&(rank==0)) {
+      for(int j=0;j<Na;++j)
+        printf("BPCG: it %d, rhs %d, r norm %12.12le \n", iter+1, perm[j], sqrt(rr[j]));
+    }
+  }
+
+  // restore the original column order
+  for(int j=0;j<s;++j){
+    while (perm[j]!=j) {
+      const int k = perm[j];
+      SwapColumns(o_x, j, k);
+      SwapColumns(o_r, j, k);
+      std::swap(perm[j], perm[k]);
+    }
+  }
+
+  free(TOL);
+  free(rr);
+  free(perm);
+
+  return iter;
+}
+
+// Cholesky factor the Np x Np matrix P^T*A*P in PAP. A search direction
+// that is dependent on the ones before it is swapped to the back of P and
+// A*P and dropped, and the factorization is repeated on the rest.
+// Returns the number of search directions kept.
+int bpcg::FactorSearchDirections(int Np) {
+
+  const dfloat dropTol = 1.0e3*std::numeric_limits<dfloat>::epsilon();
+
+  for(int m=0;m<Np*Np;++m) PAP0[m] = PAP[m];
+
+  int dependent = 0;
+  while (Np>0 && !Cholesky(Np, PAP, dropTol, &dependent)) {
+    const int last = Np-1;
+    SwapColumns(o_p,  dependent, last);
+    SwapColumns(o_Ap, dependent, last);
+
+    //swap row and column of P^T*A*P, and drop the last ones
+    for(int i=0;i<Np;++i) std::swap(PAP0[i+dependent*Np], PAP0[i+last*Np]);
+    for(int i=0;i<Np;++i) std::swap(PAP0[dependent+i*Np], PAP0[last+i*Np]);
+    for(int j=0;j<last;++j)
+      for(int i=0;i<last;++i)
+        PAP[i+j*last] = PAP0[i+j*Np];
+    Np = last;
+    for(int m=0;m<Np*Np;++m) PAP0[m] = PAP[m];
+  }
+
+  return Np;
+}
+
+bpcg::~bpcg() {
+  free(PAP);
+  free(PAP0);
+  free(alpha);
+  free(beta);
+  free(rdotr);
+}
@@ -0,0 +1,365 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "linearSolver.hpp"
+
+#define BPGMRES_RESTART 20
+
+bpgmres::bpgmres(dlong _N, dlong _Nhalo, int _maxNrhs,
+                 platform_t& _platform, settings_t& _settings, MPI_Comm _comm):
+  blockLinearSolver_t(_N, _Nhalo, _maxNrhs, _platform, _settings, _comm) {
+
+  // Make sure LinAlg has the necessary kernels
+  platform.linAlg.InitKernels({"zaxpy"});
+
+  dlong Ntotal = (N + Nhalo)*maxNrhs;
+
+  //Number of block iterations between restarts
+  restart=BPGMRES_RESTART;
+
+  dfloat *dummy = (dfloat *) calloc(Ntotal,sizeof(dfloat)); //need this to avoid uninitialized memory warnings
+
+  o_V = new occa::memory[restart];
+  for(int i=0; i<restart; ++i){
+    o_V[i] = platform.malloc(Ntotal*sizeof(dfloat), dummy);
+  }
+
+  const int s = maxNrhs;
+
+  //block Hessenberg matrix, rotated residual, and coefficients
+  H  = (dfloat *) calloc((restart+1)*s*restart*s, sizeof(dfloat));
+  G  = (dfloat *) calloc((restart+1)*s*s, sizeof(dfloat));
+  Y  = (dfloat *) calloc(restart*s*s, sizeof(dfloat));
+  S  = (dfloat *) calloc(s*s, sizeof(dfloat));
+  sn = (dfloat *) calloc(restart*s*s, sizeof(dfloat));
+  cs = (dfloat *) calloc(restart*s*s, sizeof(dfloat));
+
+  /*aux variables */
+  o_Ax = platform.malloc(Ntotal*sizeof(dfloat), dummy);
+  o_z  = platform.malloc(Ntotal*sizeof(dfloat), dummy);
+  o_r  = platform.malloc(Ntotal*sizeof(dfloat), dummy);
+  free(dummy);
+}
+
+int bpgmres::Solve(solver_t& solver, precon_t& precon, const int Nrhs,
+                   occa::memory &o_x, occa::memory &o_b,
+                   const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  linAlg_t &linAlg = platform.linAlg;
+
+  if (Nrhs>maxNrhs)
+    LIBP_ABORT(string("Too many right-hand sides for this block solver."));
+
+  const dlong stride = N + Nhalo;
+  int s = Nrhs; //active right-hand sides
+
+  dfloat *TOL   = (dfloat *) calloc(s, sizeof(dfloat));
+  dfloat *error = (dfloat *) calloc(s, sizeof(dfloat));
+
+  //original index of each column
+  int *perm = (int *) calloc(s, sizeof(int));
+  for(int j=0;j<s;++j) perm[j] = j;
+
+  int iter=0;
+  int converged=0, happy=0;
+
+  for(int cycle=0;;++cycle){
+
+    const int ldH = (restart+1)*s;
+
+    // compute A*X
+    solver.BlockOperator(s, stride, o_x, o_Ax);
+
+    // subtract Z = B - A*X
+    for(int j=0;j<s;++j){
+      occa::memory o_Axj = Column(o_Ax, j);
+      occa::memory o_bj  = Column(o_b, j);
+      occa::memory o_zj  = Column(o_z, j);
+      linAlg.zaxpy(N, -1.f, o_Axj, 1.f, o_bj, o_zj);
+    }
+
+    // R = Precon^{-1} (B-A*X)
+    precon.BlockOperator(s, stride, o_z, o_r);
+
+    // V(:,0)*S = R
+    happy = !CholeskyQR(s, o_r, o_V[0], S);
+
+    for(int m=0;m<ldH*s;++m) G[m] = 0.0;
+    if (happy) {
+      //residuals are linearly dependent, R is left untouched
+      BlockInnerProds(s, o_r, s, o_r, S);
+      for(int j=0;j<s;++j) error[j] = sqrt(S[j + j*s]);
+    } else {
+      for(int j=0;j<s;++j){
+        dfloat nr = 0.0;
+        for(int i=0;i<=j;++i){
+          G[i + j*ldH] = S[i + j*s];
+          nr += S[i + j*s]*S[i + j*s];
+        }
+        error[j] = sqrt(nr);
+      }
+    }
+    if (cycle==0)
+      for(int j=0;j<s;++j) TOL[j] = mymax(tol*error[j], tol);
+
+    if (verbose&&(rank==0)&&(cycle==0))
+      for(int j=0;j<s;++j)
+        printf("BPGMRES: rhs %d initial res norm %12.12f \n", perm[j], error[j]);
+
+    //exit if tolerance is reached
+    converged = 1;
+    for(int j=0;j<s;++j) if (error[j]>TOL[j]) converged = 0;
+    if (converged || happy || iter>=MAXIT) break;
+
+    //Construct orthonormal block basis via block Gram-Schmidt
+    int I = 0;
+    for(int i=0;i<restart;++i){
+      // compute Z = A*V(:,i)
+      solver.BlockOperator(s, stride, o_V[i], o_z);
+
+      // R = Precon^{-1} Z
+      precon.BlockOperator(s, stride, o_z, o_r);
+
+      for(int k=0; k<=i; ++k){
+        // H(k,i) = V(:,k)^T*R, all s*s products in one reduction
+        BlockInnerProds(s, o_V[k], s, o_r, S);
+
+        // R = R - V(:,k)*H(k,i)
+        BlockUpdate(s, -1.0, o_V[k], S, s, 1.0, o_r);
+
+        for(int b=0;b<s;++b)
+          for(int a=0;a<s;++a)
+            H[k*s+a + (i*s+b)*ldH] = S[a + b*s];
+      }
+
+      // V(:,i+1)*H(i+1,i) = R
+      occa::memory &o_Q = (i<restart-1) ? o_V[i+1] : o_z;
+      happy = !CholeskyQR(s, o_r, o_Q, S);
+
+      //on breakdown the Krylov space is exhausted, drop the new block
+      if (happy) for(int m=0;m<s*s;++m) S[m] = 0.0;
+
+      for(int b=0;b<s;++b)
+        for(int a=0;a<s;++a)
+          H[(i+1)*s+a + (i*s+b)*ldH] = S[a + b*s];
+
+      //reduce the new block column to upper triangular form with Givens rotations
+      for(int b=0;b<s;++b){
+        const int c = i*s+b;
+        dfloat *h = H + c*ldH;
+
+        //apply previous rotations
+        for(int cp=0;cp<c;++cp){
+          for(int l=s;l>=1;--l){
+            const int r = cp+l;
+            const dfloat h1 = h[r-1];
+            const dfloat h2 = h[r];
+            h[r-1] =  cs[cp*s+l-1]*h1 + sn[cp*s+l-1]*h2;
+            h[r]   = -sn[cp*s+l-1]*h1 + cs[cp*s+l-1]*h2;
+          }
+        }
+
+        //form rotations zeroing the subdiagonal entries of column c
+        for(int l=s;l>=1;--l){
+          const int r = c+l;
+          const dfloat h1 = h[r-1];
+          const dfloat h2 = h[r];
+          const dfloat hr = sqrt(h1*h1 + h2*h2);
+          const dfloat cl = (hr>0.0) ? h1/hr : 1.0;
+          const dfloat sl = (hr>0.0) ? h2/hr : 0.0;
+          cs[c*s+l-1] = cl;
+          sn[c*s+l-1] = sl;
+
+          h[r-1] = hr;
+          h[r]   = 0.0;
+
+          //rotate the residual
+          for(int j=0;j<s;++j){
+            const dfloat g1 = G[r-1 + j*ldH];
+            const dfloat g2 = G[r   + j*ldH];
+            G[r-1 + j*ldH] =  cl*g1 + sl*g2;
+            G[r   + j*ldH] = -sl*g1 + cl*g2;
+          }
+        }
+      }
+
+      iter++;
+      I = i+1;
+
+      //approximate residual norms
+      converged = 1;
+      for(int j=0;j<s;++j){
+        dfloat nr = 0.0;
+        for(int a=0;a<s;++a)
+          nr += G[(i+1)*s+a + j*ldH]*G[(i+1)*s+a + j*ldH];
+        error[j] = sqrt(nr);
+        if (error[j]>TOL[j]) converged = 0;
+      }
+
+      if (verbose&&(rank==0)) {
+        for(int j=0;j<s;++j)
+          printf("BPGMRES: it %d, rhs %d, approx residual norm %12.12le \n", iter, perm[j], error[j]);
+      }
+
+      if(converged || happy || iter==MAXIT) break;
+    }
+
+    //update approximation
+    UpdateBlockGMRES(s, o_x, I);
+
+    //exit if tolerance is reached
+    if(converged || happy || iter>=MAXIT) break;
+
+    // Drop the right-hand sides that have reached their tolerance before
+    // restarting. They are kept behind the s active columns.
+    for(int j=0;j<s;){
+      if (error[j]<=TOL[j]) {
+        s--;
+        SwapColumns(o_x, j, s);
+        SwapColumns(o_b, j, s);
+        std::swap(TOL[j], TOL[s]);
+        std::swap(error[j], error[s]);
+        std::swap(perm[j], perm[s]);
+      } else {
+        ++j;
+      }
+    }
+  }
+
+  if (verbose&&(rank==0)&&happy&&!converged)
+    printf("BPGMRES: breakdown, right-hand sides are (nearly) linearly dependent\n");
+
+  // restore the original column order
+  for(int j=0;j<Nrhs;++j){
+    while (perm[j]!=j) {
+      const int k = perm[j];
+      SwapColumns(o_x, j, k);
+      SwapColumns(o_b, j, k);
+      std::swap(perm[j], perm[k]);
+    }
+  }
+
+  free(TOL);
+  free(error);
+  free(perm);
+
+  return iter;
+}
+
+// Orthonormalize the s columns of W, W = Q*R with R upper triangular.
+// Cholesky QR is applied twice for stability, and W is used as scratch.
+// Returns 0 if the columns of W are (numerically) linearly dependent.
+int bpgmres::CholeskyQR(const int s, occa::memory& o_W, occa::memory& o_Q, dfloat *R) {
+
+  dfloat *L    = (dfloat *) calloc(s*s, sizeof(dfloat));
+  dfloat *Rinv = (dfloat *) calloc(s*s, sizeof(dfloat));
+  dfloat *R1   = (dfloat *) calloc(s*s, sizeof(dfloat));
+
+  for(int m=0;m<s*s;++m) R[m] = (m%(s+1)==0) ? 1.0 : 0.0;
+
+  int ok = 1;
+  for(int pass=0;pass<2 && ok;++pass){
+    occa::memory &o_in  = (pass==0) ? o_W : o_Q;
+    occa::memory &o_out = (pass==0) ? o_Q : o_W;
+
+    // Gram matrix L*L^T = in^T*in
+    BlockInnerProds(s, o_in, s, o_in, L);
+    ok = Cholesky(s, L);
+    if (!ok) break;
+
+    // Rinv = L^{-T}
+    for(int m=0;m<s*s;++m) Rinv[m] = (m%(s+1)==0) ? 1.0 : 0.0;
+    for(int c=0;c<s;++c){
+      dfloat *b = Rinv + c*s;
+      for(int i=s-1;i>=0;--i){
+        for(int k=i+1;k<s;++k) b[i] -= L[k+i*s]*b[k];
+        b[i] /= L[i+i*s];
+      }
+    }
+
+    // out = in*Rinv
+    BlockUpdate(s, 1.0, o_in, Rinv, s, 0.0, o_out);
+
+    // R = L^T*R
+    for(int j=0;j<s;++j){
+      for(int i=0;i<s;++i){
+        dfloat r = 0.0;
+        for(int k=i;k<s;++k) r += L[k+i*s]*R[k+j*s];
+        R1[i+j*s] = r;
+      }
+    }
+    for(int m=0;m<s*s;++m) R[m] = R1[m];
+  }
+
+  // the second pass leaves the result in W
+  if (ok) {
+    occa::memory o_tmp = o_Q; o_Q = o_W; o_W = o_tmp;
+  }
+
+  free(L); free(Rinv); free(R1);
+  return ok;
+}
+
+void bpgmres::UpdateBlockGMRES(const int s, occa::memory& o_x, const int I){
+
+  const int ldH = (restart+1)*s;
+  const int n = I*s;
+
+  // Y = H^{-1}*G, H upper triangular after the rotations
+  for(int j=0;j<s;++j){
+    for(int k=n-1; k>=0; --k){
+      dfloat y = G[k + j*ldH];
+
+      for(int m=k+1; m<n; ++m)
+        y -= H[k + m*ldH]*Y[m + j*n];
+
+      Y[k + j*n] = y/H[k + k*ldH];
+    }
+  }
+
+  // X = X + V(:,k)*Y(k,:)
+  for(int k=0; k<I; ++k){
+    for(int b=0;b<s;++b)
+      for(int a=0;a<s;++a)
+        S[a + b*s] = Y[k*s+a + b*n];
+
+    BlockUpdate(s, 1.0, o_V[k], S, s, 1.0, o_x);
+  }
+}
+
+bpgmres::~bpgmres() {
+  if(H) free(H);
+  if(G) free(G);
+  if(Y) free(Y);
+  if(S) free(S);
+  if(sn) free(sn);
+  if(cs) free(cs);
+
+  if (o_V) delete[] o_V;
+}
@@ -27,6 +27,7 @@ SOFTWARE.
 #include "mesh.hpp"
 #include "mesh/mesh2D.hpp"
 #include "mesh/mesh3D.hpp"
+#include "mesh/meshHierarchy.hpp"
 
 //makeing a mesh object requires it to be bound to a device and communicator
 mesh_t::mesh_t(platform_t& _platform, meshSettings_t& _settings, MPI_Comm _comm):
@@ -61,6 +62,8 @@ meshHex3D::meshHex3D(platform_t& _platform, meshSettings_t& _settings, MPI_Comm
   mesh3D(_platform, _settings, _comm) {}
 
 mesh_t::~mesh_t() {
+  // levels made from this mesh go with it
+  if (hierarchy && &(hierarchy->mesh)==this) delete hierarchy;
   if (halo) halo->Free();
   if (ringHalo) ringHalo->Free();
   if (ogs) ogs->Free();
@@ -57,7 +57,7 @@ static int findBestMatch(dfloat x1, dfloat y1,
   return matchIndex;
 }
 
-// serial face-node to face-node connection
+// face-node to face-node connection, threaded over elements
 void mesh2D::ConnectFaceNodes(){
 
   /* volume indices of the interior and exterior face nodes for each element */
@@ -81,6 +81,7 @@ void mesh2D::ConnectFaceNodes(){
   DIMY /= 2.0;
 
   /* assume elements already connected */
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){
     for(int f=0;f<Nfaces;++f){
       dlong eP = EToE[e*Nfaces+f];
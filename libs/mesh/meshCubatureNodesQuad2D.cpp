@@ -32,43 +32,47 @@ void meshQuad2D::CubatureNodes(){
   cubx = (dfloat*) calloc(Nelements*cubNp,sizeof(dfloat));
   cuby = (dfloat*) calloc(Nelements*cubNp,sizeof(dfloat));
 
-  //temp arrays
-  dfloat *Ix1 = (dfloat*) calloc(Nq*cubNq, sizeof(dfloat));
-  dfloat *Iy1 = (dfloat*) calloc(Nq*cubNq, sizeof(dfloat));
-
-  for(dlong e=0;e<Nelements;++e){ /* for each element */
-
-    dfloat *xe = x + e*Np;
-    dfloat *ye = y + e*Np;
-    dfloat *cubxe = cubx + e*cubNp;
-    dfloat *cubye = cuby + e*cubNp;
-
-    //interpolate physical coordinates to cubature
-    for(int j=0;j<Nq;++j){
-      for(int i=0;i<cubNq;++i){
-        Ix1[j*cubNq+i] = 0;
-        Iy1[j*cubNq+i] = 0;
-        for(int n=0;n<Nq;++n){
-          Ix1[j*cubNq+i] += cubInterp[i*Nq + n]*xe[j*Nq+n];
-          Iy1[j*cubNq+i] += cubInterp[i*Nq + n]*ye[j*Nq+n];
+  #pragma omp parallel
+  {
+    //per-thread temp arrays
+    dfloat *Ix1 = (dfloat*) calloc(Nq*cubNq, sizeof(dfloat));
+    dfloat *Iy1 = (dfloat*) calloc(Nq*cubNq, sizeof(dfloat));
+
+    #pragma omp for
+    for(dlong e=0;e<Nelements;++e){ /* for each element */
+
+      dfloat *xe = x + e*Np;
+      dfloat *ye = y + e*Np;
+      dfloat *cubxe = cubx + e*cubNp;
+      dfloat *cubye = cuby + e*cubNp;
+
+      //interpolate physical coordinates to cubature
+      for(int j=0;j<Nq;++j){
+        for(int i=0;i<cubNq;++i){
+          Ix1[j*cubNq+i] = 0;
+          Iy1[j*cubNq+i] = 0;
+          for(int n=0;n<Nq;++n){
+            Ix1[j*cubNq+i] += cubInterp[i*Nq + n]*xe[j*Nq+n];
+            Iy1[j*cubNq+i] += cubInterp[i*Nq + n]*ye[j*Nq+n];
+          }
         }
       }
-    }
 
-    for(int j=0;j<cubNq;++j){
-      for(int i=0;i<cubNq;++i){
-        cubxe[j*cubNq+i] = 0;
-        cubye[j*cubNq+i] = 0;
-        for(int n=0;n<Nq;++n){
-          cubxe[j*cubNq+i] += cubInterp[j*Nq + n]*Ix1[n*cubNq+i];
-          cubye[j*cubNq+i] += cubInterp[j*Nq + n]*Iy1[n*cubNq+i];
+      for(int j=0;j<cubNq;++j){
+        for(int i=0;i<cubNq;++i){
+          cubxe[j*cubNq+i] = 0;
+          cubye[j*cubNq+i] = 0;
+          for(int n=0;n<Nq;++n){
+            cubxe[j*cubNq+i] += cubInterp[j*Nq + n]*Ix1[n*cubNq+i];
+            cubye[j*cubNq+i] += cubInterp[j*Nq + n]*Iy1[n*cubNq+i];
+          }
         }
       }
     }
-  }
 
-  free(Ix1);
-  free(Iy1);
+    free(Ix1);
+    free(Iy1);
+  }
 
   o_cubx = platform.malloc(Nelements*cubNp*sizeof(dfloat), cubx);
   o_cuby = platform.malloc(Nelements*cubNp*sizeof(dfloat), cuby);
@@ -77,6 +81,7 @@ void meshQuad2D::CubatureNodes(){
   //Face cubature
   intx = (dfloat*) calloc(Nelements*Nfaces*cubNq, sizeof(dfloat));
   inty = (dfloat*) calloc(Nelements*Nfaces*cubNq, sizeof(dfloat));
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){
     for(int f=0;f<Nfaces;++f){
       for(int n=0;n<cubNq;++n){
@@ -361,15 +361,15 @@ void meshHex3D::CubatureSetup(){
 
 
   o_cubvgeo =
-    platform.malloc(Nelements*Nvgeo*cubNp*sizeof(dfloat),
+    MallocGeometricFactors(Nelements*Nvgeo*cubNp,
         cubvgeo);
 
   o_cubsgeo =
-    platform.malloc(Nelements*Nfaces*cubNq*cubNq*Nsgeo*sizeof(dfloat),
+    MallocGeometricFactors(Nelements*Nfaces*cubNq*cubNq*Nsgeo,
         cubsgeo);
 
   o_cubggeo =
-    platform.malloc(Nelements*Nggeo*cubNp*sizeof(dfloat),
+    MallocGeometricFactors(Nelements*Nggeo*cubNp,
         cubggeo);
 
   free(xre); free(xse); free(xte);
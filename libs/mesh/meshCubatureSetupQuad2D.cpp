@@ -239,9 +239,9 @@ void meshQuad2D::CubatureSetup(){
     }
   }
 
-  o_cubvgeo = platform.malloc(Nelements*Nvgeo*cubNp*sizeof(dfloat), cubvgeo);
-  o_cubggeo = platform.malloc(Nelements*Nggeo*cubNp*sizeof(dfloat), cubggeo);
-  o_cubsgeo = platform.malloc(Nelements*Nfaces*cubNq*Nsgeo*sizeof(dfloat), cubsgeo);
+  o_cubvgeo = MallocGeometricFactors(Nelements*Nvgeo*cubNp, cubvgeo);
+  o_cubggeo = MallocGeometricFactors(Nelements*Nggeo*cubNp, cubggeo);
+  o_cubsgeo = MallocGeometricFactors(Nelements*Nfaces*cubNq*Nsgeo, cubsgeo);
 
   free(xre); free(xse); free(yre); free(yse);
   free(xre1); free(xse1); free(yre1); free(yse1);
@@ -42,6 +42,7 @@ void meshHex3D::GeometricFactors(){
 
   // dfloat minJ = 1e9, maxJ = -1e9, maxSkew = 0;
 
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     for(int k=0;k<Nq;++k){
@@ -39,6 +39,7 @@ void meshQuad2D::GeometricFactors(){
   Nggeo = 4;
   ggeo = (dfloat*) calloc(Nelements*Nggeo*Np, sizeof(dfloat));
 
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
     for(int j=0;j<Nq;++j){
       for(int i=0;i<Nq;++i){
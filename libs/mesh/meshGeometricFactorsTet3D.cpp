@@ -39,6 +39,7 @@ void meshTet3D::GeometricFactors(){
 
 
   dfloat minJ = 1e9, maxJ = -1e9;
+  #pragma omp parallel for reduction(min:minJ) reduction(max:maxJ)
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     /* find vertex indices and physical coordinates */
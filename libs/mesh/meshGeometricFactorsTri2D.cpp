@@ -38,6 +38,7 @@ void meshTri2D::GeometricFactors(){
   ggeo = (dfloat*) calloc(Nelements*Nggeo, sizeof(dfloat));
 
 
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     /* find vertex indices and physical coordinates */
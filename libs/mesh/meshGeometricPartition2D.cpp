@@ -163,32 +163,33 @@ typedef struct {
 
 }element_t;
 
-// compare the Morton indices for two element capsules
-static int compareElements2D(const void *a, const void *b){
-
-  element_t *ea = (element_t*) a;
-  element_t *eb = (element_t*) b;
-
-  if(ea->index < eb->index) return -1;
-  if(ea->index > eb->index) return  1;
-
-  return 0;
-
-}
-
-// stub for the match function needed by parallelSort
-static void bogusMatch(void *a, void *b){ }
-
 // geometric partition of elements in 2D mesh using Morton ordering + parallelSort
 void mesh2D::GeometricPartition(){
 
-  dlong maxNelements;
-  MPI_Allreduce(&(Nelements), &maxNelements, 1, MPI_DLONG, MPI_MAX, comm);
-  maxNelements = 2*((maxNelements+1)/2);
-
-  // fix maxNelements
   element_t *elements
-    = (element_t*) calloc(maxNelements, sizeof(element_t));
+    = (element_t*) calloc(Nelements, sizeof(element_t));
+
+  // Make the MPI_ELEMENT_T data type
+  MPI_Datatype MPI_ELEMENT_T;
+  MPI_Datatype dtype[6] = {MPI_LONG_LONG_INT, MPI_DLONG, MPI_INT,
+                            MPI_HLONG, MPI_DFLOAT, MPI_DFLOAT};
+  int blength[6] = {1, 1, 1, 4, 4, 4};
+  MPI_Aint addr[6], displ[6];
+  element_t dummy;
+  MPI_Get_address ( &(dummy        ), addr+0);
+  MPI_Get_address ( &(dummy.element), addr+1);
+  MPI_Get_address ( &(dummy.type   ), addr+2);
+  MPI_Get_address ( &(dummy.v[0]   ), addr+3);
+  MPI_Get_address ( &(dummy.EX[0]  ), addr+4);
+  MPI_Get_address ( &(dummy.EY[0]  ), addr+5);
+  displ[0] = 0;
+  displ[1] = addr[1] - addr[0];
+  displ[2] = addr[2] - addr[0];
+  displ[3] = addr[3] - addr[0];
+  displ[4] = addr[4] - addr[0];
+  displ[5] = addr[5] - addr[0];
+  MPI_Type_create_struct (6, blength, displ, dtype, &MPI_ELEMENT_T);
+  MPI_Type_commit (&MPI_ELEMENT_T);
 
   // local bounding box of element centers
   dfloat mincx = 1e9, maxcx = -1e9;
@@ -257,33 +258,10 @@ void mesh2D::GeometricPartition(){
     elements[e].index = hilbert2D(Nboxes, ix, iy);
   }
 
-  // pad element array with dummy elements
-  for(dlong e=Nelements;e<maxNelements;++e){
-    elements[e].element = -1;
-
-    elements[e].index = hilbert2D(Nboxes, Nboxes-1, Nboxes-1);
-
-    //    elements[e].index = hilbert2D(Nboxes+1, Nboxes+1);
-    //    elements[e].index = mortonIndex2D(Nboxes+1, Nboxes+1);
-  }
-
-  // odd-even parallel sort of element capsules based on their Morton index
-  parallelSort(size, rank, comm,
-	       maxNelements, elements, sizeof(element_t),
-	       compareElements2D,
-	       bogusMatch);
-
-
-  // compress and renumber elements
-  dlong sk  = 0;
-  for(dlong e=0;e<maxNelements;++e){
-    if(elements[e].element != -1){
-      elements[sk] = elements[e];
-      ++sk;
-    }
-  }
-
-  dlong localNelements = sk;
+  // sample sort of element capsules based on their Morton index
+  dlong localNelements = Nelements;
+  parallelSort(comm, localNelements, elements, MPI_ELEMENT_T,
+               [](const element_t& e) { return e.index; });
 
   /// redistribute elements to improve balancing
   // TODO: We need a safer version of this for very large meshes.
@@ -308,27 +286,6 @@ void mesh2D::GeometricPartition(){
   int *sendOffsets = (int*) calloc(size, sizeof(int));
   int *recvOffsets = (int*) calloc(size, sizeof(int));
 
-  // Make the MPI_ELEMENT_T data type
-  MPI_Datatype MPI_ELEMENT_T;
-  MPI_Datatype dtype[6] = {MPI_LONG_LONG_INT, MPI_DLONG, MPI_INT,
-                            MPI_HLONG, MPI_DFLOAT, MPI_DFLOAT};
-  int blength[6] = {1, 1, 1, 4, 4, 4};
-  MPI_Aint addr[6], displ[6];
-  MPI_Get_address ( &(elements[0]        ), addr+0);
-  MPI_Get_address ( &(elements[0].element), addr+1);
-  MPI_Get_address ( &(elements[0].type   ), addr+2);
-  MPI_Get_address ( &(elements[0].v[0]   ), addr+3);
-  MPI_Get_address ( &(elements[0].EX[0]  ), addr+4);
-  MPI_Get_address ( &(elements[0].EY[0]  ), addr+5);
-  displ[0] = 0;
-  displ[1] = addr[1] - addr[0];
-  displ[2] = addr[2] - addr[0];
-  displ[3] = addr[3] - addr[0];
-  displ[4] = addr[4] - addr[0];
-  displ[5] = addr[5] - addr[0];
-  MPI_Type_create_struct (6, blength, displ, dtype, &MPI_ELEMENT_T);
-  MPI_Type_commit (&MPI_ELEMENT_T);
-
   for(dlong e=0;e<localNelements;++e){
 
     // global element index
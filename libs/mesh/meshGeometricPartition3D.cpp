@@ -76,33 +76,35 @@ typedef struct {
 
 }element_t;
 
-// compare the Morton indices for two element capsules
-static int compareElements(const void *a, const void *b){
-
-  element_t *ea = (element_t*) a;
-  element_t *eb = (element_t*) b;
-
-  if(ea->index < eb->index) return -1;
-  if(ea->index > eb->index) return  1;
-
-  return 0;
-
-}
-
-// stub for the match function needed by parallelSort
-static void bogusMatch3D(void *a, void *b){ }
-
-// geometric partition of elements in 3D mesh using Morton ordering + parallelSort
+// geometric partition of elements in 3D mesh using Morton (or Hilbert) ordering + parallelSort
 void mesh3D::GeometricPartition(){
 
-  dlong maxNelements;
-  MPI_Allreduce(&(Nelements), &maxNelements, 1, MPI_DLONG, MPI_MAX,
-		comm);
-  maxNelements = 2*((maxNelements+1)/2);
-
-  // fix maxNelements
   element_t *elements
-    = (element_t*) calloc(maxNelements, sizeof(element_t));
+    = (element_t*) calloc(Nelements, sizeof(element_t));
+
+  // Make the MPI_ELEMENT_T data type
+  MPI_Datatype MPI_ELEMENT_T;
+  MPI_Datatype dtype[7] = {MPI_LONG_LONG_INT, MPI_DLONG, MPI_INT,
+                            MPI_HLONG, MPI_DFLOAT, MPI_DFLOAT, MPI_DFLOAT};
+  int blength[7] = {1, 1, 1, 8, 8, 8, 8};
+  MPI_Aint addr[7], displ[7];
+  element_t dummy;
+  MPI_Get_address ( &(dummy        ), addr+0);
+  MPI_Get_address ( &(dummy.element), addr+1);
+  MPI_Get_address ( &(dummy.type   ), addr+2);
+  MPI_Get_address ( &(dummy.v[0]   ), addr+3);
+  MPI_Get_address ( &(dummy.EX[0]  ), addr+4);
+  MPI_Get_address ( &(dummy.EY[0]  ), addr+5);
+  MPI_Get_address ( &(dummy.EZ[0]  ), addr+6);
+  displ[0] = 0;
+  displ[1] = addr[1] - addr[0];
+  displ[2] = addr[2] - addr[0];
+  displ[3] = addr[3] - addr[0];
+  displ[4] = addr[4] - addr[0];
+  displ[5] = addr[5] - addr[0];
+  displ[6] = addr[6] - addr[0];
+  MPI_Type_create_struct (7, blength, displ, dtype, &MPI_ELEMENT_T);
+  MPI_Type_commit (&MPI_ELEMENT_T);
 
   // local bounding box of element centers
   dfloat minvx = 1e9, maxvx = -1e9;
@@ -149,6 +151,9 @@ void mesh3D::GeometricPartition(){
 
   dfloat maxlength = mymax(gmaxvx-gminvx, mymax(gmaxvy-gminvy, gmaxvz-gminvz));
 
+  // order along a Hilbert curve instead of the Morton curve
+  const bool hilbert = settings.compareSetting("MESH PARTITIONER","HILBERT");
+
   // compute Morton index for each element
   for(dlong e=0;e<Nelements;++e){
 
@@ -180,62 +185,16 @@ void mesh3D::GeometricPartition(){
     unsigned long long int iy = (cy-gminvy)*Nboxes/maxlength;
     unsigned long long int iz = (cz-gminvz)*Nboxes/maxlength;
 
-    elements[e].index = mortonIndex3D(ix, iy, iz, shiftx, shifty, shiftz);
-  }
-
-  // pad element array with dummy elements
-  for(dlong e=Nelements;e<maxNelements;++e){
-    elements[e].element = -1;
-    elements[e].index = mortonIndex3D(Nboxes+1, Nboxes+1, Nboxes+1, shiftx, shifty, shiftz);
-  }
-
-  // odd-even parallel sort of element capsules based on their Morton index
-  parallelSort(size, rank, comm,
-	       maxNelements, elements, sizeof(element_t),
-	       compareElements,
-	       bogusMatch3D);
-
-#if 0
-  // count number of elements that end up on this process
-  int cnt = 0;
-  for(int e=0;e<maxNelements;++e)
-    cnt += (elements[e].element != -1);
-
-  // reset number of elements and element-to-vertex connectivity from returned capsules
-  free(EToV);
-  free(EX);
-  free(EY);
-  free(EZ);
-
-  Nelements = cnt;
-  EToV = (int*) calloc(cnt*Nverts, sizeof(int));
-  EX = (dfloat*) calloc(cnt*Nverts, sizeof(dfloat));
-  EY = (dfloat*) calloc(cnt*Nverts, sizeof(dfloat));
-  EZ = (dfloat*) calloc(cnt*Nverts, sizeof(dfloat));
-
-  cnt = 0;
-  for(int e=0;e<maxNelements;++e){
-    if(elements[e].element != -1){
-      for(int n=0;n<Nverts;++n){
-	EToV[cnt*Nverts + n] = elements[e].v[n];
-	EX[cnt*Nverts + n]   = elements[e].EX[n];
-	EY[cnt*Nverts + n]   = elements[e].EY[n];
-	EZ[cnt*Nverts + n]   = elements[e].EZ[n];
-      }
-      ++cnt;
-    }
-  }
-#else
-  // compress and renumber elements
-  dlong sk  = 0;
-  for(dlong e=0;e<maxNelements;++e){
-    if(elements[e].element != -1){
-      elements[sk] = elements[e];
-      ++sk;
-    }
+    if (hilbert)
+      elements[e].index = HilbertIndex(3, bitRange, ix, iy, iz);
+    else
+      elements[e].index = mortonIndex3D(ix, iy, iz, shiftx, shifty, shiftz);
   }
 
-  dlong localNelements = sk;
+  // sample sort of element capsules based on their Morton index
+  dlong localNelements = Nelements;
+  parallelSort(comm, localNelements, elements, MPI_ELEMENT_T,
+               [](const element_t& e) { return e.index; });
 
   /// redistribute elements to improve balancing
   dlong *globalNelements = (dlong *) calloc(size,sizeof(dlong));
@@ -259,30 +218,6 @@ void mesh3D::GeometricPartition(){
   int *recvOffsets = (int*) calloc(size, sizeof(int));
 
 
-  // Make the MPI_ELEMENT_T data type
-  MPI_Datatype MPI_ELEMENT_T;
-  MPI_Datatype dtype[7] = {MPI_LONG_LONG_INT, MPI_DLONG, MPI_INT,
-                            MPI_HLONG, MPI_DFLOAT, MPI_DFLOAT, MPI_DFLOAT};
-  int blength[7] = {1, 1, 1, 8, 8, 8, 8};
-  MPI_Aint addr[7], displ[7];
-  MPI_Get_address ( &(elements[0]        ), addr+0);
-  MPI_Get_address ( &(elements[0].element), addr+1);
-  MPI_Get_address ( &(elements[0].type   ), addr+2);
-  MPI_Get_address ( &(elements[0].v[0]   ), addr+3);
-  MPI_Get_address ( &(elements[0].EX[0]  ), addr+4);
-  MPI_Get_address ( &(elements[0].EY[0]  ), addr+5);
-  MPI_Get_address ( &(elements[0].EZ[0]  ), addr+6);
-  displ[0] = 0;
-  displ[1] = addr[1] - addr[0];
-  displ[2] = addr[2] - addr[0];
-  displ[3] = addr[3] - addr[0];
-  displ[4] = addr[4] - addr[0];
-  displ[5] = addr[5] - addr[0];
-  displ[6] = addr[6] - addr[0];
-  MPI_Type_create_struct (7, blength, displ, dtype, &MPI_ELEMENT_T);
-  MPI_Type_commit (&MPI_ELEMENT_T);
-
-
   for(dlong e=0;e<localNelements;++e){
 
     // global element index
@@ -350,5 +285,4 @@ void mesh3D::GeometricPartition(){
     elementInfo[e] = elements[e].type;
   }
   if (elements) free(elements);
-#endif
 }
@@ -0,0 +1,1347 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include <vector>
+#include <queue>
+#include <random>
+#include <algorithm>
+#include <limits>
+
+/* ---------------------------------------------------------
+
+Multilevel k-way partitioning of the element dual graph.
+
+Vertices of the dual graph are elements, edges are shared faces.
+The graph stays distributed, each rank holding the rows of its
+own elements:
+
+  - coarsen by heavy-edge matching between elements of the same
+    rank until the global graph is small
+  - gather only the coarsest graph and split it into size parts
+    by recursive bisection, each bisection grown from a seed
+    element and refined with Fiduccia-Mattheyses passes
+  - project the partition back through the levels, applying
+    distributed greedy k-way boundary refinement on each level
+
+The partition of the coarsest graph is repeated identically on
+every rank. On the finer levels each rank moves its own elements,
+and the weight allowed into each part is shared between ranks.
+
+Element weights model heterogeneous element cost (PML,
+cubature, multirate level), edge weights count shared faces.
+An element may carry several weights (constraints), each of
+which is balanced over the parts separately, e.g. one per
+multirate level.
+
+------------------------------------------------------------ */
+
+// dual graph in compressed row storage. In a distributed graph each rank holds
+// the rows of its vertices, numbered from offset. Neighbors with index >= Nv
+// are ghosts, vertices of other ranks with global id ghostIds[n-Nv]
+typedef struct {
+
+  dlong Nv;
+  int Ncon;                  //number of weights per vertex
+
+  std::vector<dlong> xadj;   //offsets of each vertex's neighbors
+  std::vector<dlong> adj;    //neighbor vertices
+  std::vector<int>   adjw;   //edge weights
+
+  std::vector<dfloat> vw;    //Ncon weights of each vertex
+
+  std::vector<dlong> cmap;   //vertex in next coarser graph
+
+  hlong offset;                //global id of the first vertex
+  std::vector<hlong> ghostIds; //sorted global ids of the ghost vertices
+
+}partGraph_t;
+
+// exchange pattern filling the ghost entries of a distributed graph
+typedef struct {
+
+  std::vector<int> sendCounts, sendOffsets;
+  std::vector<int> recvCounts, recvOffsets;
+
+  std::vector<dlong> sendIds; //local vertices requested by other ranks
+
+}partHalo_t;
+
+// capsule for element vertices, vertex coordinates, and face connectivity
+typedef struct {
+
+  hlong type;
+
+  // 8 for maximum number of vertices per element
+  hlong v[8];
+
+  dfloat EX[8], EY[8], EZ[8];
+
+  // 6 for maximum number of faces per element
+  dlong EToE[6];
+  int EToF[6], EToP[6];
+
+}partElement_t;
+
+static const dfloat partTol = 0.03;
+
+static std::vector<dfloat> totalWeight(const partGraph_t& g){
+  std::vector<dfloat> W(g.Ncon, 0.0);
+  for(dlong v=0;v<g.Nv;++v)
+    for(int c=0;c<g.Ncon;++c) W[c] += g.vw[v*g.Ncon+c];
+  return W;
+}
+
+static hlong edgeCut(const partGraph_t& g, const std::vector<int>& part){
+  hlong cut = 0;
+  for(dlong v=0;v<g.Nv;++v)
+    for(dlong j=g.xadj[v];j<g.xadj[v+1];++j)
+      if(part[g.adj[j]]!=part[v]) cut += g.adjw[j];
+  return cut/2;
+}
+
+// find the owners of the ghost vertices and ask them which vertices to send
+static void setupHalo(MPI_Comm comm, const partGraph_t& g, partHalo_t& halo){
+
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  std::vector<hlong> starts(size);
+  hlong offset = g.offset;
+  MPI_Allgather(&offset, 1, MPI_HLONG, starts.data(), 1, MPI_HLONG, comm);
+
+  // ghostIds are sorted, so they are grouped by owner
+  halo.recvCounts.assign(size, 0);
+  for(size_t n=0;n<g.ghostIds.size();++n){
+    const int r = std::upper_bound(starts.begin(), starts.end(), g.ghostIds[n])
+                  - starts.begin() - 1;
+    halo.recvCounts[r]++;
+  }
+
+  halo.sendCounts.assign(size, 0);
+  MPI_Alltoall(halo.recvCounts.data(), 1, MPI_INT,
+               halo.sendCounts.data(), 1, MPI_INT, comm);
+
+  halo.sendOffsets.assign(size+1, 0);
+  halo.recvOffsets.assign(size+1, 0);
+  for(int r=0;r<size;++r){
+    halo.sendOffsets[r+1] = halo.sendOffsets[r] + halo.sendCounts[r];
+    halo.recvOffsets[r+1] = halo.recvOffsets[r] + halo.recvCounts[r];
+  }
+
+  std::vector<hlong> requests(halo.sendOffsets[size]+1);
+  MPI_Alltoallv(g.ghostIds.data(), halo.recvCounts.data(), halo.recvOffsets.data(), MPI_HLONG,
+                requests.data(), halo.sendCounts.data(), halo.sendOffsets.data(), MPI_HLONG, comm);
+
+  halo.sendIds.resize(halo.sendOffsets[size]);
+  for(int n=0;n<halo.sendOffsets[size];++n)
+    halo.sendIds[n] = (dlong) (requests[n]-g.offset);
+}
+
+// copy the values of the ghost vertices from their owners
+template<typename T>
+static void exchangeHalo(MPI_Comm comm, const partHalo_t& halo, MPI_Datatype type,
+                         const T* local, T* ghost){
+
+  std::vector<T> sendBuf(halo.sendIds.size()+1);
+  for(size_t n=0;n<halo.sendIds.size();++n)
+    sendBuf[n] = local[halo.sendIds[n]];
+
+  MPI_Alltoallv(sendBuf.data(), halo.sendCounts.data(), halo.sendOffsets.data(), type,
+                ghost, halo.recvCounts.data(), halo.recvOffsets.data(), type, comm);
+}
+
+// heavy-edge matching between vertices of the same rank, builds the
+// distributed coarse graph and sets g.cmap
+static void coarsenGraph(MPI_Comm comm, partGraph_t& g, partGraph_t& gc,
+                         const std::vector<dfloat>& maxVw, std::mt19937& rng){
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  const dlong Nv = g.Nv;
+  const int Ncon = g.Ncon;
+  const dlong Nghost = g.ghostIds.size();
+
+  std::vector<dlong> perm(Nv);
+  for(dlong v=0;v<Nv;++v) perm[v] = v;
+  std::shuffle(perm.begin(), perm.end(), rng);
+
+  // match each vertex with its unmatched local neighbor across the heaviest edge
+  std::vector<dlong> match(Nv, -1);
+  for(dlong i=0;i<Nv;++i){
+    const dlong u = perm[i];
+    if(match[u]!=-1) continue;
+
+    dlong best = u;
+    int bestw = -1;
+    for(dlong j=g.xadj[u];j<g.xadj[u+1];++j){
+      const dlong v = g.adj[j];
+      if(v==u || v>=Nv || match[v]!=-1 || g.adjw[j]<=bestw) continue;
+
+      bool fits = true;
+      for(int c=0;c<Ncon;++c)
+        fits = fits && (g.vw[u*Ncon+c]+g.vw[v*Ncon+c]<=maxVw[c]);
+      if(fits){
+        best = v;
+        bestw = g.adjw[j];
+      }
+    }
+    match[u] = best;
+    match[best] = u;
+  }
+
+  // number the coarse vertices
+  g.cmap.assign(Nv, -1);
+  dlong Nc = 0;
+  for(dlong u=0;u<Nv;++u){
+    if(g.cmap[u]==-1){
+      g.cmap[u] = Nc;
+      g.cmap[match[u]] = Nc;
+      Nc++;
+    }
+  }
+
+  // coarse vertices are numbered consecutively over the ranks
+  hlong NcLocal = Nc;
+  gc.offset = 0;
+  MPI_Exscan(&NcLocal, &(gc.offset), 1, MPI_HLONG, MPI_SUM, comm);
+  if(rank==0) gc.offset = 0;
+
+  // global coarse ids of the ghosts, from their owners
+  std::vector<hlong> globalCmap(Nv+1);
+  for(dlong v=0;v<Nv;++v) globalCmap[v] = gc.offset + g.cmap[v];
+
+  partHalo_t halo;
+  setupHalo(comm, g, halo);
+  std::vector<hlong> ghostCmap(Nghost+1);
+  exchangeHalo(comm, halo, MPI_HLONG, globalCmap.data(), ghostCmap.data());
+
+  gc.ghostIds.assign(ghostCmap.begin(), ghostCmap.begin()+Nghost);
+  std::sort(gc.ghostIds.begin(), gc.ghostIds.end());
+  gc.ghostIds.erase(std::unique(gc.ghostIds.begin(), gc.ghostIds.end()),
+                    gc.ghostIds.end());
+
+  // coarse index of every fine vertex, local and ghost
+  std::vector<dlong> coarseId(Nv+Nghost);
+  for(dlong v=0;v<Nv;++v) coarseId[v] = g.cmap[v];
+  for(dlong n=0;n<Nghost;++n)
+    coarseId[Nv+n] = Nc + (dlong) (std::lower_bound(gc.ghostIds.begin(), gc.ghostIds.end(),
+                                                    ghostCmap[n]) - gc.ghostIds.begin());
+
+  // merge the adjacency of matched pairs, dropping the collapsed edges
+  gc.Nv = Nc;
+  gc.Ncon = Ncon;
+  gc.xadj.assign(Nc+1, 0);
+  gc.vw.assign(Nc*Ncon, 0.0);
+  gc.adj.clear();
+  gc.adjw.clear();
+  gc.cmap.clear();
+
+  std::vector<dlong> pos(Nc+gc.ghostIds.size(), -1);
+  for(dlong u=0;u<Nv;++u){
+    const dlong v = match[u];
+    if(v<u) continue; //pair already merged
+
+    const dlong c = g.cmap[u];
+    const dlong start = gc.adj.size();
+    gc.xadj[c] = start;
+
+    const dlong members[2] = {u, v};
+    const int Nmembers = (u==v) ? 1 : 2;
+    for(int m=0;m<Nmembers;++m){
+      const dlong w = members[m];
+      for(int n=0;n<Ncon;++n) gc.vw[c*Ncon+n] += g.vw[w*Ncon+n];
+      for(dlong j=g.xadj[w];j<g.xadj[w+1];++j){
+        const dlong cn = coarseId[g.adj[j]];
+        if(cn==c) continue;
+        if(pos[cn]>=start){
+          gc.adjw[pos[cn]] += g.adjw[j];
+        } else {
+          pos[cn] = gc.adj.size();
+          gc.adj.push_back(cn);
+          gc.adjw.push_back(g.adjw[j]);
+        }
+      }
+    }
+  }
+  gc.xadj[Nc] = gc.adj.size();
+}
+
+// induced subgraph of the vertices with side[v]==s
+static void extractSubgraph(const partGraph_t& g, const std::vector<int>& side,
+                            const int s, partGraph_t& sub, std::vector<dlong>& ids){
+
+  std::vector<dlong> newId(g.Nv, -1);
+  ids.clear();
+  for(dlong v=0;v<g.Nv;++v){
+    if(side[v]==s){
+      newId[v] = ids.size();
+      ids.push_back(v);
+    }
+  }
+
+  sub.Nv = ids.size();
+  sub.Ncon = g.Ncon;
+  sub.xadj.assign(sub.Nv+1, 0);
+  sub.vw.assign(sub.Nv*g.Ncon, 0.0);
+  sub.adj.clear();
+  sub.adjw.clear();
+  sub.cmap.clear();
+
+  for(dlong i=0;i<sub.Nv;++i){
+    const dlong v = ids[i];
+    sub.xadj[i] = sub.adj.size();
+    for(int c=0;c<g.Ncon;++c) sub.vw[i*g.Ncon+c] = g.vw[v*g.Ncon+c];
+    for(dlong j=g.xadj[v];j<g.xadj[v+1];++j){
+      const dlong u = g.adj[j];
+      if(newId[u]!=-1){
+        sub.adj.push_back(newId[u]);
+        sub.adjw.push_back(g.adjw[j]);
+      }
+    }
+  }
+  sub.xadj[sub.Nv] = sub.adj.size();
+}
+
+// imbalance of a bisection, the largest deviation of side 0 from its target
+// over the constraints in units of the tolerance. At most 1 is feasible
+static dfloat bisectionImbalance(const std::vector<dfloat>& w0,
+                                 const std::vector<dfloat>& target0,
+                                 const std::vector<dfloat>& tolW){
+  dfloat imb = 0.0;
+  for(size_t c=0;c<w0.size();++c)
+    if(tolW[c]>0.0) imb = mymax(imb, (dfloat) fabs(w0[c]-target0[c])/tolW[c]);
+  return imb;
+}
+
+// Fiduccia-Mattheyses refinement of a bisection, side 0 should carry target0 of
+// the weight of each constraint
+static void refineBisection(const partGraph_t& g, std::vector<int>& side,
+                            const std::vector<dfloat>& target0,
+                            const std::vector<dfloat>& tolW){
+
+  const dlong Nv = g.Nv;
+  const int Ncon = g.Ncon;
+  const int maxPasses = 8;
+  const dlong maxStall = mymax(50, Nv/100);
+
+  std::vector<dfloat> w0(Ncon, 0.0), trialW0(Ncon);
+  for(dlong v=0;v<Nv;++v)
+    if(side[v]==0)
+      for(int c=0;c<Ncon;++c) w0[c] += g.vw[v*Ncon+c];
+
+  // side 0 weight after moving v off side s
+  auto moved = [&](const dlong v, const int s, std::vector<dfloat>& w){
+    for(int c=0;c<Ncon;++c)
+      w[c] = w0[c] + ((s==0) ? -g.vw[v*Ncon+c] : g.vw[v*Ncon+c]);
+  };
+
+  std::vector<int> gain(Nv);
+  std::vector<char> locked(Nv);
+  std::vector<dlong> moves;
+
+  typedef std::pair<int,dlong> entry_t;
+  // with several constraints the best gain often sits on a constraint that
+  // is already full, so look a few entries further down the queue
+  const int maxSkip = (Ncon>1) ? 32 : 1;
+  std::vector<entry_t> skipped[2];
+
+  for(int pass=0;pass<maxPasses;++pass){
+
+    // gain of moving each vertex = external - internal edge weight
+    hlong cut = 0;
+    std::priority_queue<entry_t> queue[2];
+    for(dlong v=0;v<Nv;++v){
+      int ext = 0, in = 0;
+      for(dlong j=g.xadj[v];j<g.xadj[v+1];++j){
+        if(side[g.adj[j]]==side[v]) in += g.adjw[j];
+        else                        ext += g.adjw[j];
+      }
+      gain[v] = ext - in;
+      locked[v] = 0;
+      cut += ext;
+      if(ext>0) queue[side[v]].push(entry_t(gain[v], v));
+    }
+    cut /= 2;
+
+    hlong bestCut = cut;
+    dfloat imb = bisectionImbalance(w0, target0, tolW);
+    dfloat bestImb = imb;
+    bool bestFeasible = (bestImb<=1.0);
+    size_t bestMoves = 0;
+    dlong stall = 0;
+    moves.clear();
+
+    while(stall<maxStall){
+
+      // best candidate move of each side that keeps the balance or improves
+      // it. Entries which would unbalance a constraint are set aside
+      bool valid[2] = {false, false};
+      for(int s=0;s<2;++s){
+        skipped[s].clear();
+        while(!queue[s].empty() && (int)skipped[s].size()<maxSkip){
+          const entry_t top = queue[s].top();
+          if(locked[top.second] || side[top.second]!=s || gain[top.second]!=top.first){
+            queue[s].pop(); //stale
+            continue;
+          }
+          moved(top.second, s, trialW0);
+          const dfloat trialImb = bisectionImbalance(trialW0, target0, tolW);
+          if((trialImb<=1.0) || (trialImb<imb)){
+            valid[s] = true;
+            break;
+          }
+          skipped[s].push_back(top);
+          queue[s].pop();
+        }
+      }
+
+      if(!valid[0] && !valid[1]) break;
+
+      int s;
+      if(valid[0] && valid[1])
+        s = (queue[0].top().first >= queue[1].top().first) ? 0 : 1;
+      else
+        s = valid[0] ? 0 : 1;
+
+      const dlong v = queue[s].top().second;
+      queue[s].pop();
+
+      for(int r=0;r<2;++r)
+        for(size_t n=0;n<skipped[r].size();++n) queue[r].push(skipped[r][n]);
+
+      // move v to the other side
+      side[v] = 1-s;
+      locked[v] = 1;
+      cut -= gain[v];
+      moved(v, s, w0);
+      moves.push_back(v);
+
+      for(dlong j=g.xadj[v];j<g.xadj[v+1];++j){
+        const dlong u = g.adj[j];
+        if(locked[u]) continue;
+        gain[u] += (side[u]==side[v]) ? -2*g.adjw[j] : 2*g.adjw[j];
+        queue[side[u]].push(entry_t(gain[u], u));
+      }
+
+      imb = bisectionImbalance(w0, target0, tolW);
+      const bool feasible = (imb<=1.0);
+      if((feasible && (!bestFeasible || cut<bestCut))
+         || (!bestFeasible && imb<bestImb)){
+        bestCut = cut;
+        bestImb = imb;
+        bestFeasible = feasible;
+        bestMoves = moves.size();
+        stall = 0;
+      } else {
+        stall++;
+      }
+    }
+
+    // roll back the moves made after the best point
+    for(size_t m=moves.size();m>bestMoves;--m){
+      const dlong v = moves[m-1];
+      moved(v, side[v], w0);
+      side[v] = 1-side[v];
+    }
+
+    if(bestMoves==0) break;
+  }
+}
+
+// split g in two, side 0 carrying fraction frac0 of the weight of each constraint
+static void bisectGraph(const partGraph_t& g, const dfloat frac0,
+                        std::vector<int>& side, std::mt19937& rng){
+
+  const dlong Nv = g.Nv;
+  const int Ncon = g.Ncon;
+  const int Ntries = 4;
+
+  const std::vector<dfloat> W = totalWeight(g);
+
+  std::vector<dfloat> target0(Ncon), tolW(Ncon), maxVw(Ncon, 0.0);
+  for(dlong v=0;v<Nv;++v)
+    for(int c=0;c<Ncon;++c) maxVw[c] = mymax(maxVw[c], g.vw[v*Ncon+c]);
+  for(int c=0;c<Ncon;++c){
+    target0[c] = frac0*W[c];
+    tolW[c] = partTol*W[c] + maxVw[c];
+  }
+
+  hlong bestCut = -1;
+  bool bestFeasible = false;
+  std::vector<int> trial(Nv);
+  std::vector<dlong> queue;
+  queue.reserve(Nv);
+
+  std::uniform_int_distribution<dlong> seedDist(0, Nv-1);
+
+  for(int t=0;t<Ntries;++t){
+
+    // grow side 0 breadth-first from a random seed element, taking only
+    // elements whose constraints are all still below their targets
+    std::fill(trial.begin(), trial.end(), 1);
+    queue.clear();
+
+    std::vector<dfloat> w0(Ncon, 0.0);
+    auto wanted = [&](const dlong u) -> bool {
+      for(int c=0;c<Ncon;++c)
+        if(g.vw[u*Ncon+c]>0.0 && w0[c]>=target0[c]) return false;
+      return true;
+    };
+    auto full = [&]() -> bool {
+      for(int c=0;c<Ncon;++c)
+        if(w0[c]<target0[c]) return false;
+      return true;
+    };
+    auto take = [&](const dlong u) {
+      trial[u] = 0;
+      for(int c=0;c<Ncon;++c) w0[c] += g.vw[u*Ncon+c];
+      queue.push_back(u);
+    };
+
+    dlong head = 0;
+    dlong next = seedDist(rng);
+    while(!full()){
+      if(head==(dlong)queue.size()){
+        // disconnected graph or first seed, start a new region
+        dlong Nscanned = 0;
+        while(Nscanned<Nv && (trial[next]==0 || !wanted(next))){
+          next = (next+1)%Nv;
+          Nscanned++;
+        }
+        if(Nscanned==Nv) break;
+        take(next);
+        continue;
+      }
+      const dlong v = queue[head++];
+      for(dlong j=g.xadj[v];j<g.xadj[v+1] && !full();++j){
+        const dlong u = g.adj[j];
+        if(trial[u]==1 && wanted(u)) take(u);
+      }
+    }
+
+    refineBisection(g, trial, target0, tolW);
+
+    // keep the best cut among the balanced trials
+    std::vector<dfloat> trialW0(Ncon, 0.0);
+    for(dlong v=0;v<Nv;++v)
+      if(trial[v]==0)
+        for(int c=0;c<Ncon;++c) trialW0[c] += g.vw[v*Ncon+c];
+    const bool feasible = (bisectionImbalance(trialW0, target0, tolW)<=1.0);
+
+    const hlong cut = edgeCut(g, trial);
+    if(bestCut<0 || (feasible && !bestFeasible)
+       || (feasible==bestFeasible && cut<bestCut)){
+      bestCut = cut;
+      bestFeasible = feasible;
+      side = trial;
+    }
+  }
+}
+
+static void recursiveBisection(const partGraph_t& g, const int Nparts, const int partOffset,
+                               std::vector<int>& part, std::mt19937& rng){
+
+  part.assign(g.Nv, partOffset);
+  if(Nparts==1 || g.Nv==0) return;
+
+  const int Nparts0 = Nparts/2;
+
+  std::vector<int> side(g.Nv, 0);
+  bisectGraph(g, Nparts0/(dfloat)Nparts, side, rng);
+
+  partGraph_t sub;
+  std::vector<dlong> ids;
+  std::vector<int> subPart;
+  for(int s=0;s<2;++s){
+    extractSubgraph(g, side, s, sub, ids);
+
+    if(s==0) recursiveBisection(sub, Nparts0, partOffset, subPart, rng);
+    else     recursiveBisection(sub, Nparts-Nparts0, partOffset+Nparts0, subPart, rng);
+
+    for(dlong i=0;i<sub.Nv;++i) part[ids[i]] = subPart[i];
+  }
+}
+
+// balance test of a move of v from part p to part q, given the weight pw of
+// each part and constraint. Only the constraints v carries are considered
+typedef struct {
+  bool fits;      //q stays below maxPartW
+  bool lighter;   //q is less loaded after the move than p before it
+  bool overfull;  //p is above maxPartW
+}partMove_t;
+
+static partMove_t checkMove(const partGraph_t& g, const dlong v, const int p, const int q,
+                            const std::vector<dfloat>& pw,
+                            const std::vector<dfloat>& maxPartW){
+  const int Ncon = g.Ncon;
+  partMove_t m = {true, false, false};
+  dfloat loadP = 0.0, loadQ = 0.0;
+  for(int c=0;c<Ncon;++c){
+    const dfloat w = g.vw[v*Ncon+c];
+    if(w<=0.0) continue;
+    m.fits     = m.fits && (pw[q*Ncon+c]+w <= maxPartW[c]);
+    m.overfull = m.overfull || (pw[p*Ncon+c] > maxPartW[c]);
+    loadP = mymax(loadP, pw[p*Ncon+c]/maxPartW[c]);
+    loadQ = mymax(loadQ, (pw[q*Ncon+c]+w)/maxPartW[c]);
+  }
+  m.lighter = (loadQ < loadP);
+  return m;
+}
+
+// greedy boundary refinement, moves vertices to the neighboring part with the best gain
+static void refineKway(const partGraph_t& g, std::vector<int>& part,
+                       const int Nparts, std::mt19937& rng){
+
+  const dlong Nv = g.Nv;
+  const int Ncon = g.Ncon;
+  const int maxPasses = 8;
+
+  const std::vector<dfloat> W = totalWeight(g);
+  std::vector<dfloat> maxPartW(Ncon);
+  for(int c=0;c<Ncon;++c) maxPartW[c] = (1.0+partTol)*W[c]/Nparts;
+
+  std::vector<dfloat> pw(Nparts*Ncon, 0.0);
+  std::vector<dlong>  pcount(Nparts, 0);
+  for(dlong v=0;v<Nv;++v){
+    for(int c=0;c<Ncon;++c) pw[part[v]*Ncon+c] += g.vw[v*Ncon+c];
+    pcount[part[v]]++;
+  }
+
+  std::vector<dlong> perm(Nv);
+  for(dlong v=0;v<Nv;++v) perm[v] = v;
+
+  std::vector<int> conn(Nparts, 0);
+  std::vector<int> touched;
+
+  for(int pass=0;pass<maxPasses;++pass){
+    std::shuffle(perm.begin(), perm.end(), rng);
+
+    dlong Nmoved = 0;
+    for(dlong i=0;i<Nv;++i){
+      const dlong v = perm[i];
+      const int p = part[v];
+
+      // connectivity of v to each neighboring part
+      touched.clear();
+      for(dlong j=g.xadj[v];j<g.xadj[v+1];++j){
+        const int q = part[g.adj[j]];
+        if(conn[q]==0) touched.push_back(q);
+        conn[q] += g.adjw[j];
+      }
+      const int internal = conn[p];
+
+      int best = -1, bestGain = 0;
+      for(size_t n=0;n<touched.size();++n){
+        const int q = touched[n];
+        if(q==p) continue;
+
+        const partMove_t m = checkMove(g, v, p, q, pw, maxPartW);
+        if(!m.fits) continue;
+
+        const int gain = conn[q]-internal;
+        const bool improves = (gain>0)
+                           || (gain==0 && m.lighter)
+                           || (m.overfull && m.lighter);
+        if(improves && (best==-1 || gain>bestGain)){
+          best = q;
+          bestGain = gain;
+        }
+      }
+
+      for(size_t n=0;n<touched.size();++n) conn[touched[n]] = 0;
+
+      if(best!=-1 && pcount[p]>1){
+        part[v] = best;
+        for(int c=0;c<Ncon;++c){
+          pw[p*Ncon+c]    -= g.vw[v*Ncon+c];
+          pw[best*Ncon+c] += g.vw[v*Ncon+c];
+        }
+        pcount[p]--;
+        pcount[best]++;
+        Nmoved++;
+      }
+    }
+
+    if(Nmoved==0) break;
+  }
+}
+
+// distributed greedy boundary refinement into one part per rank. Each rank
+// proposes moves for its own vertices. The weight proposed into each part is
+// summed over the ranks, and when it would overfill the part every rank only
+// takes its share of the room, best gains first. Moves alternate between higher
+// and lower numbered parts so two neighboring parts never swap vertices at once.
+static void refineKwayParallel(MPI_Comm comm, const partGraph_t& g,
+                               std::vector<int>& part){
+
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  const dlong Nv = g.Nv;
+  const int Ncon = g.Ncon;
+  const int Nparts = size;
+  const int maxPasses = 8;
+
+  const std::vector<dfloat> localW = totalWeight(g);
+  std::vector<dfloat> W(Ncon), maxPartW(Ncon);
+  MPI_Allreduce(localW.data(), W.data(), Ncon, MPI_DFLOAT, MPI_SUM, comm);
+  for(int c=0;c<Ncon;++c) maxPartW[c] = (1.0+partTol)*W[c]/Nparts;
+
+  partHalo_t halo;
+  setupHalo(comm, g, halo);
+
+  // parts of the local vertices followed by the ghosts
+  part.resize(Nv+g.ghostIds.size()+1);
+
+  std::vector<dfloat> pw(Nparts*Ncon), localPw(Nparts*Ncon);
+  std::vector<hlong>  pcount(Nparts), localPcount(Nparts);
+  std::vector<dfloat> inW(Nparts*Ncon), totalInW(Nparts*Ncon), acceptW(Nparts*Ncon);
+  std::vector<hlong>  outCount(Nparts), totalOutCount(Nparts);
+
+  std::vector<int> conn(Nparts, 0);
+  std::vector<int> touched;
+
+  // proposed moves as (gain, vertex, part)
+  typedef std::pair<int, std::pair<dlong,int> > move_t;
+  std::vector<move_t> moves;
+
+  for(int pass=0;pass<maxPasses;++pass){
+
+    hlong Nmoved = 0;
+    for(int dir=0;dir<2;++dir){
+
+      exchangeHalo(comm, halo, MPI_INT, part.data(), part.data()+Nv);
+
+      std::fill(localPw.begin(), localPw.end(), 0.0);
+      std::fill(localPcount.begin(), localPcount.end(), 0);
+      for(dlong v=0;v<Nv;++v){
+        for(int c=0;c<Ncon;++c) localPw[part[v]*Ncon+c] += g.vw[v*Ncon+c];
+        localPcount[part[v]]++;
+      }
+      MPI_Allreduce(localPw.data(), pw.data(), Nparts*Ncon, MPI_DFLOAT, MPI_SUM, comm);
+      MPI_Allreduce(localPcount.data(), pcount.data(), Nparts, MPI_HLONG, MPI_SUM, comm);
+
+      moves.clear();
+      std::fill(inW.begin(), inW.end(), 0.0);
+      std::fill(outCount.begin(), outCount.end(), 0);
+      for(dlong v=0;v<Nv;++v){
+        const int p = part[v];
+
+        // connectivity of v to each neighboring part
+        touched.clear();
+        for(dlong j=g.xadj[v];j<g.xadj[v+1];++j){
+          const int q = part[g.adj[j]];
+          if(conn[q]==0) touched.push_back(q);
+          conn[q] += g.adjw[j];
+        }
+        const int internal = conn[p];
+
+        int best = -1, bestGain = 0;
+        for(size_t n=0;n<touched.size();++n){
+          const int q = touched[n];
+          if(q==p || (dir==0 && q<p) || (dir==1 && q>p)) continue;
+
+          const partMove_t m = checkMove(g, v, p, q, pw, maxPartW);
+          if(!m.fits) continue;
+
+          const int gain = conn[q]-internal;
+          const bool improves = (gain>0)
+                             || (gain==0 && m.lighter)
+                             || (m.overfull && m.lighter);
+          if(improves && (best==-1 || gain>bestGain)){
+            best = q;
+            bestGain = gain;
+          }
+        }
+
+        for(size_t n=0;n<touched.size();++n) conn[touched[n]] = 0;
+
+        if(best!=-1){
+          moves.push_back(move_t(bestGain, std::make_pair(v, best)));
+          for(int c=0;c<Ncon;++c) inW[best*Ncon+c] += g.vw[v*Ncon+c];
+          outCount[p]++;
+        }
+      }
+
+      // share the room left in each part between the ranks proposing moves into it
+      MPI_Allreduce(inW.data(), totalInW.data(), Nparts*Ncon, MPI_DFLOAT, MPI_SUM, comm);
+      MPI_Allreduce(outCount.data(), totalOutCount.data(), Nparts, MPI_HLONG, MPI_SUM, comm);
+      for(int q=0;q<Nparts;++q){
+        for(int c=0;c<Ncon;++c){
+          const int id = q*Ncon+c;
+          const dfloat room = mymax(maxPartW[c]-pw[id], (dfloat)0.0);
+          acceptW[id] = (totalInW[id]<=room) ? std::numeric_limits<dfloat>::max()
+                                             : room*inW[id]/totalInW[id];
+        }
+      }
+
+      std::stable_sort(moves.begin(), moves.end(),
+                       [](const move_t& a, const move_t& b) { return a.first > b.first; });
+
+      for(size_t n=0;n<moves.size();++n){
+        const dlong v = moves[n].second.first;
+        const int   q = moves[n].second.second;
+        const int   p = part[v];
+
+        // never empty a part
+        if(pcount[p]-totalOutCount[p]<1) continue;
+
+        bool fits = true;
+        for(int c=0;c<Ncon;++c)
+          fits = fits && (g.vw[v*Ncon+c] <= acceptW[q*Ncon+c]);
+        if(!fits) continue;
+
+        part[v] = q;
+        for(int c=0;c<Ncon;++c) acceptW[q*Ncon+c] -= g.vw[v*Ncon+c];
+        Nmoved++;
+      }
+    }
+
+    hlong NmovedGlobal = 0;
+    MPI_Allreduce(&Nmoved, &NmovedGlobal, 1, MPI_HLONG, MPI_SUM, comm);
+    if(NmovedGlobal==0) break;
+  }
+
+  part.resize(Nv);
+}
+
+// gather a small distributed graph on every rank, with global vertex numbering
+static void gatherGraph(MPI_Comm comm, const partGraph_t& g, partGraph_t& gAll){
+
+  int size;
+  MPI_Comm_size(comm, &size);
+
+  hlong NvLocal = g.Nv, NadjLocal = g.xadj[g.Nv];
+  hlong NvGlobal = 0, NadjGlobal = 0;
+  MPI_Allreduce(&NvLocal, &NvGlobal, 1, MPI_HLONG, MPI_SUM, comm);
+  MPI_Allreduce(&NadjLocal, &NadjGlobal, 1, MPI_HLONG, MPI_SUM, comm);
+
+  if (NvGlobal>std::numeric_limits<int>::max()
+      || NadjGlobal>std::numeric_limits<int>::max()) {
+    std::stringstream ss;
+    ss << "Coarsest partition graph with " << NvGlobal << " vertices and "
+       << NadjGlobal << " edges is too large to gather";
+    LIBP_ABORT(ss.str());
+  }
+
+  std::vector<int> counts(size), offsets(size+1, 0);
+  std::vector<int> adjCounts(size), adjOffsets(size+1, 0);
+  std::vector<int> vwCounts(size), vwOffsets(size, 0);
+  int Nv = (int) g.Nv, Nadj = (int) g.xadj[g.Nv];
+  MPI_Allgather(&Nv,   1, MPI_INT, counts.data(),    1, MPI_INT, comm);
+  MPI_Allgather(&Nadj, 1, MPI_INT, adjCounts.data(), 1, MPI_INT, comm);
+  for(int r=0;r<size;++r){
+    offsets[r+1]    = offsets[r]    + counts[r];
+    adjOffsets[r+1] = adjOffsets[r] + adjCounts[r];
+    vwCounts[r]  = counts[r]*g.Ncon;
+    vwOffsets[r] = offsets[r]*g.Ncon;
+  }
+
+  std::vector<dlong> degree(Nv+1);
+  std::vector<hlong> adj(Nadj+1);
+  for(dlong v=0;v<g.Nv;++v){
+    degree[v] = g.xadj[v+1]-g.xadj[v];
+    for(dlong j=g.xadj[v];j<g.xadj[v+1];++j){
+      const dlong u = g.adj[j];
+      adj[j] = (u<g.Nv) ? g.offset+u : g.ghostIds[u-g.Nv];
+    }
+  }
+
+  gAll.Nv = (dlong) NvGlobal;
+  gAll.Ncon = g.Ncon;
+  gAll.offset = 0;
+  gAll.ghostIds.clear();
+  gAll.cmap.clear();
+
+  std::vector<dlong> gDegree(gAll.Nv+1);
+  std::vector<hlong> gAdj(NadjGlobal+1);
+  gAll.vw.resize(gAll.Nv*gAll.Ncon+1);
+  gAll.adjw.resize(NadjGlobal+1);
+
+  MPI_Allgatherv(degree.data(), Nv, MPI_DLONG,
+                 gDegree.data(), counts.data(), offsets.data(), MPI_DLONG, comm);
+  MPI_Allgatherv(g.vw.data(), Nv*g.Ncon, MPI_DFLOAT,
+                 gAll.vw.data(), vwCounts.data(), vwOffsets.data(), MPI_DFLOAT, comm);
+  MPI_Allgatherv(adj.data(), Nadj, MPI_HLONG,
+                 gAdj.data(), adjCounts.data(), adjOffsets.data(), MPI_HLONG, comm);
+  MPI_Allgatherv(g.adjw.data(), Nadj, MPI_INT,
+                 gAll.adjw.data(), adjCounts.data(), adjOffsets.data(), MPI_INT, comm);
+
+  gAll.vw.resize(gAll.Nv*gAll.Ncon);
+  gAll.adjw.resize(NadjGlobal);
+  gAll.xadj.assign(gAll.Nv+1, 0);
+  for(dlong v=0;v<gAll.Nv;++v)
+    gAll.xadj[v+1] = gAll.xadj[v] + gDegree[v];
+  gAll.adj.resize(NadjGlobal);
+  for(hlong j=0;j<NadjGlobal;++j)
+    gAll.adj[j] = (dlong) gAdj[j];
+}
+
+static void multilevelPartition(MPI_Comm comm, partGraph_t& g, const int Nparts,
+                                std::vector<int>& part){
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  // local matching differs per rank, the coarsest partition is replicated
+  std::mt19937 rng(12345+rank);
+  std::mt19937 rngAll(12345);
+
+  const dlong coarsenTo = mymax(20*Nparts, 100);
+
+  // cap the coarse vertex weight of each constraint, but let a constraint
+  // carried by few vertices still be matched
+  const std::vector<dfloat> localW = totalWeight(g);
+  std::vector<dfloat> W(g.Ncon), localMaxVw(g.Ncon, 0.0), maxVw(g.Ncon);
+  for(dlong v=0;v<g.Nv;++v)
+    for(int c=0;c<g.Ncon;++c)
+      localMaxVw[c] = mymax(localMaxVw[c], g.vw[v*g.Ncon+c]);
+  MPI_Allreduce(localW.data(), W.data(), g.Ncon, MPI_DFLOAT, MPI_SUM, comm);
+  MPI_Allreduce(localMaxVw.data(), maxVw.data(), g.Ncon, MPI_DFLOAT, MPI_MAX, comm);
+  for(int c=0;c<g.Ncon;++c)
+    maxVw[c] = mymax((dfloat) (1.5*W[c]/coarsenTo), 2*maxVw[c]);
+
+  // coarsening phase
+  std::vector<partGraph_t> graphs;
+  graphs.push_back(g);
+
+  hlong NvLocal = g.Nv, NvGlobal = 0;
+  MPI_Allreduce(&NvLocal, &NvGlobal, 1, MPI_HLONG, MPI_SUM, comm);
+
+  while(NvGlobal > coarsenTo){
+    partGraph_t gc;
+    coarsenGraph(comm, graphs.back(), gc, maxVw, rng);
+
+    hlong NcLocal = gc.Nv, NcGlobal = 0;
+    MPI_Allreduce(&NcLocal, &NcGlobal, 1, MPI_HLONG, MPI_SUM, comm);
+
+    // stop when matching no longer shrinks the graph
+    if(NcGlobal > 0.95*NvGlobal) break;
+
+    graphs.push_back(std::move(gc));
+    NvGlobal = NcGlobal;
+  }
+
+  // initial partition of the gathered coarsest graph
+  const int Nlevels = graphs.size();
+  const partGraph_t& gCoarse = graphs[Nlevels-1];
+
+  partGraph_t gAll;
+  gatherGraph(comm, gCoarse, gAll);
+
+  std::vector<int> partAll;
+  recursiveBisection(gAll, Nparts, 0, partAll, rngAll);
+  refineKway(gAll, partAll, Nparts, rngAll);
+
+  part.assign(partAll.begin()+gCoarse.offset,
+              partAll.begin()+gCoarse.offset+gCoarse.Nv);
+
+  // uncoarsening phase
+  for(int l=Nlevels-2;l>=0;--l){
+    const partGraph_t& gl = graphs[l];
+    std::vector<int> finePart(gl.Nv);
+    for(dlong v=0;v<gl.Nv;++v)
+      finePart[v] = part[gl.cmap[v]];
+    part.swap(finePart);
+
+    refineKwayParallel(comm, gl, part);
+  }
+}
+
+/* ---------------------------------------------------------
+
+Relative cost of each local element for the graph partitioner,
+selected by the PARTITION WEIGHTS setting. Returns NULL for
+uniform cost.
+
+PML       - PML elements, tagged 100-700 in elementInfo, carry the
+            auxiliary PML fields and count twice
+MULTIRATE - an element on multirate level l of L takes 2^(L-1-l)
+            steps per coarsest step. The levels are estimated from
+            the shortest vertex-to-vertex distance of each element,
+            as the time step of an explicit scheme scales with it
+
+------------------------------------------------------------ */
+dfloat* mesh_t::PartitionWeights(){
+
+  if (settings.compareSetting("PARTITION WEIGHTS","UNIFORM")) return NULL;
+
+  const bool pmlCost = settings.compareSetting("PARTITION WEIGHTS","PML")
+                    || settings.compareSetting("PARTITION WEIGHTS","PML+MULTIRATE");
+  const bool mrCost  = settings.compareSetting("PARTITION WEIGHTS","MULTIRATE")
+                    || settings.compareSetting("PARTITION WEIGHTS","PML+MULTIRATE");
+
+  dfloat *weights = (dfloat*) calloc(Nelements+1, sizeof(dfloat));
+  for(dlong e=0;e<Nelements;++e) weights[e] = 1.0;
+
+  if (pmlCost) {
+    for(dlong e=0;e<Nelements;++e){
+      const hlong type = elementInfo[e];
+      if ((type==100)||(type==200)||(type==300)||
+          (type==400)||(type==500)||(type==600)||
+          (type==700))
+        weights[e] *= 2.0;
+    }
+  }
+
+  if (mrCost) {
+    dfloat *h = (dfloat*) calloc(Nelements+1, sizeof(dfloat));
+
+    dfloat hmin = std::numeric_limits<dfloat>::max();
+    dfloat hmax = 0.0;
+    for(dlong e=0;e<Nelements;++e){
+      h[e] = std::numeric_limits<dfloat>::max();
+      for(int n=0;n<Nverts;++n){
+        for(int m=n+1;m<Nverts;++m){
+          const dfloat dx = EX[e*Nverts+n]-EX[e*Nverts+m];
+          const dfloat dy = EY[e*Nverts+n]-EY[e*Nverts+m];
+          const dfloat dz = (dim==3) ? EZ[e*Nverts+n]-EZ[e*Nverts+m] : 0.0;
+          h[e] = mymin(h[e], sqrt(dx*dx+dy*dy+dz*dz));
+        }
+      }
+      hmin = mymin(hmin, h[e]);
+      hmax = mymax(hmax, h[e]);
+    }
+
+    dfloat ghmin, ghmax;
+    MPI_Allreduce(&hmin, &ghmin, 1, MPI_DFLOAT, MPI_MIN, comm);
+    MPI_Allreduce(&hmax, &ghmax, 1, MPI_DFLOAT, MPI_MAX, comm);
+
+    const int Nlevels = floor(log2(ghmax/ghmin))+1;
+    for(dlong e=0;e<Nelements;++e){
+      const int level = mymin((int) floor(log2(h[e]/ghmin)), Nlevels-1);
+      weights[e] *= pow(2.0, Nlevels-1-level);
+    }
+    free(h);
+  }
+
+  return weights;
+}
+
+// local index of a vertex, ghosts numbered after the local vertices
+static dlong localId(const partGraph_t& g, const hlong gN){
+  if(gN>=g.offset && gN<g.offset+g.Nv) return (dlong) (gN-g.offset);
+  return g.Nv + (dlong) (std::lower_bound(g.ghostIds.begin(), g.ghostIds.end(), gN)
+                         - g.ghostIds.begin());
+}
+
+// local rows of the element dual graph, with Ncon weights per element.
+// neighbors gets the global ids of the face neighbors, -1 on the boundary
+static void dualGraph(mesh_t& mesh, const dfloat *weights, const int Ncon,
+                      partGraph_t& g, hlong *neighbors){
+
+  const int size = mesh.size, rank = mesh.rank;
+  const dlong Nelements = mesh.Nelements;
+  const int Nfaces = mesh.Nfaces;
+
+  // global element numbering of the current partition
+  hlong *starts = (hlong*) calloc(size+1, sizeof(hlong));
+  dlong *allNelements = (dlong*) calloc(size, sizeof(dlong));
+  MPI_Allgather(&Nelements, 1, MPI_DLONG, allNelements, 1, MPI_DLONG, mesh.comm);
+  for(int rr=0;rr<size;++rr)
+    starts[rr+1] = starts[rr] + allNelements[rr];
+  free(allNelements);
+
+  g.Nv = Nelements;
+  g.Ncon = Ncon;
+  g.offset = starts[rank];
+  g.xadj.assign(Nelements+1, 0);
+  g.vw.assign(Nelements*Ncon, 1.0);
+  g.ghostIds.clear();
+  for(dlong e=0;e<Nelements;++e){
+    g.xadj[e+1] = g.xadj[e];
+    for(int f=0;f<Nfaces;++f){
+      const dlong eN = mesh.EToE[e*Nfaces+f];
+      if(eN<0) {
+        neighbors[e*Nfaces+f] = -1;
+        continue;
+      }
+      const int rN = mesh.EToP[e*Nfaces+f];
+      neighbors[e*Nfaces+f] = (rN==-1) ? starts[rank]+eN : starts[rN]+eN;
+      if(rN!=-1) g.ghostIds.push_back(neighbors[e*Nfaces+f]);
+      g.xadj[e+1]++;
+    }
+    if (weights)
+      for(int c=0;c<Ncon;++c) g.vw[e*Ncon+c] = weights[e*Ncon+c];
+  }
+  free(starts);
+
+  std::sort(g.ghostIds.begin(), g.ghostIds.end());
+  g.ghostIds.erase(std::unique(g.ghostIds.begin(), g.ghostIds.end()), g.ghostIds.end());
+
+  g.adj.resize(g.xadj[Nelements]);
+  g.adjw.assign(g.xadj[Nelements], 1);
+  for(dlong e=0;e<Nelements;++e){
+    dlong j = g.xadj[e];
+    for(int f=0;f<Nfaces;++f)
+      if(neighbors[e*Nfaces+f]>=0) g.adj[j++] = localId(g, neighbors[e*Nfaces+f]);
+  }
+}
+
+// partition the dual graph into one part per rank. part gets the parts of the
+// local vertices followed by those of the ghosts. Reports the cut and the
+// largest load imbalance over the constraints
+static void partitionDualGraph(MPI_Comm comm, partGraph_t& g, partHalo_t& graphHalo,
+                               std::vector<int>& part){
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const dlong Nv = g.Nv;
+  const int Ncon = g.Ncon;
+
+  multilevelPartition(comm, g, size, part);
+
+  setupHalo(comm, g, graphHalo);
+  part.resize(Nv+g.ghostIds.size()+1);
+  exchangeHalo(comm, graphHalo, MPI_INT, part.data(), part.data()+Nv);
+
+  hlong cut[2] = {0, 0};
+  std::vector<dfloat> pw(2*size*Ncon, 0.0);
+  for(dlong e=0;e<Nv;++e){
+    for(dlong j=g.xadj[e];j<g.xadj[e+1];++j){
+      const dlong n = g.adj[j];
+      if(n>=Nv) cut[0] += g.adjw[j];
+      if(part[n]!=part[e]) cut[1] += g.adjw[j];
+    }
+    for(int c=0;c<Ncon;++c){
+      pw[rank*Ncon+c]            += g.vw[e*Ncon+c];
+      pw[(size+part[e])*Ncon+c] += g.vw[e*Ncon+c];
+    }
+  }
+  hlong gcut[2];
+  std::vector<dfloat> gpw(2*size*Ncon);
+  MPI_Reduce(cut, gcut, 2, MPI_HLONG, MPI_SUM, 0, comm);
+  MPI_Reduce(pw.data(), gpw.data(), 2*size*Ncon, MPI_DFLOAT, MPI_SUM, 0, comm);
+
+  if(rank==0){
+    dfloat oldImb = 1.0, newImb = 1.0;
+    for(int c=0;c<Ncon;++c){
+      dfloat W = 0.0, oldMax = 0.0, newMax = 0.0;
+      for(int rr=0;rr<size;++rr){
+        W += gpw[rr*Ncon+c];
+        oldMax = mymax(oldMax, gpw[rr*Ncon+c]);
+        newMax = mymax(newMax, gpw[(size+rr)*Ncon+c]);
+      }
+      if(W<=0.0) continue;
+      oldImb = mymax(oldImb, oldMax*size/W);
+      newImb = mymax(newImb, newMax*size/W);
+    }
+
+    printf("Graph partition: edge cut " hlongFormat " -> " hlongFormat
+           ", imbalance %5.3f -> %5.3f\n",
+           gcut[0]/2, gcut[1]/2, oldImb, newImb);
+  }
+}
+
+/* ---------------------------------------------------------
+
+Destination rank of each local element under the multilevel
+graph partitioner, without moving any elements. Requires the
+face connectivity of the current partition.
+
+weights - Ncon costs of each local element, each balanced over
+          the ranks separately (NULL for unit cost)
+part    - destination rank of each local element
+
+------------------------------------------------------------ */
+void mesh_t::GraphPartitionParts(dfloat *weights, int Ncon, int *part){
+
+  if(size==1) {
+    for(dlong e=0;e<Nelements;++e) part[e] = 0;
+    return;
+  }
+
+  hlong *neighbors = (hlong*) calloc(Nelements*Nfaces+1, sizeof(hlong));
+
+  partGraph_t g;
+  dualGraph(*this, weights, Ncon, g, neighbors);
+  free(neighbors);
+
+  std::vector<int> graphPart;
+  partHalo_t graphHalo;
+  partitionDualGraph(comm, g, graphHalo, graphPart);
+
+  for(dlong e=0;e<Nelements;++e) part[e] = graphPart[e];
+}
+
+/* ---------------------------------------------------------
+
+Repartition the elements with the multilevel graph partitioner.
+Requires the face connectivity of the current partition, i.e.
+ParallelConnect must have been called. The face connectivity is
+migrated with the elements, so it remains valid on the new
+partition.
+
+weights - optional Ncon costs of each local element, each
+          balanced over the ranks separately (NULL for unit cost)
+
+------------------------------------------------------------ */
+void mesh_t::GraphPartition(dfloat *weights, int Ncon){
+
+  if(size==1) return;
+
+  // global ids of the face neighbors, -1 on the boundary
+  hlong *neighbors = (hlong*) calloc(Nelements*Nfaces+1, sizeof(hlong));
+
+  // local rows of the dual graph
+  partGraph_t g;
+  dualGraph(*this, weights, Ncon, g, neighbors);
+
+  std::vector<int> part;
+  partHalo_t graphHalo;
+  partitionDualGraph(comm, g, graphHalo, part);
+
+  // new local ids, also of the ghosts. Elements arrive in increasing global
+  // id order from each rank, so the new local index of an element is its
+  // position among the elements of its part
+  std::vector<hlong> partCounts(size, 0), partStarts(size, 0);
+  std::vector<dlong> newIds(Nelements+g.ghostIds.size()+1);
+  for(dlong e=0;e<Nelements;++e)
+    partCounts[part[e]]++;
+  MPI_Exscan(partCounts.data(), partStarts.data(), size, MPI_HLONG, MPI_SUM, comm);
+  if(rank==0) std::fill(partStarts.begin(), partStarts.end(), 0);
+  for(dlong e=0;e<Nelements;++e)
+    newIds[e] = (dlong) (partStarts[part[e]]++);
+
+  exchangeHalo(comm, graphHalo, MPI_DLONG, newIds.data(), newIds.data()+Nelements);
+
+  // bucket the element capsules by destination
+  int *Nsend = (int*) calloc(size, sizeof(int));
+  int *Nrecv = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size, sizeof(int));
+  int *recvOffsets = (int*) calloc(size, sizeof(int));
+
+  for(dlong e=0;e<Nelements;++e)
+    ++Nsend[part[e]];
+
+  for(int rr=1;rr<size;++rr)
+    sendOffsets[rr] = sendOffsets[rr-1] + Nsend[rr-1];
+
+  partElement_t *sendElements = (partElement_t*) calloc(Nelements+1, sizeof(partElement_t));
+  for(int rr=0;rr<size;++rr) Nsend[rr] = 0;
+  for(dlong e=0;e<Nelements;++e){
+    const int rr = part[e];
+    partElement_t &el = sendElements[sendOffsets[rr]+Nsend[rr]++];
+    for(int n=0;n<Nverts;++n){
+      el.v[n]  = EToV[e*Nverts+n];
+      el.EX[n] = EX[e*Nverts+n];
+      el.EY[n] = EY[e*Nverts+n];
+      if (dim==3)
+        el.EZ[n] = EZ[e*Nverts+n];
+    }
+    for(int f=0;f<Nfaces;++f){
+      const hlong gN = neighbors[e*Nfaces+f];
+      const dlong n = (gN>=0) ? localId(g, gN) : -1;
+      el.EToE[f] = (gN>=0) ? newIds[n] : -1;
+      el.EToF[f] = EToF[e*Nfaces+f];
+      el.EToP[f] = (gN>=0) ? part[n] : -1;
+    }
+    el.type = elementInfo[e];
+  }
+  free(neighbors);
+
+  MPI_Alltoall(Nsend, 1, MPI_INT, Nrecv, 1, MPI_INT, comm);
+
+  dlong newNelements = 0;
+  for(int rr=0;rr<size;++rr)
+    newNelements += Nrecv[rr];
+
+  for(int rr=1;rr<size;++rr)
+    recvOffsets[rr] = recvOffsets[rr-1] + Nrecv[rr-1];
+
+  // Make the MPI_PARTELEMENT_T data type
+  MPI_Datatype MPI_PARTELEMENT_T;
+  MPI_Datatype dtype[8] = {MPI_HLONG, MPI_HLONG, MPI_DFLOAT, MPI_DFLOAT, MPI_DFLOAT,
+                           MPI_DLONG, MPI_INT, MPI_INT};
+  int blength[8] = {1, 8, 8, 8, 8, 6, 6, 6};
+  MPI_Aint addr[8], displ[8];
+  MPI_Get_address ( &(sendElements[0]        ), addr+0);
+  MPI_Get_address ( &(sendElements[0].v[0]   ), addr+1);
+  MPI_Get_address ( &(sendElements[0].EX[0]  ), addr+2);
+  MPI_Get_address ( &(sendElements[0].EY[0]  ), addr+3);
+  MPI_Get_address ( &(sendElements[0].EZ[0]  ), addr+4);
+  MPI_Get_address ( &(sendElements[0].EToE[0]), addr+5);
+  MPI_Get_address ( &(sendElements[0].EToF[0]), addr+6);
+  MPI_Get_address ( &(sendElements[0].EToP[0]), addr+7);
+  for (int n=0;n<8;n++)
+    displ[n] = addr[n] - addr[0];
+  MPI_Type_create_struct (8, blength, displ, dtype, &MPI_PARTELEMENT_T);
+  MPI_Type_commit (&MPI_PARTELEMENT_T);
+
+  partElement_t *recvElements = (partElement_t*) calloc(newNelements+1, sizeof(partElement_t));
+
+  MPI_Alltoallv(sendElements, Nsend, sendOffsets, MPI_PARTELEMENT_T,
+                recvElements, Nrecv, recvOffsets, MPI_PARTELEMENT_T, comm);
+
+  MPI_Type_free(&MPI_PARTELEMENT_T);
+
+  free(sendElements);
+  free(Nsend); free(Nrecv);
+  free(sendOffsets); free(recvOffsets);
+
+  // reset element data from the returned capsules
+  free(EToV);
+  free(EX);
+  free(EY);
+  if (dim==3) free(EZ);
+  free(elementInfo);
+  free(EToE);
+  free(EToF);
+  free(EToP);
+
+  Nelements = newNelements;
+  EToV = (hlong*) calloc(Nelements*Nverts, sizeof(hlong));
+  EX = (dfloat*) calloc(Nelements*Nverts, sizeof(dfloat));
+  EY = (dfloat*) calloc(Nelements*Nverts, sizeof(dfloat));
+  if (dim==3)
+    EZ = (dfloat*) calloc(Nelements*Nverts, sizeof(dfloat));
+  elementInfo = (hlong*) calloc(Nelements, sizeof(hlong));
+  EToE = (dlong*) calloc(Nelements*Nfaces, sizeof(dlong));
+  EToF = (int*)   calloc(Nelements*Nfaces, sizeof(int));
+  EToP = (int*)   calloc(Nelements*Nfaces, sizeof(int));
+
+  for(dlong e=0;e<Nelements;++e){
+    for(int n=0;n<Nverts;++n){
+      EToV[e*Nverts + n] = recvElements[e].v[n];
+      EX[e*Nverts + n]   = recvElements[e].EX[n];
+      EY[e*Nverts + n]   = recvElements[e].EY[n];
+      if (dim==3)
+        EZ[e*Nverts + n] = recvElements[e].EZ[n];
+    }
+    for(int f=0;f<Nfaces;++f){
+      const int rN = recvElements[e].EToP[f];
+      EToE[e*Nfaces + f] = recvElements[e].EToE[f];
+      EToF[e*Nfaces + f] = recvElements[e].EToF[f];
+      EToP[e*Nfaces + f] = (rN==rank) ? -1 : rN;
+    }
+    elementInfo[e] = recvElements[e].type;
+  }
+  free(recvElements);
+}
@@ -0,0 +1,378 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include "mesh/mesh2D.hpp"
+#include "mesh/mesh3D.hpp"
+#include "mesh/meshHierarchy.hpp"
+
+typedef struct {
+  hlong v[4];      // sorted global ids of the entity vertices
+  hlong gid;       // global entity id
+  dlong id;        // local entity id
+  int rank;        // originating rank
+}parallelEntity_t;
+
+meshHierarchy_t::meshHierarchy_t(mesh_t& _mesh):
+  mesh(_mesh) {
+
+  levels[mesh.N] = &mesh;
+
+  LocalEntities();
+  ConnectEntities();
+}
+
+meshHierarchy_t::~meshHierarchy_t(){
+  for (auto& level : levels) {
+    mesh_t *levelMesh = level.second;
+    if (levelMesh==&mesh) continue;
+
+    // the halo belongs to the mesh the levels were made from
+    levelMesh->halo = nullptr;
+    levelMesh->ringHalo = nullptr;
+    levelMesh->hierarchy = nullptr;
+    delete levelMesh;
+  }
+
+  free(entityVerts);
+  free(entityIds);
+}
+
+mesh_t& meshHierarchy_t::Level(int N){
+
+  auto level = levels.find(N);
+  if (level!=levels.end()) return *(level->second);
+
+  mesh_t *levelMesh=NULL;
+  switch(mesh.elementType){
+  case TRIANGLES:
+    if(mesh.dim==2)
+      levelMesh = new meshTri2D(mesh.platform, mesh.settings, mesh.comm);
+    else
+      levelMesh = new meshTri3D(mesh.platform, mesh.settings, mesh.comm);
+    break;
+  case QUADRILATERALS:
+    if(mesh.dim==2)
+      levelMesh = new meshQuad2D(mesh.platform, mesh.settings, mesh.comm);
+    else
+      levelMesh = new meshQuad3D(mesh.platform, mesh.settings, mesh.comm);
+    break;
+  case TETRAHEDRA:
+    levelMesh = new meshTet3D(mesh.platform, mesh.settings, mesh.comm);
+    break;
+  case HEXAHEDRA:
+    levelMesh = new meshHex3D(mesh.platform, mesh.settings, mesh.comm);
+    break;
+  }
+
+  mesh_t &meshL = *levelMesh;
+
+  //shallow copy of base mesh geometry
+  meshL.dim           = mesh.dim;
+  meshL.Nverts        = mesh.Nverts;
+  meshL.Nfaces        = mesh.Nfaces;
+  meshL.NfaceVertices = mesh.NfaceVertices;
+  meshL.faceVertices  = mesh.faceVertices;
+
+  meshL.elementType = mesh.elementType;
+
+  meshL.Nnodes = mesh.Nnodes;
+  meshL.EX = mesh.EX; // coordinates of vertices for each element
+  meshL.EY = mesh.EY;
+  meshL.EZ = mesh.EZ;
+
+  meshL.Nelements = mesh.Nelements;
+  meshL.NelementsGlobal = mesh.NelementsGlobal;
+  meshL.EToV = mesh.EToV; // element-to-vertex connectivity
+  meshL.EToE = mesh.EToE; // element-to-element connectivity
+  meshL.EToF = mesh.EToF; // element-to-(local)face connectivity
+  meshL.EToP = mesh.EToP; // element-to-partition/process connectivity
+  meshL.EToB = mesh.EToB; // element-to-boundary condition type
+
+  meshL.elementInfo = mesh.elementInfo;
+
+  meshL.NboundaryFaces = mesh.NboundaryFaces;
+  meshL.boundaryInfo = mesh.boundaryInfo;
+
+  meshL.halo = mesh.halo;
+  meshL.ringHalo = nullptr;
+  meshL.NinternalElements = mesh.NinternalElements;
+  meshL.NhaloElements = mesh.NhaloElements;
+  meshL.totalHaloPairs = mesh.totalHaloPairs;
+  meshL.internalElementIds = mesh.internalElementIds;
+  meshL.haloElementIds = mesh.haloElementIds;
+  meshL.o_internalElementIds = mesh.o_internalElementIds;
+  meshL.o_haloElementIds     = mesh.o_haloElementIds;
+
+  meshL.hierarchy = this;
+
+  // load reference (r,s) element nodes
+  meshL.ReferenceNodes(N);
+
+  // compute physical (x,y) locations of the element nodes
+  meshL.PhysicalNodes();
+
+  // affine elements have one set of factors per element and face, which
+  // does not depend on the degree
+  const bool affine = (mesh.elementType==TRIANGLES && mesh.dim==2)
+                    || mesh.elementType==TETRAHEDRA;
+
+  if (affine) {
+    // the host factors of the root may have been released
+    mesh.RestoreHostMirrors();
+
+    meshL.Nvgeo  = mesh.Nvgeo;
+    meshL.Nggeo  = mesh.Nggeo;
+    meshL.vgeo   = mesh.vgeo;
+    meshL.ggeo   = mesh.ggeo;
+    meshL.o_vgeo = mesh.o_vgeo;
+    meshL.o_ggeo = mesh.o_ggeo;
+    meshL.sharedGeometricFactors = true;
+  } else {
+    // compute geometric factors
+    meshL.GeometricFactors();
+  }
+
+  // reuse the trace maps and global numbering of an earlier run
+  const bool nodesCached = meshL.LoadNodeCache();
+
+  // connect face nodes (find trace indices)
+  if (!nodesCached)
+    meshL.ConnectFaceNodes();
+
+  if (affine) {
+    meshL.Nsgeo  = mesh.Nsgeo;
+    meshL.sgeo   = mesh.sgeo;
+    meshL.o_sgeo = mesh.o_sgeo;
+  } else {
+    // compute surface geofacs
+    meshL.SurfaceGeometricFactors();
+  }
+
+  // make a global indexing from the vertex, edge, and face numbering
+  if (!nodesCached) {
+    meshL.ParallelConnectNodes(*this);
+    meshL.SaveNodeCache();
+  }
+
+  // make an ogs operator and label local/global gather elements
+  meshL.ParallelGatherScatterSetup();
+
+  meshL.OccaSetup();
+
+  meshL.RegisterMemory();
+
+  levels[N] = levelMesh;
+
+  return meshL;
+}
+
+// list the faces of the reference element and, for volume elements, the
+// edges of those faces
+void meshHierarchy_t::LocalEntities(){
+
+  const int Nfaces        = mesh.Nfaces;
+  const int NfaceVertices = mesh.NfaceVertices;
+
+  entityVerts = (int*) malloc(Nfaces*(NfaceVertices+1)*4*sizeof(int));
+  Nentities = 0;
+
+  auto addEntity = [&](int Nv, const int *v) {
+    int key[4] = {-1,-1,-1,-1};
+    for (int i=0;i<Nv;i++) key[i] = v[i];
+    std::sort(key, key+Nv);
+
+    for (int k=0;k<Nentities;k++)
+      if (std::equal(key, key+4, entityVerts+k*4)) return;
+
+    for (int i=0;i<4;i++) entityVerts[Nentities*4+i] = key[i];
+    Nentities++;
+  };
+
+  for (int f=0;f<Nfaces;f++)
+    addEntity(NfaceVertices, mesh.faceVertices+f*NfaceVertices);
+
+  if (mesh.elementType==TETRAHEDRA || mesh.elementType==HEXAHEDRA) {
+    // face vertices are listed cyclically, so neighbouring pairs are edges
+    for (int f=0;f<Nfaces;f++) {
+      const int *fv = mesh.faceVertices+f*NfaceVertices;
+      for (int i=0;i<NfaceVertices;i++) {
+        int edge[2] = {fv[i], fv[(i+1)%NfaceVertices]};
+        addEntity(2, edge);
+      }
+    }
+  }
+}
+
+// number the edges and faces of the mesh globally. Each entity is sent
+//  to a rank chosen from its largest vertex id, where duplicates are
+//  matched by sorting and the unique entities are numbered contiguously
+void meshHierarchy_t::ConnectEntities(){
+
+  const dlong Nelements = mesh.Nelements;
+  const int Nverts = mesh.Nverts;
+  const int rank = mesh.rank;
+  const int size = mesh.size;
+  MPI_Comm comm = mesh.comm;
+
+  const dlong Nlocal = Nelements*Nentities;
+  entityIds = (hlong*) calloc(mymax(Nlocal,(dlong)1), sizeof(hlong));
+
+  int *Nsend = (int*) calloc(size, sizeof(int));
+  int *Nrecv = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size, sizeof(int));
+  int *recvOffsets = (int*) calloc(size, sizeof(int));
+
+  // buffer for outgoing data
+  parallelEntity_t *sendEntities =
+    (parallelEntity_t*) calloc(mymax(Nlocal,(dlong)1), sizeof(parallelEntity_t));
+
+  // sorted global vertex ids of each entity
+  for(dlong e=0;e<Nelements;++e){
+    for(int k=0;k<Nentities;++k){
+      parallelEntity_t &entity = sendEntities[e*Nentities+k];
+
+      int cnt = 0;
+      for(int i=0;i<4;++i){
+        const int v = entityVerts[k*4+i];
+        entity.v[i] = (v<0) ? -1 : mesh.EToV[e*Nverts+v];
+        if(v>=0) ++cnt;
+      }
+      std::sort(entity.v, entity.v+cnt);
+
+      entity.gid  = 0;
+      entity.id   = e*Nentities+k;
+      entity.rank = (int) (entity.v[cnt-1]%size);
+    }
+  }
+
+  // group by destination rank, keeping the local order within a rank
+  std::stable_sort(sendEntities, sendEntities+Nlocal,
+                   [](const parallelEntity_t& a, const parallelEntity_t& b) {
+                     return a.rank < b.rank;
+                   });
+
+  for(dlong n=0;n<Nlocal;++n){
+    ++Nsend[sendEntities[n].rank];
+    sendEntities[n].rank = rank;
+  }
+
+  // find send offsets
+  for(int rr=1;rr<size;++rr)
+    sendOffsets[rr] = sendOffsets[rr-1] + Nsend[rr-1];
+
+  // Make the MPI_PARALLELENTITY_T data type
+  MPI_Datatype MPI_PARALLELENTITY_T;
+  MPI_Datatype dtype[4] = {MPI_HLONG, MPI_HLONG, MPI_DLONG, MPI_INT};
+  int blength[4] = {4, 1, 1, 1};
+  MPI_Aint addr[4], displ[4];
+  parallelEntity_t dummy;
+  MPI_Get_address ( &(dummy      ), addr+0);
+  MPI_Get_address ( &(dummy.gid  ), addr+1);
+  MPI_Get_address ( &(dummy.id   ), addr+2);
+  MPI_Get_address ( &(dummy.rank ), addr+3);
+  displ[0] = 0;
+  displ[1] = addr[1] - addr[0];
+  displ[2] = addr[2] - addr[0];
+  displ[3] = addr[3] - addr[0];
+  MPI_Type_create_struct (4, blength, displ, dtype, &MPI_PARALLELENTITY_T);
+  MPI_Type_commit (&MPI_PARALLELENTITY_T);
+
+  // exchange counts
+  MPI_Alltoall(Nsend, 1, MPI_INT,
+               Nrecv, 1, MPI_INT,
+               comm);
+
+  // count incoming entities
+  int allNrecv = 0;
+  for(int rr=0;rr<size;++rr)
+    allNrecv += Nrecv[rr];
+
+  // find offsets for recv data
+  for(int rr=1;rr<size;++rr)
+    recvOffsets[rr] = recvOffsets[rr-1] + Nrecv[rr-1];
+
+  // buffer for incoming entity data
+  parallelEntity_t *recvEntities =
+    (parallelEntity_t*) calloc(mymax(allNrecv,1), sizeof(parallelEntity_t));
+
+  MPI_Alltoallv(sendEntities, Nsend, sendOffsets, MPI_PARALLELENTITY_T,
+                recvEntities, Nrecv, recvOffsets, MPI_PARALLELENTITY_T,
+                comm);
+
+  // local sort of received entities by vertex ids
+  std::sort(recvEntities, recvEntities+allNrecv,
+            [](const parallelEntity_t& a, const parallelEntity_t& b) {
+              return std::lexicographical_compare(a.v, a.v+4, b.v, b.v+4);
+            });
+
+  // count unique entities
+  hlong Nunique = 0;
+  for(int n=0;n<allNrecv;++n)
+    if(n==0 || !std::equal(recvEntities[n].v, recvEntities[n].v+4, recvEntities[n-1].v))
+      ++Nunique;
+
+  hlong uniqueStart = 0;
+  MPI_Exscan(&Nunique, &uniqueStart, 1, MPI_HLONG, MPI_SUM, comm);
+  if(rank==0) uniqueStart = 0;
+
+  MPI_Allreduce(&Nunique, &NentitiesGlobal, 1, MPI_HLONG, MPI_SUM, comm);
+
+  // number the unique entities
+  hlong gid = uniqueStart-1;
+  for(int n=0;n<allNrecv;++n){
+    if(n==0 || !std::equal(recvEntities[n].v, recvEntities[n].v+4, recvEntities[n-1].v))
+      ++gid;
+    recvEntities[n].gid = gid;
+  }
+
+  // sort back to original ordering
+  std::sort(recvEntities, recvEntities+allNrecv,
+            [](const parallelEntity_t& a, const parallelEntity_t& b) {
+              if(a.rank < b.rank) return true;
+              if(a.rank > b.rank) return false;
+
+              return (a.id < b.id);
+            });
+
+  // send entities back from whence they came
+  MPI_Alltoallv(recvEntities, Nrecv, recvOffsets, MPI_PARALLELENTITY_T,
+                sendEntities, Nsend, sendOffsets, MPI_PARALLELENTITY_T,
+                comm);
+
+  // extract global ids
+  for(dlong n=0;n<Nlocal;++n)
+    entityIds[sendEntities[n].id] = sendEntities[n].gid;
+
+  MPI_Barrier(comm);
+  MPI_Type_free(&MPI_PARALLELENTITY_T);
+  free(sendEntities);
+  free(recvEntities);
+  free(Nsend);
+  free(Nrecv);
+  free(sendOffsets);
+  free(recvOffsets);
+}
@@ -0,0 +1,76 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+
+/* ---------------------------------------------------------
+
+Index of the lattice point (x,y[,z]) along a Hilbert curve
+through a 2^bits per side lattice in dim dimensions.
+
+Uses Skilling's transpose form of the Hilbert index, see
+J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc.
+707 (2004). Requires dim*bits <= 64.
+
+------------------------------------------------------------ */
+unsigned long long int mesh_t::HilbertIndex(int _dim, int bits,
+                                            unsigned int x, unsigned int y, unsigned int z){
+
+  unsigned int X[3] = {x, y, z};
+
+  const unsigned int M = 1u << (bits-1);
+
+  // inverse undo excess work
+  for(unsigned int Q=M;Q>1;Q>>=1){
+    const unsigned int P = Q-1;
+    for(int i=0;i<_dim;++i){
+      if(X[i] & Q) {
+        X[0] ^= P; //invert
+      } else { //exchange
+        const unsigned int t = (X[0]^X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for(int i=1;i<_dim;++i) X[i] ^= X[i-1];
+
+  unsigned int t = 0;
+  for(unsigned int Q=M;Q>1;Q>>=1)
+    if(X[_dim-1] & Q) t ^= Q-1;
+
+  for(int i=0;i<_dim;++i) X[i] ^= t;
+
+  // interleave the transposed bits, most significant first
+  unsigned long long int index = 0;
+  for(int b=bits-1;b>=0;--b)
+    for(int i=0;i<_dim;++i)
+      index = (index<<1) | ((X[i]>>b) & 1);
+
+  return index;
+}
@@ -0,0 +1,150 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include "mesh/meshHierarchy.hpp"
+
+// free a host mirror of a device array
+template<typename T>
+static void releaseMirror(T* &a){
+  if (a) free(a);
+  a = NULL;
+}
+
+// download a host mirror of a device array
+template<typename T>
+static void restoreMirror(T* &a, occa::memory &o_a){
+  if (a || !o_a.size()) return;
+  a = (T*) malloc(o_a.size());
+  o_a.copyTo(a);
+}
+
+// download a host mirror of geometric factors, which may be stored in float
+static void restoreGeometricFactors(dfloat* &a, occa::memory &o_a, bool floatStorage){
+  if (!floatStorage) {
+    restoreMirror(a, o_a);
+    return;
+  }
+  if (a || !o_a.size()) return;
+  const size_t N = o_a.size()/sizeof(float);
+  float *fa = (float*) malloc(N*sizeof(float));
+  o_a.copyTo(fa);
+  a = (dfloat*) malloc(N*sizeof(dfloat));
+  for (size_t n=0;n<N;n++) a[n] = fa[n];
+  free(fa);
+}
+
+void mesh_t::ReleaseHostMirrors(){
+
+  if (!settings.compareSetting("HOST MIRRORS","RELEASE")) return;
+  if (hostMirrorsReleased) return;
+
+  // host geometric factors are needed for the characteristic length
+  if (cachedHmin==0.0)
+    cachedHmin = MinCharacteristicLength();
+
+  releaseMirror(x);
+  releaseMirror(y);
+  if (dim==3) releaseMirror(z);
+
+  // affine levels of a mesh hierarchy alias the factors of the mesh they
+  // were made from, so keep them while such a level exists
+  bool aliasedGeometricFactors = sharedGeometricFactors;
+  if (hierarchy && &(hierarchy->mesh)==this)
+    for (auto& level : hierarchy->levels)
+      if (level.second!=this && level.second->sharedGeometricFactors)
+        aliasedGeometricFactors = true;
+
+  if (!aliasedGeometricFactors) {
+    releaseMirror(vgeo);
+    releaseMirror(sgeo);
+    releaseMirror(ggeo);
+  }
+
+  releaseMirror(vmapM);
+  releaseMirror(vmapP);
+  releaseMirror(mapP);
+
+  hostMirrorsReleased = true;
+
+  RegisterMemory();
+}
+
+void mesh_t::RestoreHostMirrors(){
+
+  if (!hostMirrorsReleased) return;
+
+  restoreMirror(x, o_x);
+  restoreMirror(y, o_y);
+  if (dim==3) restoreMirror(z, o_z);
+
+  const bool floatGeo = FloatGeometricFactors();
+  restoreGeometricFactors(vgeo, o_vgeo, floatGeo);
+  restoreGeometricFactors(sgeo, o_sgeo, floatGeo);
+  restoreGeometricFactors(ggeo, o_ggeo, floatGeo);
+
+  restoreMirror(vmapM, o_vmapM);
+  restoreMirror(vmapP, o_vmapP);
+  restoreMirror(mapP, o_mapP);
+
+  hostMirrorsReleased = false;
+}
+
+void mesh_t::RegisterMemory(){
+
+  // element connectivity is shared by the levels of a mesh hierarchy
+  const bool ownsConnectivity = !hierarchy || &(hierarchy->mesh)==this;
+
+  // host arrays that persist after setup
+  size_t hostBytes = (Nelements+totalHaloPairs)*Np*sizeof(hlong);
+  if (ownsConnectivity)
+    hostBytes += Nelements*Nverts*(sizeof(hlong) + dim*sizeof(dfloat))
+               + Nelements*Nfaces*(sizeof(dlong) + 3*sizeof(int));
+
+  // shared geometric factors are counted by the mesh that owns them
+  const size_t geoBytes = sharedGeometricFactors ? 0
+                        : o_vgeo.size() + o_sgeo.size() + o_ggeo.size();
+
+  // host mirrors of device data
+  if (!hostMirrorsReleased)
+    hostBytes += o_x.size() + o_y.size() + o_z.size()
+               + o_vmapM.size() + o_vmapP.size() + o_mapP.size();
+
+  // geometric factors are kept on the host while levels alias them
+  if (!hostMirrorsReleased || vgeo)
+    hostBytes += FloatGeometricFactors() ? geoBytes*sizeof(dfloat)/sizeof(float) : geoBytes;
+
+  size_t deviceBytes = o_x.size() + o_y.size() + o_z.size()
+                     + geoBytes
+                     + o_vmapM.size() + o_vmapP.size() + o_mapP.size()
+                     + o_EToB.size();
+
+  // compact traces are separate arrays, nodal ones alias vmapM/vmapP
+  if (compactTrace)
+    deviceBytes += o_traceM.size() + o_traceP.size();
+
+  platform.RegisterMemory("mesh N=" + std::to_string(N), hostBytes, deviceBytes);
+}
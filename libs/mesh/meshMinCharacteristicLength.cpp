@@ -30,6 +30,9 @@ SOFTWARE.
 
 dfloat mesh_t::MinCharacteristicLength(){
 
+  // geometric factors are gone from the host, use the value from setup
+  if (hostMirrorsReleased) return cachedHmin;
+
   dfloat hmin = std::numeric_limits<dfloat>::max();
   for(dlong e=0;e<Nelements;++e){
     dfloat h = ElementCharacteristicLength(e);
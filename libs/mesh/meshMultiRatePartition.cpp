@@ -0,0 +1,306 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+
+// capsule for element vertices, multirate level, and time step estimate
+typedef struct {
+
+  int level;
+
+  hlong type;
+
+  dfloat dt;
+
+  // 8 for maximum number of vertices per element
+  hlong v[8];
+
+  dfloat EX[8], EY[8], EZ[8];
+
+}mrElement_t;
+
+// ratio of the largest to the mean per-rank work in one coarsest level step
+static dfloat multiRateImbalance(MPI_Comm comm, int Nlevels, dlong Nelements, int *level){
+
+  dfloat work = 0.0;
+  for(dlong e=0;e<Nelements;++e)
+    work += pow(2.0, Nlevels-1-level[e]);
+
+  dfloat maxWork, sumWork;
+  int size;
+  MPI_Comm_size(comm, &size);
+  MPI_Allreduce(&work, &maxWork, 1, MPI_DFLOAT, MPI_MAX, comm);
+  MPI_Allreduce(&work, &sumWork, 1, MPI_DFLOAT, MPI_SUM, comm);
+
+  return (sumWork>0.0) ? maxWork*size/sumWork : 1.0;
+}
+
+/* ---------------------------------------------------------
+
+Repartition the mesh so that every rank owns an equal share
+of the elements on each multirate level. A single-constraint
+partition balances the element count but a rank holding most
+of the fine (small time step) elements does many more updates
+per coarse step than its neighbours and sets the pace for all.
+
+  - compute multirate levels from the time step estimates
+  - partition the element dual graph with one weight per level,
+    so the graph partitioner balances each level separately
+    while it keeps the edge cut small
+  - migrate the element capsules and rebuild the connectivity,
+    halo, geometric factors, and gather-scatter data
+
+EToDT is migrated with the elements and is reallocated. Does
+nothing unless the mesh setting MULTIRATE PARTITION is TRUE.
+
+------------------------------------------------------------ */
+void mesh_t::MultiRatePartition(dfloat* &EToDT) {
+
+  if (!settings.compareSetting("MULTIRATE PARTITION","TRUE")) return;
+
+  //find the multirate levels on the current partition
+  MultiRateLevels(EToDT);
+
+  const int Nlevels = mrNlevels;
+
+  dfloat imbalance = multiRateImbalance(comm, Nlevels, Nelements, mrLevel);
+
+  // one constraint per level, an element only weighs on its own level
+  dfloat *weights = (dfloat*) calloc(Nelements*Nlevels+1, sizeof(dfloat));
+  for(dlong e=0;e<Nelements;++e)
+    weights[e*Nlevels+mrLevel[e]] = 1.0;
+
+  int *dest = (int*) calloc(Nelements+1, sizeof(int));
+  GraphPartitionParts(weights, Nlevels, dest);
+  free(weights);
+
+  int *Nsend = (int*) calloc(size, sizeof(int));
+  int *Nrecv = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size, sizeof(int));
+  int *recvOffsets = (int*) calloc(size, sizeof(int));
+
+  for(dlong e=0;e<Nelements;++e)
+    ++Nsend[dest[e]];
+
+  for(int rr=1;rr<size;++rr)
+    sendOffsets[rr] = sendOffsets[rr-1] + Nsend[rr-1];
+
+  // bucket the element capsules by destination
+  mrElement_t *sendElements = (mrElement_t*) calloc(Nelements+1, sizeof(mrElement_t));
+  for(int rr=0;rr<size;++rr) Nsend[rr] = 0;
+  for(dlong e=0;e<Nelements;++e){
+    const int rr = dest[e];
+    mrElement_t &el = sendElements[sendOffsets[rr]+Nsend[rr]++];
+    for(int n=0;n<Nverts;++n){
+      el.v[n]  = EToV[e*Nverts+n];
+      el.EX[n] = EX[e*Nverts+n];
+      el.EY[n] = EY[e*Nverts+n];
+      if (dim==3)
+        el.EZ[n] = EZ[e*Nverts+n];
+    }
+    el.level = mrLevel[e];
+    el.type  = elementInfo[e];
+    el.dt    = EToDT[e];
+  }
+
+  MPI_Alltoall(Nsend, 1, MPI_INT, Nrecv, 1, MPI_INT, comm);
+
+  dlong newNelements = 0;
+  for(int rr=0;rr<size;++rr)
+    newNelements += Nrecv[rr];
+
+  for(int rr=1;rr<size;++rr)
+    recvOffsets[rr] = recvOffsets[rr-1] + Nrecv[rr-1];
+
+  // Make the MPI_MRELEMENT_T data type
+  MPI_Datatype MPI_MRELEMENT_T;
+  MPI_Datatype dtype[7] = {MPI_INT, MPI_HLONG, MPI_DFLOAT,
+                           MPI_HLONG, MPI_DFLOAT, MPI_DFLOAT, MPI_DFLOAT};
+  int blength[7] = {1, 1, 1, 8, 8, 8, 8};
+  MPI_Aint addr[7], displ[7];
+  MPI_Get_address ( &(sendElements[0]        ), addr+0);
+  MPI_Get_address ( &(sendElements[0].type   ), addr+1);
+  MPI_Get_address ( &(sendElements[0].dt     ), addr+2);
+  MPI_Get_address ( &(sendElements[0].v[0]   ), addr+3);
+  MPI_Get_address ( &(sendElements[0].EX[0]  ), addr+4);
+  MPI_Get_address ( &(sendElements[0].EY[0]  ), addr+5);
+  MPI_Get_address ( &(sendElements[0].EZ[0]  ), addr+6);
+  for (int n=0;n<7;n++)
+    displ[n] = addr[n] - addr[0];
+  MPI_Type_create_struct (7, blength, displ, dtype, &MPI_MRELEMENT_T);
+  MPI_Type_commit (&MPI_MRELEMENT_T);
+
+  mrElement_t *recvElements = (mrElement_t*) calloc(newNelements+1, sizeof(mrElement_t));
+
+  MPI_Alltoallv(sendElements, Nsend, sendOffsets, MPI_MRELEMENT_T,
+                recvElements, Nrecv, recvOffsets, MPI_MRELEMENT_T, comm);
+
+  MPI_Type_free(&MPI_MRELEMENT_T);
+
+  free(sendElements);
+  free(dest);
+  free(Nsend); free(Nrecv);
+  free(sendOffsets); free(recvOffsets);
+
+  // free the data built on the old partition before it is rebuilt
+  FreePartitionData();
+
+  // reset element data from the returned capsules
+  free(EToV);
+  free(EX);
+  free(EY);
+  if (dim==3) free(EZ);
+  free(elementInfo);
+  free(EToDT);
+  free(mrLevel);
+
+  Nelements = newNelements;
+  EToV = (hlong*) calloc(Nelements*Nverts, sizeof(hlong));
+  EX = (dfloat*) calloc(Nelements*Nverts, sizeof(dfloat));
+  EY = (dfloat*) calloc(Nelements*Nverts, sizeof(dfloat));
+  if (dim==3)
+    EZ = (dfloat*) calloc(Nelements*Nverts, sizeof(dfloat));
+  elementInfo = (hlong*) calloc(Nelements, sizeof(hlong));
+  EToDT = (dfloat*) calloc(Nelements, sizeof(dfloat));
+  mrLevel = (int*) calloc(Nelements, sizeof(int));
+
+  for(dlong e=0;e<Nelements;++e){
+    for(int n=0;n<Nverts;++n){
+      EToV[e*Nverts + n] = recvElements[e].v[n];
+      EX[e*Nverts + n]   = recvElements[e].EX[n];
+      EY[e*Nverts + n]   = recvElements[e].EY[n];
+      if (dim==3)
+        EZ[e*Nverts + n] = recvElements[e].EZ[n];
+    }
+    elementInfo[e] = recvElements[e].type;
+    EToDT[e]       = recvElements[e].dt;
+    mrLevel[e]     = recvElements[e].level;
+  }
+  free(recvElements);
+
+  dfloat newImbalance = multiRateImbalance(comm, Nlevels, Nelements, mrLevel);
+  free(mrLevel);
+  mrLevel = NULL;
+
+  if (rank==0)
+    printf("MultiRate partition: work imbalance %5.3f -> %5.3f\n",
+           imbalance, newImbalance);
+
+  // connect elements using parallel sort
+  ParallelConnect();
+
+  // print out connectivity statistics
+  PrintPartitionStatistics();
+
+  // connect elements to boundary faces
+  ConnectBoundary();
+
+  // set up halo exchange info for MPI (do before connect face nodes)
+  HaloSetup();
+
+  // compute physical (x,y) locations of the element nodes
+  PhysicalNodes();
+
+  // compute geometric factors
+  GeometricFactors();
+
+  // connect face nodes (find trace indices)
+  ConnectFaceNodes();
+
+  // compute surface geofacs
+  SurfaceGeometricFactors();
+
+  // make a global indexing
+  ParallelConnectNodes();
+
+  // make an ogs operator and label local/global gather elements
+  ParallelGatherScatterSetup();
+
+  OccaSetup();
+
+  RegisterMemory();
+}
+
+// release the host arrays, halo and gather-scatter operators, and device
+// buffers which are sized by the element partition
+void mesh_t::FreePartitionData() {
+
+  if (halo) halo->Free();
+  if (ogs) ogs->Free();
+  halo = NULL;
+  ogs = NULL;
+
+  if (EToE) free(EToE);
+  if (EToF) free(EToF);
+  if (EToP) free(EToP);
+  if (EToB) free(EToB);
+  if (internalElementIds) free(internalElementIds);
+  if (haloElementIds) free(haloElementIds);
+  if (globalGatherElementList) free(globalGatherElementList);
+  if (localGatherElementList) free(localGatherElementList);
+  if (globalIds) free(globalIds);
+  if (x) free(x);
+  if (y) free(y);
+  if (z) free(z);
+  if (vgeo) free(vgeo);
+  if (sgeo) free(sgeo);
+  if (ggeo) free(ggeo);
+  if (vmapM) free(vmapM);
+  if (vmapP) free(vmapP);
+  if (mapP) free(mapP);
+
+  EToE = NULL; EToF = NULL; EToP = NULL; EToB = NULL;
+  internalElementIds = NULL; haloElementIds = NULL;
+  globalGatherElementList = NULL; localGatherElementList = NULL;
+  globalIds = NULL;
+  x = NULL; y = NULL; z = NULL;
+  vgeo = NULL; sgeo = NULL; ggeo = NULL;
+  vmapM = NULL; vmapP = NULL; mapP = NULL;
+
+  if (o_internalElementIds.size()) o_internalElementIds.free();
+  if (o_haloElementIds.size()) o_haloElementIds.free();
+  if (o_globalGatherElementList.size()) o_globalGatherElementList.free();
+  if (o_localGatherElementList.size()) o_localGatherElementList.free();
+
+  // nodal traces alias vmapM/vmapP
+  if (compactTrace) {
+    if (o_traceM.size()) o_traceM.free();
+    if (o_traceP.size()) o_traceP.free();
+  }
+  o_traceM = occa::memory();
+  o_traceP = occa::memory();
+
+  if (o_vmapM.size()) o_vmapM.free();
+  if (o_vmapP.size()) o_vmapP.free();
+  if (o_mapP.size()) o_mapP.free();
+  if (o_EToB.size()) o_EToB.free();
+  if (o_x.size()) o_x.free();
+  if (o_y.size()) o_y.free();
+  if (o_z.size()) o_z.free();
+  if (o_vgeo.size()) o_vgeo.free();
+  if (o_sgeo.size()) o_sgeo.free();
+  if (o_ggeo.size()) o_ggeo.free();
+}
@@ -26,7 +26,8 @@ SOFTWARE.
 
 #include "mesh.hpp"
 
-void mesh_t::MultiRateSetup(dfloat *EToDT) {
+//assign a multirate level to each element from its time step estimate
+void mesh_t::MultiRateLevels(dfloat *EToDT) {
 
   const int maxLevels = 100;
 
@@ -42,12 +43,7 @@ void mesh_t::MultiRateSetup(dfloat *EToDT) {
   }
   dfloat dtGmin, dtGmax;
   MPI_Allreduce(&dtmin, &dtGmin, 1, MPI_DFLOAT, MPI_MIN, comm);
-  MPI_Allreduce(&dtmax, &dtGmax, 1, MPI_DFLOAT, MPI_MIN, comm);
-
-  if (rank==0) {
-    printf("--------------- MultiRate Timestepping Setup ----------------\n");
-    printf("-------------------------------------------------------------\n");
-  }
+  MPI_Allreduce(&dtmax, &dtGmax, 1, MPI_DFLOAT, MPI_MAX, comm);
 
   //number of levels
   mrNlevels = mymin(floor(log2(dtGmax/dtGmin))+1,maxLevels);
@@ -87,6 +83,17 @@ void mesh_t::MultiRateSetup(dfloat *EToDT) {
 
   int localNlevels = mrNlevels;
   MPI_Allreduce(&localNlevels, &mrNlevels, 1, MPI_INT, MPI_MAX, comm);
+}
+
+void mesh_t::MultiRateSetup(dfloat *EToDT) {
+
+  if (rank==0) {
+    printf("--------------- MultiRate Timestepping Setup ----------------\n");
+    printf("-------------------------------------------------------------\n");
+  }
+
+  //compute the level of each element
+  MultiRateLevels(EToDT);
 
   //construct element and halo lists
   // mrElements[lev] - list of all elements with multirate level <= lev
@@ -25,6 +25,8 @@ SOFTWARE.
 */
 
 #include "mesh.hpp"
+#include "mesh/mesh3D.hpp"
+#include <random>
 
 void mesh_t::OccaSetup(){
 
@@ -59,4 +61,166 @@ void mesh_t::OccaSetup(){
   props["defines/" "p_Nvgeo"]= Nvgeo;
   props["defines/" "p_Nsgeo"]= Nsgeo;
   props["defines/" "p_Nggeo"]= Nggeo;
+
+  //storage type of geometric factors
+  if (FloatGeometricFactors()) {
+    props["defines/" "gfloat"]= "float";
+    if (!sharedGeometricFactors) GeometricFactorAccuracyCheck();
+  } else {
+    props["defines/" "gfloat"]= dfloatString;
+  }
+
+  TraceSetup();
+}
+
+//geometric factors are stored in float when requested and dfloat is wider
+bool mesh_t::FloatGeometricFactors(){
+  return settings.compareSetting("GEOMETRIC FACTOR PRECISION","FLOAT")
+         && sizeof(dfloat)>sizeof(float);
+}
+
+//upload geometric factors in their storage type. Kernels load them as
+// gfloat and upcast to dfloat in registers
+occa::memory mesh_t::MallocGeometricFactors(size_t Nentries, const dfloat *geo){
+
+  if (!FloatGeometricFactors())
+    return platform.malloc(Nentries*sizeof(dfloat), geo);
+
+  float *fgeo = (float*) malloc(Nentries*sizeof(float));
+  for (size_t n=0;n<Nentries;n++)
+    fgeo[n] = (float) geo[n];
+
+  occa::memory o_geo = platform.malloc(Nentries*sizeof(float), fgeo);
+  free(fgeo);
+
+  return o_geo;
+}
+
+//apply the stiffness plus mass operator Aq = Sq + Mq built from the second
+// order geometric factors G, laid out like ggeo
+void mesh_t::GeometricFactorAx(const dfloat *G, const dfloat *q, dfloat *Aq){
+
+  //reference dimension (surface meshes use the 2D reference element)
+  const int rdim = (elementType==TRIANGLES || elementType==QUADRILATERALS) ? 2 : 3;
+
+  //offsets of the symmetric factor G(a,b)
+  const int Gid[3][3] = {{G00ID, G01ID, G02ID},
+                         {G01ID, G11ID, G12ID},
+                         {G02ID, G12ID, G22ID}};
+
+  if (elementType==QUADRILATERALS || elementType==HEXAHEDRA) {
+    //factors are stored per node: Aq = D^T G D q + JW q
+    const int stride[3] = {1, Nq, Nq*Nq};
+    dfloat *flux = (dfloat*) malloc(rdim*Np*sizeof(dfloat));
+
+    for (dlong e=0;e<Nelements;e++) {
+      const dfloat *Ge = G + e*Np*Nggeo;
+      const dfloat *qe = q + e*Np;
+      dfloat *Aqe = Aq + e*Np;
+
+      for (int n=0;n<Np;n++) {
+        dfloat grad[3] = {0.0, 0.0, 0.0};
+        for (int a=0;a<rdim;a++) {
+          const int i = (n/stride[a])%Nq;
+          for (int m=0;m<Nq;m++)
+            grad[a] += D[i*Nq+m]*qe[n+(m-i)*stride[a]];
+        }
+        for (int a=0;a<rdim;a++) {
+          flux[a*Np+n] = 0.0;
+          for (int b=0;b<rdim;b++)
+            flux[a*Np+n] += Ge[n+Np*Gid[a][b]]*grad[b];
+        }
+      }
+
+      for (int n=0;n<Np;n++) {
+        dfloat res = Ge[n+Np*GWJID]*qe[n];
+        for (int a=0;a<rdim;a++) {
+          const int i = (n/stride[a])%Nq;
+          for (int m=0;m<Nq;m++)
+            res += D[m*Nq+i]*flux[a*Np+n+(m-i)*stride[a]];
+        }
+        Aqe[n] = res;
+      }
+    }
+    free(flux);
+
+  } else {
+    //affine elements store one set of factors per element:
+    // Aq = sum G(a,b) S(a,b) q + J MM q. The off-diagonal S are symmetrized
+    const dfloat *Sab[3][3] = {{Srr, Srs, nullptr},
+                               {Srs, Sss, nullptr},
+                               {nullptr, nullptr, nullptr}};
+    if (rdim==3) {
+      Sab[0][2] = Sab[2][0] = Srt;
+      Sab[1][2] = Sab[2][1] = Sst;
+      Sab[2][2] = Stt;
+    }
+
+    for (dlong e=0;e<Nelements;e++) {
+      const dfloat *Ge = G + e*Nggeo;
+      const dfloat *qe = q + e*Np;
+      dfloat *Aqe = Aq + e*Np;
+
+      for (int n=0;n<Np;n++) {
+        dfloat res = 0.0;
+        for (int m=0;m<Np;m++) {
+          dfloat Anm = Ge[GWJID]*MM[n*Np+m];
+          for (int a=0;a<rdim;a++)
+            for (int b=a;b<rdim;b++)
+              Anm += Ge[Gid[a][b]]*Sab[a][b][n*Np+m];
+          res += Anm*qe[m];
+        }
+        Aqe[n] = res;
+      }
+    }
+  }
+}
+
+//float storage rounds each factor to about 6e-8 relative, but the operator
+// error can be much larger when the factors cancel (e.g. badly shaped or
+// stretched elements). Compare Ax of a random vector with the factors in
+// dfloat and rounded to float, and abort if the relative error exceeds tol
+void mesh_t::GeometricFactorAccuracyCheck(){
+
+  const dfloat tol = 1.0e-5;
+
+  const dlong Nggeos = (elementType==QUADRILATERALS || elementType==HEXAHEDRA)
+                      ? Nelements*Np*Nggeo : Nelements*Nggeo;
+
+  dfloat *fggeo = (dfloat*) malloc(Nggeos*sizeof(dfloat));
+  for (dlong n=0;n<Nggeos;n++)
+    fggeo[n] = (dfloat) ((float) ggeo[n]);
+
+  //seeded per rank so the check is reproducible
+  std::mt19937 rng(1234+rank);
+  std::uniform_real_distribution<dfloat> dist(-1.0, 1.0);
+
+  dfloat *q   = (dfloat*) malloc(Nelements*Np*sizeof(dfloat));
+  dfloat *Aq  = (dfloat*) malloc(Nelements*Np*sizeof(dfloat));
+  dfloat *fAq = (dfloat*) malloc(Nelements*Np*sizeof(dfloat));
+  for (dlong n=0;n<Nelements*Np;n++)
+    q[n] = dist(rng);
+
+  GeometricFactorAx(ggeo,  q, Aq);
+  GeometricFactorAx(fggeo, q, fAq);
+
+  dfloat norms[2] = {0.0, 0.0};
+  for (dlong n=0;n<Nelements*Np;n++) {
+    norms[0] += (fAq[n]-Aq[n])*(fAq[n]-Aq[n]);
+    norms[1] += Aq[n]*Aq[n];
+  }
+
+  dfloat globalNorms[2];
+  MPI_Allreduce(norms, globalNorms, 2, MPI_DFLOAT, MPI_SUM, comm);
+
+  const dfloat err = (globalNorms[1]>0.0) ? sqrt(globalNorms[0]/globalNorms[1]) : 0.0;
+
+  free(fggeo); free(q); free(Aq); free(fAq);
+
+  if (!(err<=tol)) {
+    std::stringstream ss;
+    ss << "Float geometric factors change Ax by a relative error of " << err
+       << " (tolerance " << tol << "). Use GEOMETRIC FACTOR PRECISION = DFLOAT";
+    LIBP_ABORT(ss.str());
+  }
 }
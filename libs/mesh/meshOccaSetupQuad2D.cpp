@@ -38,7 +38,7 @@ void meshQuad2D::OccaSetup(){
   o_sM   = o_D; //dummy
   o_LIFT = o_D; //dummy
 
-  o_vgeo = platform.malloc((Nelements+totalHaloPairs)*Nvgeo*Np*sizeof(dfloat), vgeo);
-  o_sgeo = platform.malloc(Nelements*Nfaces*Nfp*Nsgeo*sizeof(dfloat), sgeo);
-  o_ggeo = platform.malloc(Nelements*Np*Nggeo*sizeof(dfloat), ggeo);
+  o_vgeo = MallocGeometricFactors((Nelements+totalHaloPairs)*Nvgeo*Np, vgeo);
+  o_sgeo = MallocGeometricFactors(Nelements*Nfaces*Nfp*Nsgeo, sgeo);
+  o_ggeo = MallocGeometricFactors(Nelements*Np*Nggeo, ggeo);
 }
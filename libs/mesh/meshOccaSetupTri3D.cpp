@@ -61,9 +61,9 @@ void meshTri3D::OccaSetup(){
 
   o_S = platform.malloc(3*Np*Np*sizeof(dfloat), ST);
 
-  o_vgeo = platform.malloc((Nelements+totalHaloPairs)*Nvgeo*sizeof(dfloat), vgeo);
-  o_sgeo = platform.malloc(Nelements*Nfaces*Nsgeo*sizeof(dfloat), sgeo);
-  o_ggeo = platform.malloc(Nelements*Nggeo*sizeof(dfloat), ggeo);
+  o_vgeo = MallocGeometricFactors((Nelements+totalHaloPairs)*Nvgeo, vgeo);
+  o_sgeo = MallocGeometricFactors(Nelements*Nfaces*Nsgeo, sgeo);
+  o_ggeo = MallocGeometricFactors(Nelements*Nggeo, ggeo);
 
   free(DT);
   free(LIFTT);
@@ -25,9 +25,125 @@ SOFTWARE.
 */
 
 #include "mesh.hpp"
+#include "mesh/meshHierarchy.hpp"
 
+typedef struct {
+  hlong v[4];      // sorted global ids of the vertices the node depends on
+  hlong gid;       // candidate global label
+  dlong id;        // local node id
+  int idx;         // position of the node on its edge or face
+  int rank;        // originating rank
+}parallelNode_t;
+
+typedef struct {
+  dfloat w[4];     // weights, ordered by global vertex id
+  int n;           // reference node
+}entityNode_t;
+
+static const dfloat NODETOL = 1.0e-5;
+
+// evaluate the linear vertex shape functions of the element at (r,s,t)
+static void vertexWeights(int elementType, dfloat r, dfloat s, dfloat t,
+                          dfloat *w){
+  switch(elementType){
+  case TRIANGLES:
+    w[0] = -0.5*(r+s);
+    w[1] =  0.5*(1+r);
+    w[2] =  0.5*(1+s);
+    break;
+  case QUADRILATERALS:
+    w[0] = 0.25*(1-r)*(1-s);
+    w[1] = 0.25*(1+r)*(1-s);
+    w[2] = 0.25*(1+r)*(1+s);
+    w[3] = 0.25*(1-r)*(1+s);
+    break;
+  case TETRAHEDRA:
+    w[0] = -0.5*(1+r+s+t);
+    w[1] =  0.5*(1+r);
+    w[2] =  0.5*(1+s);
+    w[3] =  0.5*(1+t);
+    break;
+  case HEXAHEDRA:
+    w[0] = 0.125*(1-r)*(1-s)*(1-t);
+    w[1] = 0.125*(1+r)*(1-s)*(1-t);
+    w[2] = 0.125*(1+r)*(1+s)*(1-t);
+    w[3] = 0.125*(1-r)*(1+s)*(1-t);
+    w[4] = 0.125*(1-r)*(1-s)*(1+t);
+    w[5] = 0.125*(1+r)*(1-s)*(1+t);
+    w[6] = 0.125*(1+r)*(1+s)*(1+t);
+    w[7] = 0.125*(1-r)*(1+s)*(1+t);
+    break;
+  }
+}
+
+// find the vertices reference node (r,s,t) depends on, and its weights with
+//  respect to them. Returns the number of vertices
+static int nodeSupport(int elementType, int Nverts, dfloat r, dfloat s, dfloat t,
+                       int *verts, dfloat *weights){
+
+  dfloat vw[8];
+  vertexWeights(elementType, r, s, t, vw);
+
+  int cnt = 0;
+  for(int v=0;v<Nverts;++v){
+    if(fabs(vw[v])>NODETOL){
+      if(cnt<4){
+        verts[cnt] = v;
+        weights[cnt] = vw[v];
+      }
+      ++cnt;
+    }
+  }
+  for(int i=cnt;i<4;++i){
+    verts[i] = -1;
+    weights[i] = 0.0;
+  }
+  return cnt;
+}
+
+// order the nodes of an element edge or face by their weights with respect
+//  to its vertices sorted by global id, which is the same in every element
+//  sharing it. The sorted vertex ids are returned in v
+static void orderEntityNodes(const hlong *elementVerts, const int *verts,
+                             const int *nodeList, const int Nnodes,
+                             const dfloat *nodeWeights,
+                             hlong *v, entityNode_t *nodes){
+
+  std::pair<hlong,int> sorted[4];
+  int cnt = 0;
+  for(int i=0;i<4;++i){
+    if(verts[i]<0) break;
+    sorted[cnt] = std::make_pair(elementVerts[verts[i]], i);
+    ++cnt;
+  }
+  std::sort(sorted, sorted+cnt);
+
+  for(int i=0;i<4;++i)
+    v[i] = (i<cnt) ? sorted[i].first : -1;
+
+  for(int m=0;m<Nnodes;++m){
+    const int n = nodeList[m];
+    for(int i=0;i<4;++i)
+      nodes[m].w[i] = (i<cnt) ? nodeWeights[n*4+sorted[i].second] : 0.0;
+    nodes[m].n = n;
+  }
+
+  //weights closer than NODETOL are equal, so round-off cannot reorder nodes
+  std::sort(nodes, nodes+Nnodes,
+            [](const entityNode_t& a, const entityNode_t& b) {
+              for(int i=0;i<4;++i)
+                if(fabs(a.w[i]-b.w[i])>NODETOL) return a.w[i] < b.w[i];
+              return false;
+            });
+}
 
 // uniquely label each node with a global index, used for gatherScatter
+//  Every node shared between elements lies on a vertex, edge, or face of
+//  the element and is identified globally by the vertices of that entity
+//  and its position on it. Nodes are sent to a rank chosen from that key,
+//  matched by sorting, and given the smallest candidate label in their
+//  group. This needs a fixed number of communication rounds, instead of one
+//  halo exchange per graph distance.
 void mesh_t::ParallelConnectNodes(){
 
   hlong localNodeCount = Np*Nelements;
@@ -44,19 +160,16 @@ void mesh_t::ParallelConnectNodes(){
   free(allLocalNodeCounts);
 
   // form continuous node numbering (local=>virtual gather)
-  int *baseRank = (int *) malloc((totalHaloPairs+Nelements)*Np*sizeof(int));
   globalIds = (hlong *) malloc((totalHaloPairs+Nelements)*Np*sizeof(hlong));
 
   // use local numbering
   for(dlong e=0;e<Nelements;++e){
     for(int n=0;n<Np;++n){
       dlong id = e*Np+n;
-
-      baseRank[id] = rank;
       globalIds[id] = 1 + id + Nnodes + gatherNodeStart;
     }
 
-    // use vertex ids for vertex nodes to reduce iterations
+    // vertex nodes are labelled directly by their vertex ids
     for(int v=0;v<Nverts;++v){
       hlong id = e*Np + vertexNodes[v];
       hlong gid = EToV[e*Nverts+v] + 1;
@@ -64,47 +177,322 @@ void mesh_t::ParallelConnectNodes(){
     }
   }
 
-  hlong localChange = 0, gatherChange = 1;
+  // group the reference nodes on edges and faces by the vertices they depend
+  // on. Vertex nodes and interior nodes, which depend on all element
+  // vertices, belong to no entity and keep their labels
+  int    *nodeEntity  = (int*) malloc(Np*sizeof(int));
+  dfloat *nodeWeights = (dfloat*) calloc(Np*4, sizeof(dfloat));
+  int    *entityVerts = (int*) malloc(Np*4*sizeof(int));
+  int    *entityStarts = (int*) calloc(Np+1, sizeof(int));
+  int Nentities = 0;
+
+  for(int n=0;n<Np;++n){
+    nodeEntity[n] = -1;
+
+    const dfloat tn = (elementType==TETRAHEDRA || elementType==HEXAHEDRA) ? t[n] : 0.0;
+    int verts[4];
+    const int cnt = nodeSupport(elementType, Nverts, r[n], s[n], tn,
+                                verts, nodeWeights+n*4);
+
+    if(cnt<2 || cnt==Nverts || cnt>4) continue;
+
+    int k = 0;
+    while(k<Nentities && !std::equal(verts, verts+4, entityVerts+k*4)) ++k;
+    if(k==Nentities){
+      std::copy(verts, verts+4, entityVerts+k*4);
+      ++Nentities;
+    }
+    nodeEntity[n] = k;
+    ++entityStarts[k+1];
+  }
+
+  // lists of the reference nodes on each entity
+  int NentityNodes = 0;
+  for(int k=0;k<Nentities;++k){
+    NentityNodes = mymax(NentityNodes, entityStarts[k+1]);
+    entityStarts[k+1] += entityStarts[k];
+  }
+
+  int *entityNodeList = (int*) calloc(mymax(entityStarts[Nentities],1), sizeof(int));
+  int *entityCnt = (int*) calloc(mymax(Nentities,1), sizeof(int));
+  for(int n=0;n<Np;++n){
+    const int k = nodeEntity[n];
+    if(k<0) continue;
+    entityNodeList[entityStarts[k] + entityCnt[k]++] = n;
+  }
+  free(entityCnt);
+
+  int *Nsend = (int*) calloc(size, sizeof(int));
+  int *Nrecv = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size, sizeof(int));
+  int *recvOffsets = (int*) calloc(size, sizeof(int));
+
+  // count # of nodes to send to each rank based on max(entity vertices)%size
+  int allNsend = 0;
+  for(dlong e=0;e<Nelements;++e){
+    for(int k=0;k<Nentities;++k){
+      hlong maxv = 0;
+      for(int i=0;i<4 && entityVerts[k*4+i]>=0;++i)
+        maxv = mymax(maxv, EToV[e*Nverts+entityVerts[k*4+i]]);
+
+      const int NkNodes = entityStarts[k+1]-entityStarts[k];
+      Nsend[maxv%size] += NkNodes;
+      allNsend += NkNodes;
+    }
+  }
+
+  // find send offsets
+  for(int rr=1;rr<size;++rr)
+    sendOffsets[rr] = sendOffsets[rr-1] + Nsend[rr-1];
+
+  // reset counters
+  for(int rr=0;rr<size;++rr)
+    Nsend[rr] = 0;
+
+  // buffer for outgoing data
+  parallelNode_t *sendNodes = (parallelNode_t*) calloc(allNsend, sizeof(parallelNode_t));
+
+  // Make the MPI_PARALLELNODE_T data type
+  MPI_Datatype MPI_PARALLELNODE_T;
+  MPI_Datatype dtype[5] = {MPI_HLONG, MPI_HLONG, MPI_DLONG, MPI_INT, MPI_INT};
+  int blength[5] = {4, 1, 1, 1, 1};
+  MPI_Aint addr[5], displ[5];
+  parallelNode_t dummy;
+  MPI_Get_address ( &(dummy      ), addr+0);
+  MPI_Get_address ( &(dummy.gid  ), addr+1);
+  MPI_Get_address ( &(dummy.id   ), addr+2);
+  MPI_Get_address ( &(dummy.idx  ), addr+3);
+  MPI_Get_address ( &(dummy.rank ), addr+4);
+  displ[0] = 0;
+  displ[1] = addr[1] - addr[0];
+  displ[2] = addr[2] - addr[0];
+  displ[3] = addr[3] - addr[0];
+  displ[4] = addr[4] - addr[0];
+  MPI_Type_create_struct (5, blength, displ, dtype, &MPI_PARALLELNODE_T);
+  MPI_Type_commit (&MPI_PARALLELNODE_T);
+
+  // pack node data, keyed on the sorted entity vertices and the position
+  // of the node on the entity
+  entityNode_t *nodes = (entityNode_t*) calloc(mymax(NentityNodes,1), sizeof(entityNode_t));
+
+  for(dlong e=0;e<Nelements;++e){
+    for(int k=0;k<Nentities;++k){
+      const int NkNodes = entityStarts[k+1]-entityStarts[k];
+
+      hlong v[4];
+      orderEntityNodes(EToV+e*Nverts, entityVerts+k*4,
+                       entityNodeList+entityStarts[k], NkNodes,
+                       nodeWeights, v, nodes);
+
+      int cnt = 0;
+      while(cnt<4 && v[cnt]>=0) ++cnt;
+      const int destRank = (int) (v[cnt-1]%size);
+
+      for(int m=0;m<NkNodes;++m){
+        const int id = sendOffsets[destRank]+Nsend[destRank];
+
+        for(int i=0;i<4;++i)
+          sendNodes[id].v[i] = v[i];
+        sendNodes[id].gid  = globalIds[e*Np+nodes[m].n];
+        sendNodes[id].id   = e*Np+nodes[m].n;
+        sendNodes[id].idx  = m;
+        sendNodes[id].rank = rank;
+
+        ++Nsend[destRank];
+      }
+    }
+  }
+
+  free(nodes);
+  free(nodeEntity);
+  free(nodeWeights);
+  free(entityVerts);
+  free(entityStarts);
+  free(entityNodeList);
+
+  // exchange byte counts
+  MPI_Alltoall(Nsend, 1, MPI_INT,
+               Nrecv, 1, MPI_INT,
+               comm);
 
-  // keep comparing numbers on positive and negative traces until convergence
-  while(gatherChange>0){
+  // count incoming nodes
+  int allNrecv = 0;
+  for(int rr=0;rr<size;++rr)
+    allNrecv += Nrecv[rr];
 
-    // reset change counter
-    localChange = 0;
+  // find offsets for recv data
+  for(int rr=1;rr<size;++rr)
+    recvOffsets[rr] = recvOffsets[rr-1] + Nrecv[rr-1];
 
-    // send halo data and recv into extension of buffer
-    halo->Exchange(baseRank, Np, ogs_int);
-    halo->Exchange(globalIds, Np, ogs_hlong);
+  // buffer for incoming node data
+  parallelNode_t *recvNodes = (parallelNode_t*) calloc(allNrecv, sizeof(parallelNode_t));
 
-    // compare trace nodes
-    for(dlong e=0;e<Nelements;++e){
-      for(int n=0;n<Nfp*Nfaces;++n){
-        dlong id  = e*Nfp*Nfaces + n;
-        dlong idM = vmapM[id];
-        dlong idP = vmapP[id];
-        hlong gidM = globalIds[idM];
-        hlong gidP = globalIds[idP];
+  // exchange shared nodes
+  MPI_Alltoallv(sendNodes, Nsend, sendOffsets, MPI_PARALLELNODE_T,
+                recvNodes, Nrecv, recvOffsets, MPI_PARALLELNODE_T,
+                comm);
 
-        int baseRankM = baseRank[idM];
-        int baseRankP = baseRank[idP];
+  // local sort allNrecv received nodes by key
+  auto sameKey = [](const parallelNode_t& a, const parallelNode_t& b) {
+    return std::equal(a.v, a.v+4, b.v) && a.idx==b.idx;
+  };
+  std::sort(recvNodes, recvNodes+allNrecv,
+            [](const parallelNode_t& a, const parallelNode_t& b) {
+              if(std::lexicographical_compare(a.v, a.v+4, b.v, b.v+4)) return true;
+              if(std::lexicographical_compare(b.v, b.v+4, a.v, a.v+4)) return false;
+              return a.idx < b.idx;
+            });
 
-        if(gidM<gidP || (gidP==gidM && baseRankM<baseRankP)){
-          ++localChange;
-          baseRank[idP]  = baseRank[idM];
-          globalIds[idP] = globalIds[idM];
-        }
+  // give every node in a group the smallest label in the group
+  int start = 0;
+  while(start<allNrecv){
+    int end = start+1;
+    while(end<allNrecv && sameKey(recvNodes[start], recvNodes[end])) ++end;
 
-        if(gidP<gidM || (gidP==gidM && baseRankP<baseRankM)){
-          ++localChange;
-          baseRank[idM]  = baseRank[idP];
-          globalIds[idM] = globalIds[idP];
-        }
+    hlong gid = recvNodes[start].gid;
+    for(int n=start+1;n<end;++n)
+      gid = mymin(gid, recvNodes[n].gid);
+    for(int n=start;n<end;++n)
+      recvNodes[n].gid = gid;
+
+    start = end;
+  }
+
+  // sort back to original ordering
+  std::sort(recvNodes, recvNodes+allNrecv,
+            [](const parallelNode_t& a, const parallelNode_t& b) {
+              if(a.rank < b.rank) return true;
+              if(a.rank > b.rank) return false;
+
+              return (a.id < b.id);
+            });
+
+  // send nodes back from whence they came
+  MPI_Alltoallv(recvNodes, Nrecv, recvOffsets, MPI_PARALLELNODE_T,
+                sendNodes, Nsend, sendOffsets, MPI_PARALLELNODE_T,
+                comm);
+
+  // extract global labels
+  for(int cnt=0;cnt<allNsend;++cnt)
+    globalIds[sendNodes[cnt].id] = sendNodes[cnt].gid;
+
+  MPI_Barrier(comm);
+  MPI_Type_free(&MPI_PARALLELNODE_T);
+  free(sendNodes);
+  free(recvNodes);
+  free(Nsend);
+  free(Nrecv);
+  free(sendOffsets);
+  free(recvOffsets);
+
+  // fill halo copies of the labels
+  halo->Exchange(globalIds, Np, ogs_hlong);
+}
+
+// uniquely label each node from the global vertex, edge, and face ids of a
+//  mesh hierarchy. The nodes on an edge or face are ordered by their weights
+//  with respect to its vertices sorted by global id, which is the same in
+//  every element sharing it, so no communication is needed to match nodes
+void mesh_t::ParallelConnectNodes(meshHierarchy_t& meshHierarchy){
+
+  const int Nentities = meshHierarchy.Nentities;
+  const int *entityVerts = meshHierarchy.entityVerts;
+
+  // find the edge or face of each reference node, and its weights with
+  // respect to the entity vertices. Vertex and interior nodes have no entity
+  int    *nodeEntity  = (int*) malloc(Np*sizeof(int));
+  dfloat *nodeWeights = (dfloat*) calloc(Np*4, sizeof(dfloat));
+  int    *entityStarts = (int*) calloc(Nentities+1, sizeof(int));
+
+  for(int n=0;n<Np;++n){
+    nodeEntity[n] = -1;
+
+    const dfloat tn = (elementType==TETRAHEDRA || elementType==HEXAHEDRA) ? t[n] : 0.0;
+    int verts[4];
+    const int cnt = nodeSupport(elementType, Nverts, r[n], s[n], tn,
+                                verts, nodeWeights+n*4);
+
+    if(cnt<2 || cnt==Nverts || cnt>4) continue;
+
+    for(int k=0;k<Nentities;++k){
+      if(std::equal(verts, verts+4, entityVerts+k*4)){
+        nodeEntity[n] = k;
+        ++entityStarts[k+1];
+        break;
       }
     }
 
-    // sum up changes
-    MPI_Allreduce(&localChange, &gatherChange, 1, MPI_HLONG, MPI_MAX, comm);
+    if(nodeEntity[n]<0) {
+      stringstream ss;
+      ss << "Reference node " << n << " is not on an element edge or face";
+      LIBP_ABORT(ss.str())
+    }
   }
 
-  free(baseRank);
+  // lists of the reference nodes on each entity
+  int NentityNodes = 0;
+  for(int k=0;k<Nentities;++k){
+    NentityNodes = mymax(NentityNodes, entityStarts[k+1]);
+    entityStarts[k+1] += entityStarts[k];
+  }
+
+  int *entityNodeList = (int*) calloc(mymax(entityStarts[Nentities],1), sizeof(int));
+  int *entityCnt = (int*) calloc(Nentities, sizeof(int));
+  for(int n=0;n<Np;++n){
+    const int k = nodeEntity[n];
+    if(k<0) continue;
+    entityNodeList[entityStarts[k] + entityCnt[k]++] = n;
+  }
+  free(entityCnt);
+
+  // label ranges: vertices, then edge/face nodes, then element interiors
+  hlong localNodeCount = Np*Nelements;
+  hlong gatherNodeStart = 0;
+  MPI_Exscan(&localNodeCount, &gatherNodeStart, 1, MPI_HLONG, MPI_SUM, comm);
+  if(rank==0) gatherNodeStart = 0;
+
+  const hlong entityNodeStart   = 1 + Nnodes;
+  const hlong interiorNodeStart = entityNodeStart + meshHierarchy.NentitiesGlobal*NentityNodes
+                                 + gatherNodeStart;
+
+  globalIds = (hlong *) malloc((totalHaloPairs+Nelements)*Np*sizeof(hlong));
+
+  entityNode_t *nodes = (entityNode_t*) calloc(mymax(NentityNodes,1), sizeof(entityNode_t));
+
+  for(dlong e=0;e<Nelements;++e){
+    for(int n=0;n<Np;++n){
+      const dlong id = e*Np+n;
+      globalIds[id] = interiorNodeStart + id;
+    }
+
+    // vertex nodes are labelled directly by their vertex ids
+    for(int v=0;v<Nverts;++v){
+      const dlong id = e*Np + vertexNodes[v];
+      globalIds[id] = EToV[e*Nverts+v] + 1;
+    }
+
+    for(int k=0;k<Nentities;++k){
+      const int NkNodes = entityStarts[k+1]-entityStarts[k];
+      if(NkNodes==0) continue;
+
+      hlong v[4];
+      orderEntityNodes(EToV+e*Nverts, entityVerts+k*4,
+                       entityNodeList+entityStarts[k], NkNodes,
+                       nodeWeights, v, nodes);
+
+      const hlong entityStart = entityNodeStart
+                              + meshHierarchy.entityIds[e*Nentities+k]*NentityNodes;
+      for(int m=0;m<NkNodes;++m)
+        globalIds[e*Np+nodes[m].n] = entityStart + m;
+    }
+  }
+
+  free(nodes);
+  free(nodeEntity);
+  free(nodeWeights);
+  free(entityStarts);
+  free(entityNodeList);
+
+  // fill halo copies of the labels
+  halo->Exchange(globalIds, Np, ogs_hlong);
 }
@@ -33,7 +33,7 @@ void meshHex3D::PhysicalNodes(){
   y = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
   z = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
 
-  dlong cnt = 0;
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     dlong id = e*Nverts;
@@ -65,8 +65,11 @@ void meshHex3D::PhysicalNodes(){
     dfloat ze7 = EZ[id+6];
     dfloat ze8 = EZ[id+7];
 
+    #pragma omp simd
     for(int n=0;n<Np;++n){ /* for each node */
 
+      const dlong cnt = e*Np + n;
+
       /* (r,s,t) coordinates of interpolation nodes*/
       dfloat rn = r[n];
       dfloat sn = s[n];
@@ -102,8 +105,6 @@ void meshHex3D::PhysicalNodes(){
         +0.125*(1+rn)*(1-sn)*(1+tn)*ze6
         +0.125*(1+rn)*(1+sn)*(1+tn)*ze7
         +0.125*(1-rn)*(1+sn)*(1+tn)*ze8;
-
-      ++cnt;
     }
   }
 
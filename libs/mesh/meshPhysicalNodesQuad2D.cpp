@@ -33,7 +33,7 @@ void meshQuad2D::PhysicalNodes(){
   y = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
   z = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
 
-  dlong cnt = 0;
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     dlong id = e*Nverts;
@@ -48,8 +48,11 @@ void meshQuad2D::PhysicalNodes(){
     dfloat ye3 = EY[id+2];
     dfloat ye4 = EY[id+3];
 
+    #pragma omp simd
     for(int n=0;n<Np;++n){ /* for each node */
 
+      const dlong cnt = e*Np + n;
+
       /* (r,s) coordinates of interpolation nodes*/
       dfloat rn = r[n];
       dfloat sn = s[n];
@@ -66,8 +69,6 @@ void meshQuad2D::PhysicalNodes(){
         +0.25*(1+rn)*(1-sn)*ye2
         +0.25*(1+rn)*(1+sn)*ye3
         +0.25*(1-rn)*(1+sn)*ye4;
-
-      ++cnt;
     }
   }
 
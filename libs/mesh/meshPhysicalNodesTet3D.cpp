@@ -33,7 +33,7 @@ void meshTet3D::PhysicalNodes(){
   y = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
   z = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
 
-  dlong cnt = 0;
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     dlong id = e*Nverts;
@@ -53,8 +53,11 @@ void meshTet3D::PhysicalNodes(){
     dfloat ze3 = EZ[id+2];
     dfloat ze4 = EZ[id+3];
 
+    #pragma omp simd
     for(int n=0;n<Np;++n){ /* for each node */
 
+      const dlong cnt = e*Np + n;
+
       /* (r,s,t) coordinates of interpolation nodes*/
       dfloat rn = r[n];
       dfloat sn = s[n];
@@ -64,7 +67,6 @@ void meshTet3D::PhysicalNodes(){
       x[cnt] = -0.5*(1+rn+sn+tn)*xe1 + 0.5*(1+rn)*xe2 + 0.5*(1+sn)*xe3 + 0.5*(1+tn)*xe4;
       y[cnt] = -0.5*(1+rn+sn+tn)*ye1 + 0.5*(1+rn)*ye2 + 0.5*(1+sn)*ye3 + 0.5*(1+tn)*ye4;
       z[cnt] = -0.5*(1+rn+sn+tn)*ze1 + 0.5*(1+rn)*ze2 + 0.5*(1+sn)*ze3 + 0.5*(1+tn)*ze4;
-      ++cnt;
     }
   }
 
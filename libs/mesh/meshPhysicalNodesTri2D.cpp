@@ -33,7 +33,7 @@ void meshTri2D::PhysicalNodes(){
   y = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat));
   z = (dfloat*) calloc((Nelements+totalHaloPairs)*Np,sizeof(dfloat)); // dummy
 
-  dlong cnt = 0;
+  #pragma omp parallel for
   for(dlong e=0;e<Nelements;++e){ /* for each element */
 
     dlong id = e*Nverts+0;
@@ -46,8 +46,11 @@ void meshTri2D::PhysicalNodes(){
     dfloat ye2 = EY[id+1];
     dfloat ye3 = EY[id+2];
 
+    #pragma omp simd
     for(int n=0;n<Np;++n){ /* for each node */
 
+      const dlong cnt = e*Np + n;
+
       /* (r,s) coordinates of interpolation nodes*/
       dfloat rn = r[n];
       dfloat sn = s[n];
@@ -55,7 +58,6 @@ void meshTri2D::PhysicalNodes(){
       /* physical coordinate of interpolation node */
       x[cnt] = -0.5*(rn+sn)*xe1 + 0.5*(1+rn)*xe2 + 0.5*(1+sn)*xe3;
       y[cnt] = -0.5*(rn+sn)*ye1 + 0.5*(1+rn)*ye2 + 0.5*(1+sn)*ye3;
-      ++cnt;
     }
   }
 
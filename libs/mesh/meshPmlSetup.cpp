@@ -30,6 +30,13 @@ void mesh_t::PmlSetup(){
 
   NnonPmlElements=0;
   NpmlElements=0;
+  NnonPmlInternalElements=0;
+  NpmlInternalElements=0;
+
+  //flag elements that cannot update without halo exchange
+  int *haloFlag = (int*) calloc(Nelements, sizeof(int));
+  for (dlong n=0;n<NhaloElements;n++)
+    haloFlag[haloElementIds[n]] = 1;
 
   //count PML elements
   for (dlong e=0;e<Nelements;e++) {
@@ -45,18 +52,22 @@ void mesh_t::PmlSetup(){
     // 700 - xyz PML
     if ((type==100)||(type==200)||(type==300)||
         (type==400)||(type==500)||(type==600)||
-        (type==700) )
+        (type==700) ) {
       NpmlElements++;
-    else
+      if (!haloFlag[e]) NpmlInternalElements++;
+    } else {
       NnonPmlElements++;
+      if (!haloFlag[e]) NnonPmlInternalElements++;
+    }
   }
 
   nonPmlElements = (dlong *) malloc(NnonPmlElements*sizeof(dlong));
   pmlElements    = (dlong *) malloc(NpmlElements*sizeof(dlong));
   pmlIds         = (dlong *) malloc(NpmlElements*sizeof(dlong*));
 
-  NnonPmlElements=0;
-  NpmlElements=0;
+  //internal elements fill the front of each list, halo elements the back
+  dlong pmlInternalCnt=0, pmlHaloCnt=NpmlInternalElements;
+  dlong nonPmlInternalCnt=0, nonPmlHaloCnt=NnonPmlInternalElements;
   dlong pmlCnt=0;
   for (dlong e=0;e<Nelements;e++) {
     hlong type = elementInfo[e];
@@ -64,11 +75,15 @@ void mesh_t::PmlSetup(){
     if ((type==100)||(type==200)||(type==300)||
         (type==400)||(type==500)||(type==600)||
         (type==700) ) {
-      pmlElements[NpmlElements] = e;
-      pmlIds[NpmlElements++] = pmlCnt++;
-    } else
-      nonPmlElements[NnonPmlElements++] = e;
+      dlong n = haloFlag[e] ? pmlHaloCnt++ : pmlInternalCnt++;
+      pmlElements[n] = e;
+      pmlIds[n] = pmlCnt++;
+    } else {
+      dlong n = haloFlag[e] ? nonPmlHaloCnt++ : nonPmlInternalCnt++;
+      nonPmlElements[n] = e;
+    }
   }
+  free(haloFlag);
 
   if (NpmlElements) {
     o_pmlElements = platform.malloc(NpmlElements*sizeof(dlong), pmlElements);
@@ -77,6 +92,14 @@ void mesh_t::PmlSetup(){
 
   if (NnonPmlElements)
     o_nonPmlElements = platform.malloc(NnonPmlElements*sizeof(dlong), nonPmlElements);
+
+  if (NpmlElements-NpmlInternalElements) {
+    o_pmlHaloElements = o_pmlElements + NpmlInternalElements*sizeof(dlong);
+    o_pmlHaloIds      = o_pmlIds      + NpmlInternalElements*sizeof(dlong);
+  }
+
+  if (NnonPmlElements-NnonPmlInternalElements)
+    o_nonPmlHaloElements = o_nonPmlElements + NnonPmlInternalElements*sizeof(dlong);
 }
 
 
@@ -0,0 +1,206 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include <vector>
+
+// reverse Cuthill-McKee ordering of the local element graph
+static void rcmOrdering(const dlong Nelements, const int Nfaces,
+                        const dlong *EToE, std::vector<dlong>& order){
+
+  std::vector<int> degree(Nelements, 0);
+  for(dlong e=0;e<Nelements;++e)
+    for(int f=0;f<Nfaces;++f)
+      if(EToE[e*Nfaces+f]>=0) degree[e]++;
+
+  std::vector<char> visited(Nelements, 0);
+  std::vector<dlong> level(Nelements, -1);
+  std::vector<dlong> nbrs(Nfaces);
+
+  order.clear();
+  order.reserve(Nelements);
+
+  for(dlong start=0;start<Nelements;++start){
+    if(visited[start]) continue;
+
+    // find a pseudo-peripheral root of this component by repeated
+    // breadth-first searches from the last, lowest degree, element found
+    dlong root = start;
+    dlong depth = -1;
+    for(int it=0;it<4;++it){
+      std::vector<dlong> queue(1, root);
+      level[root] = 0;
+      for(size_t head=0;head<queue.size();++head){
+        const dlong e = queue[head];
+        for(int f=0;f<Nfaces;++f){
+          const dlong eN = EToE[e*Nfaces+f];
+          if(eN>=0 && level[eN]==-1){
+            level[eN] = level[e]+1;
+            queue.push_back(eN);
+          }
+        }
+      }
+      const dlong newDepth = level[queue.back()];
+
+      dlong far = queue.back();
+      for(size_t n=0;n<queue.size();++n)
+        if(level[queue[n]]==newDepth && degree[queue[n]]<degree[far])
+          far = queue[n];
+
+      for(size_t n=0;n<queue.size();++n) level[queue[n]] = -1;
+
+      if(newDepth<=depth) break;
+      depth = newDepth;
+      root = far;
+    }
+
+    // Cuthill-McKee sweep, neighbors in order of increasing degree
+    const size_t first = order.size();
+    order.push_back(root);
+    visited[root] = 1;
+    for(size_t head=first;head<order.size();++head){
+      const dlong e = order[head];
+      int Nnbrs = 0;
+      for(int f=0;f<Nfaces;++f){
+        const dlong eN = EToE[e*Nfaces+f];
+        if(eN>=0 && !visited[eN]){
+          visited[eN] = 1;
+          nbrs[Nnbrs++] = eN;
+        }
+      }
+      std::sort(nbrs.begin(), nbrs.begin()+Nnbrs,
+                [&degree](const dlong a, const dlong b) {
+                  return degree[a] < degree[b];
+                });
+      for(int n=0;n<Nnbrs;++n) order.push_back(nbrs[n]);
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+}
+
+/* ---------------------------------------------------------
+
+Renumber the elements owned by this rank so that neighboring
+elements are close in memory. This improves the locality of
+the vmapP gathers in the surface kernels. The reordering acts
+on the element vertex data before the connectivity is built,
+so every mesh array set up afterwards uses the new numbering.
+
+HILBERT - sort by the Hilbert index of the element centers
+RCM     - reverse Cuthill-McKee ordering of the local face graph
+
+------------------------------------------------------------ */
+void mesh_t::ReorderElements(){
+
+  if (settings.compareSetting("ELEMENT ORDERING","NONE")) return;
+
+  std::vector<dlong> order;
+
+  if (settings.compareSetting("ELEMENT ORDERING","HILBERT")) {
+
+    const int bits = 20;
+
+    // local bounding box of the element vertices
+    dfloat minv[3] = { 1e9,  1e9,  1e9};
+    dfloat maxv[3] = {-1e9, -1e9, -1e9};
+    for(dlong n=0;n<Nverts*Nelements;++n){
+      minv[0] = mymin(minv[0], EX[n]); maxv[0] = mymax(maxv[0], EX[n]);
+      minv[1] = mymin(minv[1], EY[n]); maxv[1] = mymax(maxv[1], EY[n]);
+      if (dim==3) {
+        minv[2] = mymin(minv[2], EZ[n]); maxv[2] = mymax(maxv[2], EZ[n]);
+      }
+    }
+    dfloat maxlength = mymax(maxv[0]-minv[0], maxv[1]-minv[1]);
+    if (dim==3) maxlength = mymax(maxlength, maxv[2]-minv[2]);
+    maxlength *= 1.0001; //keep the largest center inside the lattice
+
+    const dfloat Nboxes = (dfloat) (1u<<bits);
+
+    std::vector<unsigned long long int> index(Nelements);
+    for(dlong e=0;e<Nelements;++e){
+      dfloat cx = 0, cy = 0, cz = 0;
+      for(int n=0;n<Nverts;++n){
+        cx += EX[e*Nverts+n];
+        cy += EY[e*Nverts+n];
+        if (dim==3) cz += EZ[e*Nverts+n];
+      }
+      cx /= Nverts;
+      cy /= Nverts;
+      cz /= Nverts;
+
+      unsigned int ix = (maxlength>0) ? (cx-minv[0])*Nboxes/maxlength : 0;
+      unsigned int iy = (maxlength>0) ? (cy-minv[1])*Nboxes/maxlength : 0;
+      unsigned int iz = (maxlength>0 && dim==3) ? (cz-minv[2])*Nboxes/maxlength : 0;
+
+      index[e] = HilbertIndex(dim, bits, ix, iy, iz);
+    }
+
+    order.resize(Nelements);
+    for(dlong e=0;e<Nelements;++e) order[e] = e;
+    std::stable_sort(order.begin(), order.end(),
+                     [&index](const dlong a, const dlong b) {
+                       return index[a] < index[b];
+                     });
+
+  } else { // RCM
+
+    // serial face connectivity of the local elements
+    Connect();
+
+    rcmOrdering(Nelements, Nfaces, EToE, order);
+
+    free(EToE);
+    free(EToF);
+  }
+
+  // permute the element vertex data
+  hlong  *newEToV = (hlong*)  malloc(Nelements*Nverts*sizeof(hlong));
+  dfloat *newEX   = (dfloat*) malloc(Nelements*Nverts*sizeof(dfloat));
+  dfloat *newEY   = (dfloat*) malloc(Nelements*Nverts*sizeof(dfloat));
+  dfloat *newEZ   = (dim==3) ? (dfloat*) malloc(Nelements*Nverts*sizeof(dfloat)) : NULL;
+  hlong  *newElementInfo = (hlong*) malloc(Nelements*sizeof(hlong));
+
+  for(dlong e=0;e<Nelements;++e){
+    const dlong eOld = order[e];
+    for(int n=0;n<Nverts;++n){
+      newEToV[e*Nverts+n] = EToV[eOld*Nverts+n];
+      newEX[e*Nverts+n]   = EX[eOld*Nverts+n];
+      newEY[e*Nverts+n]   = EY[eOld*Nverts+n];
+      if (dim==3)
+        newEZ[e*Nverts+n] = EZ[eOld*Nverts+n];
+    }
+    newElementInfo[e] = elementInfo[eOld];
+  }
+
+  free(EToV); EToV = newEToV;
+  free(EX);   EX   = newEX;
+  free(EY);   EY   = newEY;
+  if (dim==3) {
+    free(EZ); EZ = newEZ;
+  }
+  free(elementInfo); elementInfo = newElementInfo;
+}
@@ -79,6 +79,45 @@ meshSettings_t::meshSettings_t(MPI_Comm& _comm):
              "1",
              "Type of boundary conditions for BOX domain (-1 for periodic)");
 
+  newSetting("MESH PARTITIONER",
+             "GEOMETRIC",
+             "Partitioning of meshes read from file. HILBERT orders 3D meshes along a Hilbert curve instead of a Morton curve",
+             {"GEOMETRIC","HILBERT","GRAPH"});
+
+  newSetting("PARTITION WEIGHTS",
+             "UNIFORM",
+             "Element cost balanced by the GRAPH partitioner. Set by solvers with PML or multirate time integration",
+             {"UNIFORM","PML","MULTIRATE","PML+MULTIRATE"});
+
+  newSetting("ELEMENT ORDERING",
+             "NONE",
+             "Renumbering of the elements on each rank for memory locality",
+             {"NONE","HILBERT","RCM"});
+
+  newSetting("SETUP CACHE",
+             "NONE",
+             "Directory in which partitioned mesh connectivity and node numbering are cached for reuse by later runs");
+
+  newSetting("HOST MIRRORS",
+             "KEEP",
+             "Keep or release host copies of device-resident mesh data after setup",
+             {"KEEP","RELEASE"});
+
+  newSetting("TRACE CONNECTIVITY",
+             "NODAL",
+             "Face connectivity read by quad and hex surface kernels. COMPACT stores one neighbor face and orientation per element face",
+             {"NODAL","COMPACT"});
+
+  newSetting("GEOMETRIC FACTOR PRECISION",
+             "DFLOAT",
+             "Device storage precision of geometric factors. Kernels compute in dfloat",
+             {"DFLOAT","FLOAT"});
+
+  newSetting("MULTIRATE PARTITION",
+             "FALSE",
+             "Repartition the mesh to balance each multirate level across ranks. Read by multirate time integrators",
+             {"TRUE","FALSE"});
+
   newSetting("POLYNOMIAL DEGREE",
              "4",
              "Degree of polynomial finite element space",
@@ -95,6 +134,13 @@ void meshSettings_t::report() {
     if (!compareSetting("MESH FILE","BOX"))
       reportSetting("MESH FILE");
 
+    if (!compareSetting("MESH FILE","BOX") &&
+        !compareSetting("MESH FILE","PMLBOX")) {
+      reportSetting("MESH PARTITIONER");
+      if (compareSetting("MESH PARTITIONER","GRAPH"))
+        reportSetting("PARTITION WEIGHTS");
+    }
+
     reportSetting("MESH DIMENSION");
     reportSetting("ELEMENT TYPE");
 
@@ -126,6 +172,22 @@ void meshSettings_t::report() {
       reportSetting("BOX BOUNDARY FLAG");
     }
 
+    reportSetting("ELEMENT ORDERING");
+
+    if (!compareSetting("SETUP CACHE","NONE"))
+      reportSetting("SETUP CACHE");
+
+    reportSetting("HOST MIRRORS");
+
+    if (compareSetting("ELEMENT TYPE","4") ||
+        compareSetting("ELEMENT TYPE","12"))
+      reportSetting("TRACE CONNECTIVITY");
+
+    reportSetting("GEOMETRIC FACTOR PRECISION");
+
+    if (compareSetting("MULTIRATE PARTITION","TRUE"))
+      reportSetting("MULTIRATE PARTITION");
+
     reportSetting("POLYNOMIAL DEGREE");
   }
 }
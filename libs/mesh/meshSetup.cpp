@@ -65,28 +65,63 @@ mesh_t& mesh_t::Setup(platform_t& platform, meshSettings_t& settings,
 
   mesh->ringHalo = NULL;
 
-  if (settings.compareSetting("MESH FILE","PMLBOX")) {
-    //build a box mesh with a pml layer
-    mesh->SetupPmlBox();
-  } else if (settings.compareSetting("MESH FILE","BOX")) {
-    //build a box mesh
-    mesh->SetupBox();
-  } else {
-    // read chunk of elements from file
-    mesh->ParallelReader(fileName.c_str());
-
-    // partition elements using Morton ordering & parallel sort
-    mesh->GeometricPartition();
+  // reuse the partitioned connectivity of an earlier run
+  const bool connectCached = mesh->LoadConnectivityCache();
+
+  if (!connectCached) {
+    bool connected = false;
+
+    if (settings.compareSetting("MESH FILE","PMLBOX")) {
+      //build a box mesh with a pml layer
+      mesh->SetupPmlBox();
+    } else if (settings.compareSetting("MESH FILE","BOX")) {
+      //build a box mesh
+      mesh->SetupBox();
+    } else {
+      // read chunk of elements from file
+      mesh->ParallelReader(fileName.c_str());
+
+      // partition elements using Morton ordering & parallel sort
+      mesh->GeometricPartition();
+
+      // improve the partition with a multilevel graph partitioner, which
+      // carries the face connectivity over to the new partition
+      if (settings.compareSetting("MESH PARTITIONER","GRAPH")) {
+        mesh->ParallelConnect();
+
+        dfloat *weights = mesh->PartitionWeights();
+        mesh->GraphPartition(weights);
+        if (weights) free(weights);
+
+        connected = true;
+      }
+    }
+
+    // renumbering the elements invalidates the connectivity
+    if (connected && !settings.compareSetting("ELEMENT ORDERING","NONE")) {
+      free(mesh->EToE);
+      free(mesh->EToF);
+      free(mesh->EToP);
+      connected = false;
+    }
+
+    // renumber elements on each rank for locality
+    mesh->ReorderElements();
+
+    // connect elements using parallel sort
+    if (!connected)
+      mesh->ParallelConnect();
   }
 
-  // connect elements using parallel sort
-  mesh->ParallelConnect();
-
   // print out connectivity statistics
   mesh->PrintPartitionStatistics();
 
-  // connect elements to boundary faces
-  mesh->ConnectBoundary();
+  if (!connectCached) {
+    // connect elements to boundary faces
+    mesh->ConnectBoundary();
+
+    mesh->SaveConnectivityCache();
+  }
 
   // load reference (r,s) element nodes
   mesh->ReferenceNodes(N);
@@ -100,19 +135,28 @@ mesh_t& mesh_t::Setup(platform_t& platform, meshSettings_t& settings,
   // compute geometric factors
   mesh->GeometricFactors();
 
+  // reuse the trace maps and global numbering of an earlier run
+  const bool nodesCached = mesh->LoadNodeCache();
+
   // connect face nodes (find trace indices)
-  mesh->ConnectFaceNodes();
+  if (!nodesCached)
+    mesh->ConnectFaceNodes();
 
   // compute surface geofacs
   mesh->SurfaceGeometricFactors();
 
   // make a global indexing
-  mesh->ParallelConnectNodes();
+  if (!nodesCached) {
+    mesh->ParallelConnectNodes();
+    mesh->SaveNodeCache();
+  }
 
   // make an ogs operator and label local/global gather elements
   mesh->ParallelGatherScatterSetup();
 
   mesh->OccaSetup();
 
+  mesh->RegisterMemory();
+
   return *mesh;
 }
@@ -82,6 +82,11 @@ void meshQuad2D::SetupBox(){
 
   const int periodicFlag = (boundaryFlag == -1) ? 1 : 0;
 
+  //with fewer than 3 elements across, distinct periodic edges share both
+  // vertex ids, so faces and nodes can not be matched by their vertex ids
+  if (periodicFlag && (NX<3 || NY<3))
+    LIBP_ABORT(string("Periodic BOX mesh needs at least 3 elements in each direction."))
+
   //grid physical sizes
   dfloat DIMX, DIMY;
   settings.getSetting("BOX DIMX", DIMX);
@@ -0,0 +1,313 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+#include <sys/stat.h>
+#include <unistd.h>
+
+// bump when the layout of the cache files changes
+#define SETUP_CACHE_VERSION 2
+
+// FNV-1a hash
+static void hashBytes(unsigned long long int &h, const void *data, size_t bytes){
+  const unsigned char *c = (const unsigned char*) data;
+  for(size_t n=0;n<bytes;++n){
+    h ^= c[n];
+    h *= 1099511628211ULL;
+  }
+}
+
+static void hashString(unsigned long long int &h, const string &str){
+  hashBytes(h, str.c_str(), str.size()+1);
+}
+
+template<typename T>
+static void writeArray(FILE *fp, const T *a, size_t N){
+  fwrite(&N, sizeof(size_t), 1, fp);
+  if(N) fwrite(a, sizeof(T), N, fp);
+}
+
+template<typename T>
+static bool readArray(FILE *fp, T* &a, size_t N){
+  size_t Nfile = 0;
+  if(fread(&Nfile, sizeof(size_t), 1, fp)!=1 || Nfile!=N) return false;
+
+  a = (T*) calloc(mymax(N,(size_t)1), sizeof(T));
+  if(N && fread(a, sizeof(T), N, fp)!=N) return false;
+
+  return true;
+}
+
+// open a uniquely named temporary file next to a cache file. The file is
+// only renamed into place by closeCacheFile once it is complete, so a
+// concurrent or interrupted run never leaves a partial cache file behind
+static FILE *openCacheFile(const string fileName, string &tmpName){
+  tmpName = fileName + ".tmp" + std::to_string(getpid());
+
+  FILE *fp = fopen(tmpName.c_str(), "wb");
+  if (fp==NULL)
+    LIBP_WARNING("Unable to write setup cache file " << fileName);
+  return fp;
+}
+
+static void closeCacheFile(FILE *fp, const string fileName, const string tmpName){
+  const bool ok = !ferror(fp);
+  if (fclose(fp)!=0 || !ok || rename(tmpName.c_str(), fileName.c_str())!=0) {
+    LIBP_WARNING("Unable to write setup cache file " << fileName);
+    remove(tmpName.c_str());
+  }
+}
+
+// header identifying the version, type sizes, and rank layout of a cache file
+static void writeHeader(FILE *fp, int rank, int size){
+  int header[6] = {SETUP_CACHE_VERSION, (int) sizeof(dlong), (int) sizeof(hlong),
+                   (int) sizeof(dfloat), rank, size};
+  fwrite(header, sizeof(int), 6, fp);
+}
+
+static bool readHeader(FILE *fp, int rank, int size){
+  int header[6];
+  if(fread(header, sizeof(int), 6, fp)!=6) return false;
+
+  return header[0]==SETUP_CACHE_VERSION
+      && header[1]==(int) sizeof(dlong)
+      && header[2]==(int) sizeof(hlong)
+      && header[3]==(int) sizeof(dfloat)
+      && header[4]==rank
+      && header[5]==size;
+}
+
+// path to this rank's cache file for a setup stage. The directory is keyed
+// on the settings that decide the partitioned mesh, the contents of the mesh
+// file, and the rank count. Solver settings are left out so that runs which
+// only differ in e.g. the final time or CFL share a cache.
+// Returns an empty string if caching is disabled
+string mesh_t::SetupCacheFile(const string stage){
+
+  string cacheDir = settings.getSetting("SETUP CACHE");
+  if (cacheDir=="NONE") return "";
+
+  if (setupCacheDir=="") {
+    unsigned long long int h = 14695981039346656037ULL;
+    hashBytes(h, &size, sizeof(int));
+
+    // the mesh source and the partitioner choices decide which elements
+    // land on each rank. The node numbering is cached per degree, so the
+    // degree is left out
+    const int NmeshSettings = 17;
+    const string meshSettings[NmeshSettings] = {"MESH FILE", "MESH DIMENSION", "ELEMENT TYPE",
+                                                "BOX DIMX", "BOX DIMY", "BOX DIMZ",
+                                                "BOX NX", "BOX NY", "BOX NZ",
+                                                "BOX GLOBAL NX", "BOX GLOBAL NY", "BOX GLOBAL NZ",
+                                                "BOX BOUNDARY FLAG",
+                                                "MESH PARTITIONER", "PARTITION WEIGHTS",
+                                                "ELEMENT ORDERING", "MULTIRATE PARTITION"};
+    for(int n=0;n<NmeshSettings;++n) {
+      hashString(h, meshSettings[n]);
+      if (settings.hasSetting(meshSettings[n]))
+        hashString(h, settings.getSetting(meshSettings[n]));
+    }
+
+    // hash the contents of the mesh file on rank 0
+    if (!settings.compareSetting("MESH FILE","BOX") &&
+        !settings.compareSetting("MESH FILE","PMLBOX")) {
+      unsigned long long int fileHash = 14695981039346656037ULL;
+      if (rank==0) {
+        FILE *fp = fopen(settings.getSetting("MESH FILE").c_str(), "rb");
+        if (fp) {
+          char buf[BUFSIZ];
+          size_t Nread;
+          while((Nread = fread(buf, 1, BUFSIZ, fp))>0)
+            hashBytes(fileHash, buf, Nread);
+          fclose(fp);
+        }
+      }
+      MPI_Bcast(&fileHash, 1, MPI_UNSIGNED_LONG_LONG, 0, comm);
+      hashBytes(h, &fileHash, sizeof(unsigned long long int));
+    }
+
+    stringstream ss;
+    ss << cacheDir << "/libp-v" << SETUP_CACHE_VERSION << "-" << std::hex << h;
+    setupCacheDir = ss.str();
+
+    if (rank==0) {
+      mkdir(cacheDir.c_str(), 0755);
+      mkdir(setupCacheDir.c_str(), 0755);
+    }
+    MPI_Barrier(comm);
+  }
+
+  return setupCacheDir + "/" + stage + ".r" + std::to_string(rank) + ".bin";
+}
+
+// load the partitioned elements and their face connectivity. All ranks must
+// find a valid file, otherwise nothing is loaded and false is returned
+bool mesh_t::LoadConnectivityCache(){
+
+  string fileName = SetupCacheFile("connect");
+  if (fileName=="") return false;
+
+  faceVertices = NULL;
+  EToV = NULL; EX = NULL; EY = NULL; EZ = NULL;
+  elementInfo = NULL;
+  EToE = NULL; EToF = NULL; EToP = NULL; EToB = NULL;
+  boundaryInfo = NULL;
+
+  FILE *fp = fopen(fileName.c_str(), "rb");
+
+  bool ok = (fp!=NULL) && readHeader(fp, rank, size);
+
+  if (ok) {
+    int counts[4];
+    hlong globals[3];
+    ok = fread(counts,  sizeof(int),   4, fp)==4
+      && fread(globals, sizeof(hlong), 3, fp)==3
+      && fread(&Nelements, sizeof(dlong), 1, fp)==1;
+
+    if (ok) {
+      dim = counts[0]; Nverts = counts[1];
+      Nfaces = counts[2]; NfaceVertices = counts[3];
+      Nnodes = globals[0]; NelementsGlobal = globals[1]; NboundaryFaces = globals[2];
+    }
+  }
+
+  ok = ok && readArray(fp, faceVertices, Nfaces*NfaceVertices);
+  ok = ok && readArray(fp, EToV, Nelements*Nverts);
+  ok = ok && readArray(fp, EX, Nelements*Nverts);
+  ok = ok && readArray(fp, EY, Nelements*Nverts);
+  if (dim==3)
+    ok = ok && readArray(fp, EZ, Nelements*Nverts);
+  ok = ok && readArray(fp, elementInfo, Nelements);
+  ok = ok && readArray(fp, EToE, Nelements*Nfaces);
+  ok = ok && readArray(fp, EToF, Nelements*Nfaces);
+  ok = ok && readArray(fp, EToP, Nelements*Nfaces);
+  ok = ok && readArray(fp, EToB, Nelements*Nfaces);
+  ok = ok && readArray(fp, boundaryInfo, NboundaryFaces*(NfaceVertices+1));
+
+  if (fp) fclose(fp);
+
+  int localOk = ok ? 1 : 0, allOk = 0;
+  MPI_Allreduce(&localOk, &allOk, 1, MPI_INT, MPI_MIN, comm);
+
+  if (!allOk) {
+    free(faceVertices);
+    free(EToV); free(EX); free(EY); free(EZ);
+    free(elementInfo);
+    free(EToE); free(EToF); free(EToP); free(EToB);
+    free(boundaryInfo);
+    Nelements = 0;
+    return false;
+  }
+
+  if (rank==0)
+    printf("Loaded mesh connectivity from setup cache\n");
+
+  return true;
+}
+
+void mesh_t::SaveConnectivityCache(){
+
+  string fileName = SetupCacheFile("connect");
+  if (fileName=="") return;
+
+  string tmpName;
+  FILE *fp = openCacheFile(fileName, tmpName);
+  if (fp==NULL) return;
+
+  writeHeader(fp, rank, size);
+
+  int counts[4] = {dim, Nverts, Nfaces, NfaceVertices};
+  hlong globals[3] = {Nnodes, NelementsGlobal, NboundaryFaces};
+  fwrite(counts,  sizeof(int),   4, fp);
+  fwrite(globals, sizeof(hlong), 3, fp);
+  fwrite(&Nelements, sizeof(dlong), 1, fp);
+
+  writeArray(fp, faceVertices, Nfaces*NfaceVertices);
+  writeArray(fp, EToV, Nelements*Nverts);
+  writeArray(fp, EX, Nelements*Nverts);
+  writeArray(fp, EY, Nelements*Nverts);
+  if (dim==3)
+    writeArray(fp, EZ, Nelements*Nverts);
+  writeArray(fp, elementInfo, Nelements);
+  writeArray(fp, EToE, Nelements*Nfaces);
+  writeArray(fp, EToF, Nelements*Nfaces);
+  writeArray(fp, EToP, Nelements*Nfaces);
+  writeArray(fp, EToB, Nelements*Nfaces);
+  writeArray(fp, boundaryInfo, NboundaryFaces*(NfaceVertices+1));
+
+  closeCacheFile(fp, fileName, tmpName);
+}
+
+// load the trace maps and global node numbering for this degree
+bool mesh_t::LoadNodeCache(){
+
+  string fileName = SetupCacheFile("nodes.N" + std::to_string(N));
+  if (fileName=="") return false;
+
+  vmapM = NULL; vmapP = NULL; mapP = NULL;
+  globalIds = NULL;
+
+  FILE *fp = fopen(fileName.c_str(), "rb");
+
+  bool ok = (fp!=NULL) && readHeader(fp, rank, size);
+
+  ok = ok && readArray(fp, vmapM, Nelements*Nfaces*Nfp);
+  ok = ok && readArray(fp, vmapP, Nelements*Nfaces*Nfp);
+  ok = ok && readArray(fp, mapP,  Nelements*Nfaces*Nfp);
+  ok = ok && readArray(fp, globalIds, (Nelements+totalHaloPairs)*Np);
+
+  if (fp) fclose(fp);
+
+  int localOk = ok ? 1 : 0, allOk = 0;
+  MPI_Allreduce(&localOk, &allOk, 1, MPI_INT, MPI_MIN, comm);
+
+  if (!allOk) {
+    free(vmapM); free(vmapP); free(mapP);
+    free(globalIds);
+    return false;
+  }
+
+  return true;
+}
+
+void mesh_t::SaveNodeCache(){
+
+  string fileName = SetupCacheFile("nodes.N" + std::to_string(N));
+  if (fileName=="") return;
+
+  string tmpName;
+  FILE *fp = openCacheFile(fileName, tmpName);
+  if (fp==NULL) return;
+
+  writeHeader(fp, rank, size);
+
+  writeArray(fp, vmapM, Nelements*Nfaces*Nfp);
+  writeArray(fp, vmapP, Nelements*Nfaces*Nfp);
+  writeArray(fp, mapP,  Nelements*Nfaces*Nfp);
+  writeArray(fp, globalIds, (Nelements+totalHaloPairs)*Np);
+
+  closeCacheFile(fp, fileName, tmpName);
+}
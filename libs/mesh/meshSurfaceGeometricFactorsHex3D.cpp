@@ -80,96 +80,105 @@ void meshHex3D::SurfaceGeometricFactors(){
                                 Nsgeo*Nfp*Nfaces,
                                 sizeof(dfloat));
 
-  dfloat *xre = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *xse = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *xte = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *yre = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *yse = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *yte = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *zre = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *zse = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *zte = (dfloat*) calloc(Np, sizeof(dfloat));
-
-  for(dlong e=0;e<Nelements+totalHaloPairs;++e){ /* for each element */
-
-    for(int k=0;k<Nq;++k){
-      for(int j=0;j<Nq;++j){
-        for(int i=0;i<Nq;++i){
-
-          int n = i + j*Nq + k*Nq*Nq;
-          xre[n] = 0; xse[n] = 0; xte[n] = 0;
-          yre[n] = 0; yse[n] = 0; yte[n] = 0;
-          zre[n] = 0; zse[n] = 0; zte[n] = 0;
-
-          for(int m=0;m<Nq;++m){
-            int idr = e*Np + k*Nq*Nq + j*Nq + m;
-            int ids = e*Np + k*Nq*Nq + m*Nq + i;
-            int idt = e*Np + m*Nq*Nq + j*Nq + i;
-            xre[n] += D[i*Nq+m]*x[idr];
-            xse[n] += D[j*Nq+m]*x[ids];
-            xte[n] += D[k*Nq+m]*x[idt];
-            yre[n] += D[i*Nq+m]*y[idr];
-            yse[n] += D[j*Nq+m]*y[ids];
-            yte[n] += D[k*Nq+m]*y[idt];
-            zre[n] += D[i*Nq+m]*z[idr];
-            zse[n] += D[j*Nq+m]*z[ids];
-            zte[n] += D[k*Nq+m]*z[idt];
+  #pragma omp parallel
+  {
+    //per-thread scratch
+    dfloat *xre = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *xse = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *xte = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *yre = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *yse = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *yte = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *zre = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *zse = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *zte = (dfloat*) calloc(Np, sizeof(dfloat));
+
+    #pragma omp for
+    for(dlong e=0;e<Nelements+totalHaloPairs;++e){ /* for each element */
+
+      for(int k=0;k<Nq;++k){
+        for(int j=0;j<Nq;++j){
+          for(int i=0;i<Nq;++i){
+
+            int n = i + j*Nq + k*Nq*Nq;
+            xre[n] = 0; xse[n] = 0; xte[n] = 0;
+            yre[n] = 0; yse[n] = 0; yte[n] = 0;
+            zre[n] = 0; zse[n] = 0; zte[n] = 0;
+
+            for(int m=0;m<Nq;++m){
+              int idr = e*Np + k*Nq*Nq + j*Nq + m;
+              int ids = e*Np + k*Nq*Nq + m*Nq + i;
+              int idt = e*Np + m*Nq*Nq + j*Nq + i;
+              xre[n] += D[i*Nq+m]*x[idr];
+              xse[n] += D[j*Nq+m]*x[ids];
+              xte[n] += D[k*Nq+m]*x[idt];
+              yre[n] += D[i*Nq+m]*y[idr];
+              yse[n] += D[j*Nq+m]*y[ids];
+              yte[n] += D[k*Nq+m]*y[idt];
+              zre[n] += D[i*Nq+m]*z[idr];
+              zse[n] += D[j*Nq+m]*z[ids];
+              zte[n] += D[k*Nq+m]*z[idt];
+            }
           }
         }
       }
-    }
 
-    for(int f=0;f<Nfaces;++f){ // for each face
+      for(int f=0;f<Nfaces;++f){ // for each face
 
-      for(int i=0;i<Nfp;++i){  // for each node on face
+        for(int i=0;i<Nfp;++i){  // for each node on face
 
-        /* volume index of face node */
-        int n = faceNodes[f*Nfp+i];
+          /* volume index of face node */
+          int n = faceNodes[f*Nfp+i];
 
-        dfloat xr = xre[n], xs = xse[n], xt = xte[n];
-        dfloat yr = yre[n], ys = yse[n], yt = yte[n];
-        dfloat zr = zre[n], zs = zse[n], zt = zte[n];
+          dfloat xr = xre[n], xs = xse[n], xt = xte[n];
+          dfloat yr = yre[n], ys = yse[n], yt = yte[n];
+          dfloat zr = zre[n], zs = zse[n], zt = zte[n];
 
-        /* determinant of Jacobian matrix */
-        dfloat J = xr*(ys*zt-zs*yt) - yr*(xs*zt-zs*xt) + zr*(xs*yt-ys*xt);
+          /* determinant of Jacobian matrix */
+          dfloat J = xr*(ys*zt-zs*yt) - yr*(xs*zt-zs*xt) + zr*(xs*yt-ys*xt);
 
-        dfloat rx =  (ys*zt - zs*yt)/J, ry = -(xs*zt - zs*xt)/J, rz =  (xs*yt - ys*xt)/J;
-        dfloat sx = -(yr*zt - zr*yt)/J, sy =  (xr*zt - zr*xt)/J, sz = -(xr*yt - yr*xt)/J;
-        dfloat tx =  (yr*zs - zr*ys)/J, ty = -(xr*zs - zr*xs)/J, tz =  (xr*ys - yr*xs)/J;
+          dfloat rx =  (ys*zt - zs*yt)/J, ry = -(xs*zt - zs*xt)/J, rz =  (xs*yt - ys*xt)/J;
+          dfloat sx = -(yr*zt - zr*yt)/J, sy =  (xr*zt - zr*xt)/J, sz = -(xr*yt - yr*xt)/J;
+          dfloat tx =  (yr*zs - zr*ys)/J, ty = -(xr*zs - zr*xs)/J, tz =  (xr*ys - yr*xs)/J;
 
-        /* face f normal and length */
-        dfloat nx=0.0, ny=0.0, nz=0.0;
-        switch(f){
-        case 0: nx = -tx; ny = -ty; nz = -tz; break;
-        case 1: nx = -sx; ny = -sy; nz = -sz; break;
-        case 2: nx = +rx; ny = +ry; nz = +rz; break;
-        case 3: nx = +sx; ny = +sy; nz = +sz; break;
-        case 4: nx = -rx; ny = -ry; nz = -rz; break;
-        case 5: nx = +tx; ny = +ty; nz = +tz; break;
-        }
+          /* face f normal and length */
+          dfloat nx=0.0, ny=0.0, nz=0.0;
+          switch(f){
+          case 0: nx = -tx; ny = -ty; nz = -tz; break;
+          case 1: nx = -sx; ny = -sy; nz = -sz; break;
+          case 2: nx = +rx; ny = +ry; nz = +rz; break;
+          case 3: nx = +sx; ny = +sy; nz = +sz; break;
+          case 4: nx = -rx; ny = -ry; nz = -rz; break;
+          case 5: nx = +tx; ny = +ty; nz = +tz; break;
+          }
 
-        dfloat sJ = sqrt(nx*nx+ny*ny+nz*nz);
-        nx /= sJ; ny /= sJ; nz /= sJ;
-        sJ *= J;
+          dfloat sJ = sqrt(nx*nx+ny*ny+nz*nz);
+          nx /= sJ; ny /= sJ; nz /= sJ;
+          sJ *= J;
 
-        /* output index */
-        dlong base = Nsgeo*(Nfaces*Nfp*e + Nfp*f + i);
+          /* output index */
+          dlong base = Nsgeo*(Nfaces*Nfp*e + Nfp*f + i);
 
-        /* store normal, surface Jacobian, and reciprocal of volume Jacobian */
-        sgeo[base+NXID] = nx;
-        sgeo[base+NYID] = ny;
-        sgeo[base+NZID] = nz;
-        sgeo[base+SJID] = sJ;
-        sgeo[base+IJID] = 1./J;
+          /* store normal, surface Jacobian, and reciprocal of volume Jacobian */
+          sgeo[base+NXID] = nx;
+          sgeo[base+NYID] = ny;
+          sgeo[base+NZID] = nz;
+          sgeo[base+SJID] = sJ;
+          sgeo[base+IJID] = 1./J;
 
-        sgeo[base+WIJID] = 1./(J*w[0]);
-        sgeo[base+WSJID] = sJ*w[i%Nq]*w[i/Nq];
+          sgeo[base+WIJID] = 1./(J*w[0]);
+          sgeo[base+WSJID] = sJ*w[i%Nq]*w[i/Nq];
 
-        // computeFrame(nx, ny, nz,
-        //              sgeo[base+STXID], sgeo[base+STYID], sgeo[base+STZID],
-        //              sgeo[base+SBXID], sgeo[base+SBYID], sgeo[base+SBZID]);
+          // computeFrame(nx, ny, nz,
+          //              sgeo[base+STXID], sgeo[base+STYID], sgeo[base+STZID],
+          //              sgeo[base+SBXID], sgeo[base+SBYID], sgeo[base+SBZID]);
+        }
       }
     }
+
+    free(xre); free(xse); free(xte);
+    free(yre); free(yse); free(yte);
+    free(zre); free(zse); free(zte);
   }
 
   for(dlong e=0;e<Nelements;++e){ /* for each non-halo element */
@@ -183,8 +192,4 @@ void meshHex3D::SurfaceGeometricFactors(){
       sgeo[baseP*Nsgeo+IHID] = mymax(hinvM,hinvP);
     }
   }
-
-  free(xre); free(xse); free(xte);
-  free(yre); free(yse); free(yte);
-  free(zre); free(zse); free(zte);
 }
@@ -36,72 +36,80 @@ void meshQuad2D::SurfaceGeometricFactors(){
                                 Nsgeo*Nfp*Nfaces,
                                 sizeof(dfloat));
 
-  dfloat *xre = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *xse = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *yre = (dfloat*) calloc(Np, sizeof(dfloat));
-  dfloat *yse = (dfloat*) calloc(Np, sizeof(dfloat));
-
-  for(dlong e=0;e<Nelements+totalHaloPairs;++e){ /* for each element */
-
-    for(int j=0;j<Nq;++j){
-      for(int i=0;i<Nq;++i){
-        int n = i + j*Nq;
-        xre[n] = 0; xse[n] = 0;
-        yre[n] = 0; yse[n] = 0;
-
-        for(int m=0;m<Nq;++m){
-          int idr = e*Np + j*Nq + m;
-          int ids = e*Np + m*Nq + i;
-          xre[n] += D[i*Nq+m]*x[idr];
-          xse[n] += D[j*Nq+m]*x[ids];
-          yre[n] += D[i*Nq+m]*y[idr];
-          yse[n] += D[j*Nq+m]*y[ids];
+  #pragma omp parallel
+  {
+    //per-thread scratch
+    dfloat *xre = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *xse = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *yre = (dfloat*) calloc(Np, sizeof(dfloat));
+    dfloat *yse = (dfloat*) calloc(Np, sizeof(dfloat));
+
+    #pragma omp for
+    for(dlong e=0;e<Nelements+totalHaloPairs;++e){ /* for each element */
+
+      for(int j=0;j<Nq;++j){
+        for(int i=0;i<Nq;++i){
+          int n = i + j*Nq;
+          xre[n] = 0; xse[n] = 0;
+          yre[n] = 0; yse[n] = 0;
+
+          for(int m=0;m<Nq;++m){
+            int idr = e*Np + j*Nq + m;
+            int ids = e*Np + m*Nq + i;
+            xre[n] += D[i*Nq+m]*x[idr];
+            xse[n] += D[j*Nq+m]*x[ids];
+            yre[n] += D[i*Nq+m]*y[idr];
+            yse[n] += D[j*Nq+m]*y[ids];
+          }
         }
       }
-    }
-
-    for(int f=0;f<Nfaces;++f){ // for each face
-      for(int i=0;i<Nq;++i){  // for each node on face
-
-        /* volume index of face node */
-        int n = faceNodes[f*Nfp+i];
-
-        dfloat xr = xre[n], xs = xse[n];
-        dfloat yr = yre[n], ys = yse[n];
-
-        /* compute geometric factors for affine coordinate transform*/
-        dfloat J = xr*ys - xs*yr;
 
-        dfloat rx =  ys/J;
-        dfloat ry = -xs/J;
-        dfloat sx = -yr/J;
-        dfloat sy =  xr/J;
-
-        /* face f normal and length */
-        dfloat nx=0.0, ny=0.0;
-        switch(f){
-        case 0: nx = -sx; ny = -sy; break;
-        case 1: nx = +rx; ny = +ry; break;
-        case 2: nx = +sx; ny = +sy; break;
-        case 3: nx = -rx; ny = -ry; break;
+      for(int f=0;f<Nfaces;++f){ // for each face
+        for(int i=0;i<Nq;++i){  // for each node on face
+
+          /* volume index of face node */
+          int n = faceNodes[f*Nfp+i];
+
+          dfloat xr = xre[n], xs = xse[n];
+          dfloat yr = yre[n], ys = yse[n];
+
+          /* compute geometric factors for affine coordinate transform*/
+          dfloat J = xr*ys - xs*yr;
+
+          dfloat rx =  ys/J;
+          dfloat ry = -xs/J;
+          dfloat sx = -yr/J;
+          dfloat sy =  xr/J;
+
+          /* face f normal and length */
+          dfloat nx=0.0, ny=0.0;
+          switch(f){
+          case 0: nx = -sx; ny = -sy; break;
+          case 1: nx = +rx; ny = +ry; break;
+          case 2: nx = +sx; ny = +sy; break;
+          case 3: nx = -rx; ny = -ry; break;
+          }
+          dfloat  sJ = sqrt((nx)*(nx)+(ny)*(ny));
+          nx /= sJ; ny /= sJ;
+          sJ *= J;
+
+          /* output index */
+          dlong base = Nsgeo*(Nfaces*Nfp*e + Nfp*f + i);
+
+          /* store normal, surface Jacobian, and reciprocal of volume Jacobian */
+          sgeo[base+NXID] = nx;
+          sgeo[base+NYID] = ny;
+          sgeo[base+SJID] = sJ;
+          sgeo[base+IJID] = 1./J;
+
+          sgeo[base+WIJID] = 1./(J*w[0]);
+          sgeo[base+WSJID] = sJ*w[i];
         }
-        dfloat  sJ = sqrt((nx)*(nx)+(ny)*(ny));
-        nx /= sJ; ny /= sJ;
-        sJ *= J;
-
-        /* output index */
-        dlong base = Nsgeo*(Nfaces*Nfp*e + Nfp*f + i);
-
-        /* store normal, surface Jacobian, and reciprocal of volume Jacobian */
-        sgeo[base+NXID] = nx;
-        sgeo[base+NYID] = ny;
-        sgeo[base+SJID] = sJ;
-        sgeo[base+IJID] = 1./J;
-
-        sgeo[base+WIJID] = 1./(J*w[0]);
-        sgeo[base+WSJID] = sJ*w[i];
       }
     }
+
+    free(xre); free(xse);
+    free(yre); free(yse);
   }
 
   for(dlong e=0;e<Nelements;++e){ /* for each non-halo element */
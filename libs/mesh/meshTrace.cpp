@@ -0,0 +1,98 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mesh.hpp"
+
+// position of face node n after applying an orientation code to the
+// tensor product face (see include/mesh/meshTrace.h)
+static int tracePermute(const int n, const int code, const int Nq){
+  int a = n%Nq;
+  int b = n/Nq;
+  if (code&1) std::swap(a,b);
+  if (code&2) a = Nq-1-a;
+  if (code&4) b = Nq-1-b;
+  return b*Nq + a;
+}
+
+// build the trace connectivity used by face kernels. In compact mode
+// each element face stores its neighbor and the relative orientation of
+// the two faces instead of Nfp exterior node ids
+void mesh_t::TraceSetup(){
+
+  compactTrace = settings.compareSetting("TRACE CONNECTIVITY","COMPACT")
+                 && ((elementType==QUADRILATERALS && dim==2) || elementType==HEXAHEDRA);
+
+  props["defines/" "p_compactTrace"] = (int) compactTrace;
+  props["includes"] += LIBP_DIR "/include/mesh/meshTrace.h";
+
+  if (!compactTrace) {
+    o_traceM = o_vmapM;
+    o_traceP = o_vmapP;
+    return;
+  }
+
+  // line faces can only be reversed
+  const int Ncodes = (dim==2) ? 2 : 8;
+  const int codeStride = (dim==2) ? 2 : 1;
+
+  dlong *traceM = (dlong*) malloc(Nfaces*Nfp*sizeof(dlong));
+  for (int n=0;n<Nfaces*Nfp;n++)
+    traceM[n] = faceNodes[n];
+
+  dlong *traceP = (dlong*) malloc(Nelements*Nfaces*sizeof(dlong));
+
+  for (dlong e=0;e<Nelements;e++) {
+    for (int f=0;f<Nfaces;f++) {
+      const dlong *vP = vmapP + e*Nfaces*Nfp + f*Nfp;
+      const dlong eP = vP[0]/Np;
+
+      dlong match = -1;
+      for (int fP=0;fP<Nfaces && match<0;fP++) {
+        for (int c=0;c<Ncodes && match<0;c++) {
+          const int code = c*codeStride;
+
+          int n=0;
+          for (;n<Nfp;n++)
+            if (vP[n] != eP*Np + faceNodes[fP*Nfp + tracePermute(n, code, Nq)])
+              break;
+
+          if (n==Nfp) match = (eP*Nfaces + fP)*8 + code;
+        }
+      }
+
+      if (match<0)
+        LIBP_ABORT(string("Face connectivity does not match any orientation of a neighbor face."))
+
+      traceP[e*Nfaces + f] = match;
+    }
+  }
+
+  o_traceM = platform.malloc(Nfaces*Nfp*sizeof(dlong), traceM);
+  o_traceP = platform.malloc(Nelements*Nfaces*sizeof(dlong), traceP);
+
+  free(traceM);
+  free(traceP);
+}
@@ -59,6 +59,16 @@ void parAlmond_t::Operator(occa::memory& o_rhs, occa::memory& o_x) {
   }
 }
 
+void parAlmond_t::BlockOperator(const int Nrhs, const dlong stride,
+                                occa::memory& o_rhs, occa::memory& o_x) {
+
+  if (multigrid->exact){ //one exact solve per right-hand side
+    precon_t::BlockOperator(Nrhs, stride, o_rhs, o_x);
+  } else { //apply a multigrid cycle to all right-hand sides
+    multigrid->BlockOperator(Nrhs, stride, o_rhs, o_x);
+  }
+}
+
 //Add level to multigrid heirarchy
 void parAlmond_t::AddLevel(multigridLevel* level) {
   multigrid->AddLevel(level);
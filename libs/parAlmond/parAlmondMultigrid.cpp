@@ -39,6 +39,45 @@ void multigrid_t::Operator(occa::memory& o_RHS, occa::memory& o_X) {
   }
 }
 
+void multigrid_t::BlockOperator(const int Nrhs, const dlong stride,
+                                occa::memory& o_RHS, occa::memory& o_X) {
+  if (ctype == KCYCLE) {
+    //the K-cycle's inner Krylov steps are per right-hand side
+    precon_t::BlockOperator(Nrhs, stride, o_RHS, o_X);
+  } else {
+    BlockSetup(Nrhs, stride);
+    blockVcycle(0, Nrhs, stride, o_RHS, o_X);
+  }
+}
+
+//allocate the coarse level storage of the blocked V-cycle
+void multigrid_t::BlockSetup(const int Nrhs, const dlong stride) {
+
+  if (Nrhs<=NblockRhs && stride<=blockStride) return;
+
+  NblockRhs = mymax(Nrhs, NblockRhs);
+  blockStride = mymax(stride, blockStride);
+
+  dlong maxNcols = blockStride;
+  for (int k=1;k<numLevels;k++) {
+    const dlong Ncols = levels[k]->Ncols;
+    maxNcols = mymax(maxNcols, Ncols);
+
+    if (o_xBlock[k].size()) o_xBlock[k].free();
+    if (o_rhsBlock[k].size()) o_rhsBlock[k].free();
+
+    dfloat *dummy = (dfloat *) calloc(NblockRhs*Ncols,sizeof(dfloat));
+    o_xBlock[k]   = platform.malloc(NblockRhs*Ncols*sizeof(dfloat),dummy);
+    o_rhsBlock[k] = platform.malloc(NblockRhs*Ncols*sizeof(dfloat),dummy);
+    free(dummy);
+  }
+
+  if (o_resBlock.size()) o_resBlock.free();
+  dfloat *dummy = (dfloat *) calloc(NblockRhs*maxNcols,sizeof(dfloat));
+  o_resBlock = platform.malloc(NblockRhs*maxNcols*sizeof(dfloat),dummy);
+  free(dummy);
+}
+
 multigrid_t::multigrid_t(platform_t& _platform, settings_t& _settings,
                          MPI_Comm _comm):
     platform(_platform), settings(_settings), comm(_comm) {
@@ -57,4 +57,49 @@ void multigrid_t::vcycle(const int k, occa::memory& o_RHS, occa::memory& o_X){
   level->smooth(o_RHS, o_X, false);
 }
 
+// The smoother and residual of each level act on all Nrhs vectors at
+// once. The transfers and the coarse solve are applied per vector
+void multigrid_t::blockVcycle(const int k, const int Nrhs, const dlong stride,
+                              occa::memory& o_RHS, occa::memory& o_X){
+
+  //check for base level
+  if(k==baseLevel) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_RHSn = o_RHS + n*stride*sizeof(dfloat);
+      occa::memory o_Xn   = o_X   + n*stride*sizeof(dfloat);
+      coarseSolver->solve(o_RHSn, o_Xn);
+    }
+    return;
+  }
+
+  multigridLevel *level  = levels[k];
+  occa::memory& o_RHSC = o_rhsBlock[k+1];
+  occa::memory& o_XC   = o_xBlock[k+1];
+  occa::memory& o_RES  = o_resBlock;
+
+  const dlong strideC = levels[k+1]->Ncols;
+
+  //apply smoother to x and then compute res = rhs-Ax
+  level->smoothBlock(Nrhs, stride, o_RHS, o_X, true);
+  level->residualBlock(Nrhs, stride, o_RHS, o_X, o_RES);
+
+  // rhsC = P^T res
+  for (int n=0;n<Nrhs;n++) {
+    occa::memory o_RESn  = o_RES  + n*stride*sizeof(dfloat);
+    occa::memory o_RHSCn = o_RHSC + n*strideC*sizeof(dfloat);
+    level->coarsen(o_RESn, o_RHSCn);
+  }
+
+  blockVcycle(k+1, Nrhs, strideC, o_RHSC, o_XC);
+
+  // x = x + P xC
+  for (int n=0;n<Nrhs;n++) {
+    occa::memory o_XCn = o_XC + n*strideC*sizeof(dfloat);
+    occa::memory o_Xn  = o_X  + n*stride*sizeof(dfloat);
+    level->prolongate(o_XCn, o_Xn);
+  }
+
+  level->smoothBlock(Nrhs, stride, o_RHS, o_X, false);
+}
+
 } //namespace parAlmond
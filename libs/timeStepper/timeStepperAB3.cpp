@@ -67,7 +67,7 @@ void ab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -84,7 +84,7 @@ void ab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
     if (time>outputTime) {
       //report state
-      solver.Report(time,tstep);
+      Report(time,tstep);
       outputTime += outputInterval;
     }
   }
@@ -0,0 +1,394 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+
+namespace TimeStepper {
+
+ark::ark(dlong Nelements, dlong NhaloElements,
+         int Np, int Nfields, solver_t& _solver, MPI_Comm _comm,
+         int _Nrk, int _order, int _embeddedOrder,
+         const dfloat *_rkC, const dfloat *_rkAE, const dfloat *_rkAI,
+         const dfloat *_rkBhat):
+  timeStepper_t(Nelements, NhaloElements, Np, Nfields, _solver), comm(_comm),
+  Nrk(_Nrk), order(_order), embeddedOrder(_embeddedOrder) {
+
+  platform_t &platform = solver.platform;
+
+  o_rkq   = platform.malloc((N+Nhalo)*sizeof(dfloat));
+  o_rkrhs = platform.malloc(N*sizeof(dfloat));
+  o_rhs   = platform.malloc(N*sizeof(dfloat));
+  o_rkF   = platform.malloc(Nrk*N*sizeof(dfloat));
+  o_rkG   = platform.malloc(Nrk*N*sizeof(dfloat));
+  o_rkerr = platform.malloc(N*sizeof(dfloat));
+
+  o_saveq = platform.malloc(N*sizeof(dfloat));
+
+  Nblock = (N+BLOCKSIZE-1)/BLOCKSIZE;
+  errtmp = (dfloat*) platform.hostMalloc(Nblock*sizeof(dfloat),
+                                          NULL, h_errtmp);
+  o_errtmp = platform.malloc(Nblock*sizeof(dfloat));
+
+  hlong Nlocal = N;
+  hlong Ntotal;
+  MPI_Allreduce(&Nlocal, &Ntotal, 1, MPI_HLONG, MPI_SUM, comm);
+
+  occa::properties kernelInfo = platform.props; //copy base occa properties from solver
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)BLOCKSIZE;
+  kernelInfo["defines/" "p_Nrk"] = (int)Nrk;
+
+  rkStageKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkStage",
+                                    kernelInfo);
+
+  rkImplicitUpdateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkImplicitUpdate",
+                                    kernelInfo);
+
+  rkUpdateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkUpdate",
+                                    kernelInfo);
+
+  rkErrorEstimateKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperARK.okl",
+                                    "arkErrorEstimate",
+                                    kernelInfo);
+
+  rkC  = (dfloat*) calloc(Nrk, sizeof(dfloat));
+  rkB  = (dfloat*) calloc(Nrk, sizeof(dfloat));
+  rkE  = (dfloat*) calloc(Nrk, sizeof(dfloat));
+  rkAE = (dfloat*) calloc(Nrk*Nrk, sizeof(dfloat));
+  rkAI = (dfloat*) calloc(Nrk*Nrk, sizeof(dfloat));
+
+  memcpy(rkC,  _rkC,  Nrk*sizeof(dfloat));
+  memcpy(rkAE, _rkAE, Nrk*Nrk*sizeof(dfloat));
+  memcpy(rkAI, _rkAI, Nrk*Nrk*sizeof(dfloat));
+
+  //stiffly accurate: the explicit and implicit weights are the
+  // last row of the implicit tableau
+  for (int i=0;i<Nrk;i++) {
+    rkB[i] = rkAI[(Nrk-1)*Nrk + i];
+    rkE[i] = rkB[i] - _rkBhat[i];
+  }
+
+  //ESDIRK: constant diagonal
+  rkGamma = rkAI[Nrk*Nrk-1];
+
+  o_rkAE = platform.malloc(Nrk*Nrk*sizeof(dfloat), rkAE);
+  o_rkAI = platform.malloc(Nrk*Nrk*sizeof(dfloat), rkAI);
+  o_rkB  = platform.malloc(Nrk*sizeof(dfloat), rkB);
+  o_rkE  = platform.malloc(Nrk*sizeof(dfloat), rkE);
+
+  dtMIN = 1E-9; //minumum allowed timestep
+  ATOL = 1E-6;  //absolute error tolerance
+  RTOL = 1E-6;  //relative error tolerance
+  safe = 0.8;   //safety factor
+
+  //error control parameters
+  beta = 0.05;
+  factor1 = 0.2;
+  factor2 = 5.0;
+
+  exp1 = 1.0/(embeddedOrder+1) - 0.75*beta;
+  invfactor1 = 1.0/factor1;
+  invfactor2 = 1.0/factor2;
+  facold = 1E-4;
+  sqrtinvNtotal = 1.0/sqrt(Ntotal);
+}
+
+//implicit stage solves are gamma*q - g(q) = rhs, with gamma = getGamma()/dt
+dfloat ark::getGamma() {
+  return 1.0/rkGamma;
+}
+
+void ark::Run(occa::memory &o_q, dfloat start, dfloat end) {
+
+  dfloat time = start;
+
+  Report(time,0);
+
+  dfloat outputInterval;
+  solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
+
+  dfloat outputTime = time + outputInterval;
+
+  int tstep=0, allStep=0;
+
+  while (time < end) {
+
+    if (dt<dtMIN){
+      stringstream ss;
+      ss << "Time step became too small at time step = " << tstep;
+      LIBP_ABORT(ss.str());
+    }
+    if (std::isnan(dt)) {
+      stringstream ss;
+      ss << "Solution became unstable at time step = " << tstep;
+      LIBP_ABORT(ss.str());
+    }
+
+    //check for final timestep
+    if (time+dt > end){
+      dt = end-time;
+    }
+
+    Step(o_q, time, dt);
+
+    // compute embedded error estimator
+    dfloat err = Estimater(o_q);
+
+    // build controller
+    dfloat fac1 = pow(err,exp1);
+    dfloat fac = fac1/pow(facold,beta);
+
+    fac = mymax(invfactor2, mymin(invfactor1,fac/safe));
+    dfloat dtnew = dt/fac;
+
+    if (err<1.0) { //dt is accepted
+
+      // check for output during this step and do a mini-step
+      if (output && time<outputTime && time+dt>=outputTime) {
+        dfloat savedt = dt;
+
+        // save rkq
+        o_saveq.copyFrom(o_rkq, N*sizeof(dfloat));
+
+        // change dt to match output
+        dt = outputTime-time;
+
+        // time step to output
+        Step(o_q, time, dt);
+
+        // shift for output
+        o_rkq.copyTo(o_q, N*sizeof(dfloat));
+
+        // output  (print from rkq)
+        Report(outputTime,tstep);
+
+        // restore time step
+        dt = savedt;
+
+        // increment next output time
+        outputTime += outputInterval;
+
+        // accept saved rkq
+        o_q.copyFrom(o_saveq, N*sizeof(dfloat));
+      } else {
+        // accept rkq
+        o_q.copyFrom(o_rkq, N*sizeof(dfloat));
+      }
+
+      time += dt;
+      while (time>outputTime) outputTime+= outputInterval; //catch up next output in case dt>outputInterval
+
+      facold = mymax(err,1E-4); // hard coded factor ?
+
+      tstep++;
+    } else {
+      dtnew = dt/(mymax(invfactor1,fac1/safe));
+    }
+    dt = dtnew;
+    allStep++;
+  }
+}
+
+void ark::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
+
+  //implicit stages solve rkq - _dt*gamma*g(rkq) = rkrhs
+  const dfloat invGammaDt = 1.0/(rkGamma*_dt);
+
+  //first stage is explicit
+  solver.rhs_imex_f(o_q, o_rkF, time);
+  solver.rhs_imex_g(o_q, o_rkG, time);
+
+  //use the previous stage as the initial guess for each stage solve
+  o_rkq.copyFrom(o_q, N*sizeof(dfloat));
+
+  for(int rk=1;rk<Nrk;++rk){
+
+    // t_rk = t + C_rk*_dt
+    dfloat currentTime = time + rkC[rk]*_dt;
+
+    // rkrhs = q + _dt*sum_{i=0}^{rk-1} (aE_{rk,i}*F_i + aI_{rk,i}*G_i)
+    // rhs = rkrhs/(_dt*gamma)
+    rkStageKernel(N,
+                  rk,
+                  _dt,
+                  invGammaDt,
+                  o_rkAE,
+                  o_rkAI,
+                  o_q,
+                  o_rkF,
+                  o_rkG,
+                  o_rkrhs,
+                  o_rhs);
+
+    //solve invGammaDt*rkq - g(rkq) = rhs
+    solver.rhs_imex_invg(o_rhs, o_rkq, invGammaDt, currentTime);
+
+    //recover the implicit evaluation from the solve rather than
+    // evaluating g(rkq), this keeps the stage consistent with whatever
+    // the solver imposes in its inversion (e.g. boundary data, projection)
+    // G_rk = (rkq - rkrhs)/(_dt*gamma)
+    rkImplicitUpdateKernel(N,
+                           rk,
+                           invGammaDt,
+                           o_rkrhs,
+                           o_rkq,
+                           o_rkG);
+
+    //explicit evaluation F_rk = f(rkq, t_rk)
+    occa::memory o_F = o_rkF + rk*N*sizeof(dfloat);
+    solver.rhs_imex_f(o_rkq, o_F, currentTime);
+  }
+
+  // rkq = q + _dt*sum_i b_i*(F_i+G_i)
+  // rkerr = _dt*sum_i (b_i-bhat_i)*(F_i+G_i)
+  rkUpdateKernel(N,
+                 _dt,
+                 o_rkB,
+                 o_rkE,
+                 o_q,
+                 o_rkF,
+                 o_rkG,
+                 o_rkq,
+                 o_rkerr);
+}
+
+dfloat ark::Estimater(occa::memory& o_q){
+
+  rkErrorEstimateKernel(N,
+                        ATOL,
+                        RTOL,
+                        o_q,
+                        o_rkq,
+                        o_rkerr,
+                        o_errtmp);
+
+  o_errtmp.copyTo(errtmp);
+  dfloat localerr = 0;
+  dfloat err = 0;
+  for(dlong n=0;n<Nblock;++n){
+    localerr += errtmp[n];
+  }
+  MPI_Allreduce(&localerr, &err, 1, MPI_DFLOAT, MPI_SUM, comm);
+
+  err = sqrt(err)*sqrtinvNtotal;
+
+  return err;
+}
+
+ark::~ark() {
+  if (o_rkq.size()) o_rkq.free();
+  if (o_rkrhs.size()) o_rkrhs.free();
+  if (o_rhs.size()) o_rhs.free();
+  if (o_rkF.size()) o_rkF.free();
+  if (o_rkG.size()) o_rkG.free();
+  if (o_rkerr.size()) o_rkerr.free();
+  if (o_saveq.size()) o_saveq.free();
+  if (o_errtmp.size()) o_errtmp.free();
+  if (o_rkAE.size()) o_rkAE.free();
+  if (o_rkAI.size()) o_rkAI.free();
+  if (o_rkB.size()) o_rkB.free();
+  if (o_rkE.size()) o_rkE.free();
+
+  if (rkC) free(rkC);
+  if (rkAE) free(rkAE);
+  if (rkAI) free(rkAI);
+  if (rkB) free(rkB);
+  if (rkE) free(rkE);
+
+  rkStageKernel.free();
+  rkImplicitUpdateKernel.free();
+  rkUpdateKernel.free();
+  rkErrorEstimateKernel.free();
+}
+
+/**************************************************/
+/* Butcher tableaux                               */
+/**************************************************/
+
+// C. A. Kennedy and M. H. Carpenter, Additive Runge-Kutta schemes for
+// convection-diffusion-reaction equations, Appl. Numer. Math. 44 (2003)
+
+static const dfloat ark3Gamma = 1767732205903.0/4055673282236.0;
+
+static const dfloat ark3_rkC[4] = {0.0, 1767732205903.0/2027836641118.0, 3.0/5.0, 1.0};
+
+static const dfloat ark3_rkAE[4*4] = {
+                                   0.0,                                0.0,                                  0.0, 0.0,
+    1767732205903.0/2027836641118.0,                                0.0,                                  0.0, 0.0,
+    5535828885825.0/10492691773637.0,   788022342437.0/10882634858940.0,                                  0.0, 0.0,
+    6485989280629.0/16251701735622.0, -4246266847089.0/9704473918619.0, 10755448449292.0/10357097424841.0, 0.0};
+
+static const dfloat ark3_rkAI[4*4] = {
+                                   0.0,                                0.0,                                  0.0,       0.0,
+                            ark3Gamma,                          ark3Gamma,                                  0.0,       0.0,
+    2746238789719.0/10658868560708.0,  -640167445237.0/6845629431997.0,                            ark3Gamma,       0.0,
+     1471266399579.0/7840856788654.0, -4482444167858.0/7529755066697.0, 11266239266428.0/11593286722821.0, ark3Gamma};
+
+static const dfloat ark3_rkBhat[4] = {2756255671327.0/12835298489170.0, -10771552573575.0/22201958757719.0,
+                                      9247589265047.0/10645013368117.0,   2193209047091.0/5459859503100.0};
+
+ark3::ark3(dlong Nelements, dlong NhaloElements,
+           int Np, int Nfields, solver_t& _solver, MPI_Comm _comm):
+  ark(Nelements, NhaloElements, Np, Nfields, _solver, _comm,
+      4, 3, 2, ark3_rkC, ark3_rkAE, ark3_rkAI, ark3_rkBhat) {}
+
+static const dfloat ark4_rkC[6] = {0.0, 0.5, 83.0/250.0, 31.0/50.0, 17.0/20.0, 1.0};
+
+static const dfloat ark4_rkAE[6*6] = {
+                                  0.0,                                 0.0,                                  0.0,                                 0.0,             0.0, 0.0,
+                                  0.5,                                 0.0,                                  0.0,                                 0.0,             0.0, 0.0,
+                      13861.0/62500.0,                      6889.0/62500.0,                                  0.0,                                 0.0,             0.0, 0.0,
+  -116923316275.0/2393684061468.0, -2731218467317.0/15368042101831.0,   9408046702089.0/11113171139209.0,                                 0.0,             0.0, 0.0,
+  -451086348788.0/2902428689909.0,  -2682348792572.0/7519795681897.0, 12662868775082.0/11960479115383.0, 3355817975965.0/11060851509271.0,             0.0, 0.0,
+   647845179188.0/3216320057751.0,     73281519250.0/8382639484533.0,    552539513391.0/3454668386233.0,  3354512671639.0/8306763924573.0, 4040.0/17871.0, 0.0};
+
+static const dfloat ark4_rkAI[6*6] = {
+                      0.0,                        0.0,                      0.0,                    0.0,              0.0,  0.0,
+                     0.25,                       0.25,                      0.0,                    0.0,              0.0,  0.0,
+           8611.0/62500.0,            -1743.0/31250.0,                     0.25,                    0.0,              0.0,  0.0,
+      5012029.0/34652500.0,           -654441.0/2922500.0,        174375.0/388108.0,                  0.25,              0.0,  0.0,
+  15267082809.0/155376265600.0, -71443401.0/120774400.0, 730878875.0/902184768.0, 2285395.0/8070912.0,             0.25,  0.0,
+           82889.0/524892.0,                        0.0,        15625.0/83664.0,     69875.0/102672.0, -2260.0/8211.0, 0.25};
+
+static const dfloat ark4_rkBhat[6] = {4586570599.0/29645900160.0, 0.0, 178811875.0/945068544.0,
+                                      814220225.0/1159782912.0, -3700637.0/11593932.0, 61727.0/225920.0};
+
+ark4::ark4(dlong Nelements, dlong NhaloElements,
+           int Np, int Nfields, solver_t& _solver, MPI_Comm _comm):
+  ark(Nelements, NhaloElements, Np, Nfields, _solver, _comm,
+      6, 4, 3, ark4_rkC, ark4_rkAE, ark4_rkAI, ark4_rkBhat) {}
+
+} //namespace TimeStepper
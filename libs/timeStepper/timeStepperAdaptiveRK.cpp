@@ -0,0 +1,294 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "timeStepper.hpp"
+
+namespace TimeStepper {
+
+adaptiveRk_t::adaptiveRk_t(dlong Nelements, dlong NhaloElements,
+                           int Np, int Nfields, solver_t& _solver, MPI_Comm _comm):
+  timeStepper_t(Nelements, NhaloElements, Np, Nfields, _solver), comm(_comm) {
+
+  platform_t &platform = solver.platform;
+
+  o_rkq    = platform.malloc((N+Nhalo)*sizeof(dfloat));
+  o_rkerr  = platform.malloc(N*sizeof(dfloat));
+
+  Nblock = (N+BLOCKSIZE-1)/BLOCKSIZE;
+  errtmp = (dfloat*) platform.hostMalloc(Nblock*sizeof(dfloat),
+                                          NULL, h_errtmp);
+  o_errtmp = platform.malloc(Nblock*sizeof(dfloat));
+
+  errnorm = (dfloat*) platform.hostMalloc(sizeof(dfloat),
+                                           NULL, h_errnorm);
+  o_errnorm = platform.malloc(sizeof(dfloat));
+
+  speculate = platform.deviceStepController() ? 1 : 0;
+
+  hlong Nlocal = N;
+  hlong Ntotal;
+  MPI_Allreduce(&Nlocal, &Ntotal, 1, MPI_HLONG, MPI_SUM, comm);
+  sqrtinvNtotal = 1.0/sqrt(Ntotal);
+
+  occa::properties kernelInfo = platform.props; //copy base occa properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)BLOCKSIZE;
+
+  errorReduceKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                    "timeStepperErrorReduce.okl",
+                                    "errorReduce",
+                                    kernelInfo);
+}
+
+dfloat adaptiveRk_t::Estimater(occa::memory& o_q){
+
+  //Error estimation
+  //E. HAIRER, S.P. NORSETT AND G. WANNER, SOLVING ORDINARY
+  //      DIFFERENTIAL EQUATIONS I. NONSTIFF PROBLEMS. 2ND EDITION.
+  rkErrorEstimateKernel(N,
+                        ATOL,
+                        RTOL,
+                        o_q,
+                        o_rkq,
+                        o_rkerr,
+                        o_errtmp);
+
+  o_errtmp.copyTo(errtmp);
+  dfloat lerr = 0;
+  dfloat err = 0;
+  for(dlong n=0;n<Nblock;++n){
+    lerr += errtmp[n];
+  }
+  MPI_Allreduce(&lerr, &err, 1, MPI_DFLOAT, MPI_SUM, comm);
+
+  err = sqrt(err)*sqrtinvNtotal;
+
+  return err;
+}
+
+// Reduce the error norm of the last step on the device and queue
+//  the copy of the local sum to the host behind it
+void adaptiveRk_t::ErrorEstimateStart(occa::memory& o_q){
+
+  rkErrorEstimateKernel(N,
+                        ATOL,
+                        RTOL,
+                        o_q,
+                        o_rkq,
+                        o_rkerr,
+                        o_errtmp);
+
+  errorReduceKernel(Nblock,
+                    o_errtmp,
+                    o_errnorm);
+
+  o_errnorm.copyTo(errnorm, sizeof(dfloat), 0, "async: true");
+
+  platform_t &platform = solver.platform;
+  errTag = platform.device.tagStream();
+}
+
+// Wait only for the local error norm, not for work queued behind it,
+//  and start its global sum
+void adaptiveRk_t::ErrorEstimateReduce(){
+
+  platform_t &platform = solver.platform;
+  platform.device.waitFor(errTag);
+
+  localerr = errnorm[0];
+  MPI_Iallreduce(&localerr, &globalerr, 1, MPI_DFLOAT, MPI_SUM, comm, &errRequest);
+}
+
+dfloat adaptiveRk_t::ErrorEstimateFinish(){
+
+  MPI_Wait(&errRequest, MPI_STATUS_IGNORE);
+
+  return sqrt(globalerr)*sqrtinvNtotal;
+}
+
+// Adaptive stepping with the step controller kept off the critical path.
+//  The step (time, dt) is pending until its error norm arrives. While it
+//  is summed across ranks, the next step (time+dt, dtnext) is taken
+//  speculatively from the pending solution, and is rolled back if the
+//  pending step is rejected. The controller's choice of dt is therefore
+//  applied one step late. Steps which reach an output time or the end
+//  time are taken synchronously.
+void adaptiveRk_t::RunSpeculative(occa::memory &o_q, dfloat start, dfloat end) {
+
+  dfloat time = start;
+
+  Report(time,0);
+
+  dfloat outputInterval;
+  solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
+
+  dfloat outputTime = time + outputInterval;
+
+  int tstep=0, allStep=0;
+
+  //check for final timestep
+  if (time+dt > end){
+    dt = end-time;
+  }
+  dtnext = dt;
+
+  UpdateCoefficients();
+  Step(o_q, time, dt);
+  ErrorEstimateStart(o_q);
+
+  while (time < end) {
+
+    if (dt<dtMIN){
+      stringstream ss;
+      ss << "Time step became too small at time step = " << tstep;
+      LIBP_ABORT(ss.str());
+    }
+    if (std::isnan(dt)) {
+      stringstream ss;
+      ss << "Solution became unstable at time step = " << tstep;
+      LIBP_ABORT(ss.str());
+    }
+
+    // only speculate when the next step stays short of output and the end
+    const int spec = (time+dt+dtnext < outputTime) && (time+dt+dtnext < end);
+
+    if (spec) {
+      // save q and accept the pending step
+      Backup(o_q);
+      AcceptStep(o_q, o_rkq);
+    }
+
+    // start the global sum of the pending error norm
+    ErrorEstimateReduce();
+
+    if (spec) {
+      // take the next step while the error norm is summed
+      dfloat savedt = dt;
+      dt = dtnext;
+      UpdateCoefficients();
+      Step(o_q, time+savedt, dt);
+      dt = savedt;
+    }
+
+    dfloat err = ErrorEstimateFinish();
+
+    // build controller
+    dfloat fac1 = pow(err,exp1);
+    dfloat fac = fac1/pow(facold,beta);
+
+    fac = mymax(invfactor2, mymin(invfactor1,fac/safe));
+
+    if (err<1.0) { //dt is accepted
+
+      if (!spec) {
+        // check for output during this step and do a mini-step
+        if (output && time<outputTime && time+dt>=outputTime) {
+          dfloat savedt = dt;
+
+          // save rkq
+          Backup(o_rkq);
+
+          // change dt to match output
+          dt = outputTime-time;
+
+          // time step to output
+          UpdateCoefficients();
+          Step(o_q, time, dt);
+
+          // shift for output
+          o_rkq.copyTo(o_q, N*sizeof(dfloat));
+
+          // output  (print from rkq)
+          Report(outputTime,tstep);
+
+          // restore time step
+          dt = savedt;
+
+          // increment next output time
+          outputTime += outputInterval;
+
+          // accept saved rkq
+          Restore(o_rkq);
+          AcceptStep(o_q, o_rkq);
+        } else {
+          // accept rkq
+          AcceptStep(o_q, o_rkq);
+        }
+      }
+
+      time += dt;
+      while (time>outputTime) outputTime+= outputInterval; //catch up next output in case dt>outputInterval
+
+      facold = mymax(err,1E-4); // hard coded factor ?
+
+      tstep++;
+      allStep++;
+
+      if (spec) {
+        // the speculative step is now pending
+        ErrorEstimateStart(o_q);
+        dt = dtnext;
+        dtnext = dtnext/fac;
+        continue;
+      }
+      dt = dt/fac;
+    } else {
+      // roll back the speculative step
+      if (spec) Restore(o_q);
+
+      dt = dt/(mymax(invfactor1,fac1/safe));
+      allStep++;
+    }
+
+    // start a new pending step
+    if (time < end) {
+      if (time+dt > end){
+        dt = end-time;
+      }
+      dtnext = dt;
+
+      UpdateCoefficients();
+      Step(o_q, time, dt);
+      ErrorEstimateStart(o_q);
+    }
+  }
+}
+
+adaptiveRk_t::~adaptiveRk_t() {
+  if (o_rkq.size()) o_rkq.free();
+  if (o_rkerr.size()) o_rkerr.free();
+  if (o_errtmp.size()) o_errtmp.free();
+  if (h_errtmp.size()) h_errtmp.free();
+  if (o_errnorm.size()) o_errnorm.free();
+  if (h_errnorm.size()) h_errnorm.free();
+
+  rkErrorEstimateKernel.free();
+  errorReduceKernel.free();
+}
+
+} //namespace TimeStepper
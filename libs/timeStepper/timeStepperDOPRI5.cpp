@@ -31,28 +31,17 @@ namespace TimeStepper {
 
 dopri5::dopri5(dlong Nelements, dlong NhaloElements,
                int Np, int Nfields, solver_t& _solver, MPI_Comm _comm):
-  timeStepper_t(Nelements, NhaloElements, Np, Nfields, _solver), comm(_comm) {
+  adaptiveRk_t(Nelements, NhaloElements, Np, Nfields, _solver, _comm) {
 
   platform_t &platform = solver.platform;
 
   Nrk = 7;
 
   o_rhsq   = platform.malloc(N*sizeof(dfloat));
-  o_rkq    = platform.malloc((N+Nhalo)*sizeof(dfloat));
   o_rkrhsq = platform.malloc(Nrk*N*sizeof(dfloat));
-  o_rkerr  = platform.malloc(N*sizeof(dfloat));
 
   o_saveq  = platform.malloc(N*sizeof(dfloat));
 
-  Nblock = (N+BLOCKSIZE-1)/BLOCKSIZE;
-  errtmp = (dfloat*) platform.hostMalloc(Nblock*sizeof(dfloat),
-                                          NULL, h_errtmp);
-  o_errtmp = platform.malloc(Nblock*sizeof(dfloat));
-
-  hlong Nlocal = N;
-  hlong Ntotal;
-  MPI_Allreduce(&Nlocal, &Ntotal, 1, MPI_HLONG, MPI_SUM, comm);
-
   occa::properties kernelInfo = platform.props; //copy base occa properties from solver
 
   //add defines
@@ -109,17 +98,21 @@ dopri5::dopri5(dlong Nelements, dlong NhaloElements,
   invfactor1 = 1.0/factor1;
   invfactor2 = 1.0/factor2;
   facold = 1E-4;
-  sqrtinvNtotal = 1.0/sqrt(Ntotal);
 }
 
 void dopri5::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
+  if (speculate) {
+    RunSpeculative(o_q, start, end);
+    return;
+  }
+
   dfloat time = start;
 
   // int rank;
   // MPI_Comm_rank(comm, &rank);
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -161,7 +154,7 @@ void dopri5::Run(occa::memory &o_q, dfloat start, dfloat end) {
     if (err<1.0) { //dt is accepted
 
       // check for output during this step and do a mini-step
-      if (time<outputTime && time+dt>=outputTime) {
+      if (output && time<outputTime && time+dt>=outputTime) {
         dfloat savedt = dt;
 
         // save rkq
@@ -181,7 +174,7 @@ void dopri5::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
         // output  (print from rkq)
         // if (!rank) printf("\n");
-        solver.Report(outputTime,tstep);
+        Report(outputTime,tstep);
 
         // restore time step
         dt = savedt;
@@ -273,37 +266,10 @@ void dopri5::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
   }
 }
 
-dfloat dopri5::Estimater(occa::memory& o_q){
-
-  //Error estimation
-  //E. HAIRER, S.P. NORSETT AND G. WANNER, SOLVING ORDINARY
-  //      DIFFERENTIAL EQUATIONS I. NONSTIFF PROBLEMS. 2ND EDITION.
-  rkErrorEstimateKernel(N,
-                        ATOL,
-                        RTOL,
-                        o_q,
-                        o_rkq,
-                        o_rkerr,
-                        o_errtmp);
-
-  o_errtmp.copyTo(errtmp);
-  dfloat localerr = 0;
-  dfloat err = 0;
-  for(dlong n=0;n<Nblock;++n){
-    localerr += errtmp[n];
-  }
-  MPI_Allreduce(&localerr, &err, 1, MPI_DFLOAT, MPI_SUM, comm);
-
-  err = sqrt(err)*sqrtinvNtotal;
-
-  return err;
-}
-
 dopri5::~dopri5() {
-  if (o_rkq.size()) o_rkq.free();
+  if (o_rhsq.size()) o_rhsq.free();
   if (o_rkrhsq.size()) o_rkrhsq.free();
-  if (o_rkerr.size()) o_rkerr.free();
-  if (o_errtmp.size()) o_errtmp.free();
+  if (o_saveq.size()) o_saveq.free();
   if (o_rkA.size()) o_rkA.free();
   if (o_rkE.size()) o_rkE.free();
 
@@ -313,7 +279,6 @@ dopri5::~dopri5() {
 
   rkUpdateKernel.free();
   rkStageKernel.free();
-  rkErrorEstimateKernel.free();
 }
 
 /**************************************************/
@@ -326,6 +291,9 @@ dopri5_pml::dopri5_pml(dlong Nelements, dlong NpmlElements, dlong NhaloElements,
   dopri5(Nelements, NhaloElements, Np, Nfields, _solver, _comm),
   Npml(Npmlfields*Np*NpmlElements) {
 
+  //Backup/Restore act on the PML stage fields, so the step cannot be rolled back
+  speculate = 0;
+
   if (Npml) {
     platform_t &platform = solver.platform;
 
@@ -82,7 +82,7 @@ void lserk4::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -93,7 +93,7 @@ void lserk4::Run(occa::memory &o_q, dfloat start, dfloat end) {
   dfloat stepdt;
   while (time < end) {
 
-    if (time<outputTime && time+dt>=outputTime) {
+    if (output && time<outputTime && time+dt>=outputTime) {
 
       //save current state
       occa::memory o_saveq = platform.malloc(N*sizeof(dfloat));
@@ -105,7 +105,7 @@ void lserk4::Run(occa::memory &o_q, dfloat start, dfloat end) {
       Step(o_q, time, stepdt);
 
       //report state
-      solver.Report(outputTime,tstep);
+      Report(outputTime,tstep);
 
       //restore previous state
       o_q.copyFrom(o_saveq, N*sizeof(dfloat));
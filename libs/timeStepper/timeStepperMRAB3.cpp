@@ -109,7 +109,7 @@ void mrab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
   o_mrdt.copyFrom(mrdt);
   o_shiftIndex.copyFrom(shiftIndex);
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -142,7 +142,7 @@ void mrab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
     if (time>outputTime) {
       //report state
-      solver.Report(outputTime,tstep);
+      Report(outputTime,tstep);
       outputTime += outputInterval;
     }
   }
@@ -26,12 +26,9 @@ SOFTWARE.
 
 #include "core.hpp"
 #include "timeStepper.hpp"
-#include <complex>
 
 namespace TimeStepper {
 
-using std::complex;
-
 mrsaab3::mrsaab3(dlong _Nelements, dlong _NhaloElements,
              int _Np, int _Nfields,
              dfloat *_lambda, solver_t& _solver, mesh_t& _mesh):
@@ -106,7 +103,7 @@ void mrsaab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
   o_mrdt.copyFrom(mrdt);
   o_shiftIndex.copyFrom(shiftIndex);
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -143,7 +140,7 @@ void mrsaab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
     if (time>outputTime) {
       //report state
-      solver.Report(outputTime,tstep);
+      Report(outputTime,tstep);
       outputTime += outputInterval;
     }
   }
@@ -215,119 +212,42 @@ void mrsaab3::Step(occa::memory &o_q, dfloat time, dfloat _dt, int order) {
 
 void mrsaab3::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
-  }
-
   for(int lev=0; lev<Nlevels; ++lev){
 
     for (int n=0;n<Nfields;n++) {
 
-      if (lambda[n]==0) { //Zero exponential term, usual AB coefficients
-
-        dfloat _saab_X[1]  = { 1.0 };
-        dfloat _saab_A[Nstages*Nstages]
-                      = {    1.0,      0.0,    0.0,
-                           3./2.,   -1./2.,    0.0,
-                         23./12., -16./12., 5./12.};
-        dfloat _saab_B[Nstages*Nstages] = {
-                           1./2.,      0.0,    0.0,
-                           5./8.,   -1./8.,    0.0,
-                         17./24.,  -7./24., 2./24.};
-
-        memcpy(saab_x+n                +lev*Nfields,
-              _saab_X, 1*sizeof(dfloat));
-        memcpy(saab_a+n*Nstages*Nstages+lev*Nfields*Nstages*Nstages,
-              _saab_A,Nstages*Nstages*sizeof(dfloat));
-        memcpy(saab_b+n*Nstages*Nstages+lev*Nfields*Nstages*Nstages,
-              _saab_B,Nstages*Nstages*sizeof(dfloat));
-
-      } else {
-
-        //Compute coefficients via contour integral
-        dfloat alpha = lambda[n]*dt*(1<<lev);
-
-        // Initialize complex variables for contour integral
-        complex<double> a11(0.,0.);
-        complex<double> a21(0.,0.);
-        complex<double> a22(0.,0.);
-        complex<double> a31(0.,0.);
-        complex<double> a32(0.,0.);
-        complex<double> a33(0.,0.);
-
-        complex<double> b11(0.,0.);
-        complex<double> b21(0.,0.);
-        complex<double> b22(0.,0.);
-        complex<double> b31(0.,0.);
-        complex<double> b32(0.,0.);
-        complex<double> b33(0.,0.);
-
-        for(int i = 0; i<Nr; ++i ){
-          complex<double> lr = alpha  + R[i];
-
-          a11 +=  (exp(lr) - 1.)/lr;
-          b11 +=  (exp(lr/2.) - 1.)/lr;
-
-          a21 +=  (-2.*lr + (1.+lr)*exp(lr) - 1.)/pow(lr,2);
-          a22 +=  (lr - exp(lr) + 1.)/pow(lr,2);
-          b21 +=  (-1.5*lr + (1.+lr)*exp(lr/2.) - 1.)/pow(lr,2);
-          b22 +=  (0.5*lr - exp(lr/2.) + 1.)/pow(lr,2);
-
-          a31 += (-2.5*lr - 3.*pow(lr,2) + (1.+pow(lr,2)+1.5*lr)*exp(lr) - 1.)/pow(lr,3);
-          a32 += (4.*lr + 3.*pow(lr,2)- (2.*lr + 2.0)*exp(lr) + 2.)/pow(lr,3);
-          a33 +=-(1.5*lr + pow(lr,2)- (0.5*lr + 1.)*exp(lr) + 1.)/pow(lr,3);
-          b31 += (exp(lr/2.)- 2.*lr - (15.*pow(lr,2))/8. + (pow(lr,2) + 1.5*lr)*exp(lr/2.) - 1.)/pow(lr,3);
-          b32 += (3.*lr - 2.*exp(lr/2.0) + 1.25*pow(lr,2) - 2.*lr*exp(lr/2.) + 2.)/pow(lr,3);
-          b33 +=-(lr - exp(lr/2.) + 0.375*pow(lr,2) - 0.5*lr*exp(lr/2.) + 1.)/pow(lr,3);
-        }
-
-
-        dfloat aa11=real(a11)/ (double) Nr;
-        dfloat bb11=real(b11)/ (double) Nr;
-
-        dfloat aa21=real(a21)/ (double) Nr;
-        dfloat aa22=real(a22)/ (double) Nr;
-        dfloat bb21=real(b21)/ (double) Nr;
-        dfloat bb22=real(b22)/ (double) Nr;
-
-        dfloat aa31=real(a31)/ (double) Nr;
-        dfloat aa32=real(a32)/ (double) Nr;
-        dfloat aa33=real(a33)/ (double) Nr;
-
-        dfloat bb31=real(b31)/ (double) Nr;
-        dfloat bb32=real(b32)/ (double) Nr;
-        dfloat bb33=real(b33)/ (double) Nr;
-
-        dfloat _saab_X[1]  = { exp(alpha) };
-        dfloat _saab_A[Nstages*Nstages]
-                        ={   aa11,   0.0,   0.0,
-                             aa21,  aa22,   0.0,
-                             aa31,  aa32,  aa33 };
-        dfloat _saab_B[Nstages*Nstages]
-                        ={   bb11,   0.0,   0.0,
-                             bb21,  bb22,   0.0,
-                             bb31,  bb32,  bb33 };
-
-        memcpy(saab_x+n                +lev*Nfields,
-              _saab_X, 1*sizeof(dfloat));
-        memcpy(saab_a+n*Nstages*Nstages+lev*Nfields*Nstages*Nstages,
-              _saab_A,Nstages*Nstages*sizeof(dfloat));
-        memcpy(saab_b+n*Nstages*Nstages+lev*Nfields*Nstages*Nstages,
-              _saab_B,Nstages*Nstages*sizeof(dfloat));
-      }
+      //AB3 coefficients as phi-function combinations of z = lambda*dt_lev.
+      // a integrates over the full level step, b over its first half.
+      // phi_k(0) = 1/k! recovers the usual AB coefficients
+      const dfloat z = lambda[n]*dt*(1<<lev);
+
+      dfloat pa[4], pb[4]; //phi_k(z), phi_k(z/2)
+      phiFunctions(    z, 3, pa);
+      phiFunctions(0.5*z, 3, pb);
+
+      dfloat _saab_X[1]  = { pa[0] };
+      dfloat _saab_A[Nstages*Nstages]
+                ={ pa[1],                         0.0,                    0.0,
+                   pa[1]+pa[2],                  -pa[2],                  0.0,
+                   pa[1]+(dfloat)1.5*pa[2]+pa[3],  (dfloat)-2.0*(pa[2]+pa[3]),  (dfloat)0.5*pa[2]+pa[3] };
+      dfloat _saab_B[Nstages*Nstages]
+                ={ (dfloat)0.5*pb[1],                                          0.0,                           0.0,
+                   (dfloat)0.5*pb[1]+(dfloat)0.25*pb[2],                   (dfloat)-0.25*pb[2],                    0.0,
+                   (dfloat)0.5*pb[1]+(dfloat)0.375*pb[2]+(dfloat)0.125*pb[3], (dfloat)-0.5*pb[2]-(dfloat)0.25*pb[3], (dfloat)0.125*(pb[2]+pb[3]) };
+
+      memcpy(saab_x+n                +lev*Nfields,
+            _saab_X, 1*sizeof(dfloat));
+      memcpy(saab_a+n*Nstages*Nstages+lev*Nfields*Nstages*Nstages,
+            _saab_A,Nstages*Nstages*sizeof(dfloat));
+      memcpy(saab_b+n*Nstages*Nstages+lev*Nfields*Nstages*Nstages,
+            _saab_B,Nstages*Nstages*sizeof(dfloat));
     }
-
-    // move data to platform
-    o_saab_x.copyFrom(saab_x);
-    o_saab_a.copyFrom(saab_a);
-    o_saab_b.copyFrom(saab_b);
   }
+
+  // move data to platform
+  o_saab_x.copyFrom(saab_x);
+  o_saab_a.copyFrom(saab_a);
+  o_saab_b.copyFrom(saab_b);
 }
 
 mrsaab3::~mrsaab3() {
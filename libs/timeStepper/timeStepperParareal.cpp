@@ -0,0 +1,412 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+
+namespace TimeStepper {
+
+parareal::parareal(dlong Nelements, dlong NhaloElements,
+                   int Np, int Nfields, solver_t& _solver,
+                   MPI_Comm _comm, MPI_Comm _globalComm,
+                   timeStepper_t* _coarse, timeStepper_t* _fine):
+  timeStepper_t(Nelements, NhaloElements, Np, Nfields, _solver),
+  comm(_comm),
+  coarse(_coarse),
+  fine(_fine) {
+
+  platform_t &platform = solver.platform;
+
+  //time communicator connects this rank with the same space rank in every slice
+  int rank, globalRank;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_rank(_globalComm, &globalRank);
+  MPI_Comm_split(_globalComm, rank, globalRank, &timeComm);
+
+  MPI_Comm_rank(timeComm, &timeRank);
+  MPI_Comm_size(timeComm, &Nslices);
+
+  fcf = solver.settings.compareSetting("PARALLEL IN TIME", "MGRIT") ? 1 : 0;
+
+  solver.settings.getSetting("PARALLEL IN TIME ITERATIONS", maxIterations);
+  solver.settings.getSetting("PARALLEL IN TIME TOLERANCE", tol);
+  solver.settings.getSetting("COARSE TIME STEP FACTOR", coarseFactor);
+
+  //the coarse step must stay inside the stability bound the CFL number refers to
+  dfloat cfl=1.0;
+  solver.settings.getSetting("CFL NUMBER", cfl);
+  if (coarseFactor<1.0 || cfl*coarseFactor>1.0) {
+    stringstream ss;
+    ss << "COARSE TIME STEP FACTOR (" << coarseFactor << ") must be at least 1 and"
+       << " at most 1/CFL NUMBER (" << 1.0/cfl << ")";
+    LIBP_ABORT(ss.str());
+  }
+
+  //the iteration is exact after Nslices iterations
+  if (maxIterations<1 || maxIterations>Nslices) maxIterations = Nslices;
+
+  //propagators only report through the driver
+  coarse->SetOutput(0);
+  fine->SetOutput(0);
+
+  sendq = (dfloat*) platform.hostMalloc(N*sizeof(dfloat), NULL, h_sendq);
+  recvq = (dfloat*) platform.hostMalloc(N*sizeof(dfloat), NULL, h_recvq);
+
+  o_U     = platform.malloc(N*sizeof(dfloat));
+  o_Unext = platform.malloc(N*sizeof(dfloat));
+  o_F     = platform.malloc(N*sizeof(dfloat));
+  o_G     = platform.malloc(N*sizeof(dfloat));
+  o_prop  = platform.malloc((N+Nhalo)*sizeof(dfloat));
+
+  platform.linAlg.InitKernels({"axpy", "norm2"});
+}
+
+MPI_Comm parareal::SplitComm(MPI_Comm comm, int Nslices) {
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  if (Nslices<1 || size%Nslices) {
+    stringstream ss;
+    ss << "TIME SLICES (" << Nslices << ") must divide the number of ranks (" << size << ")";
+    LIBP_ABORT(ss.str());
+  }
+
+  //ranks of a space communicator are contiguous, so they share nodes
+  const int spaceSize = size/Nslices;
+
+  MPI_Comm spaceComm;
+  MPI_Comm_split(comm, rank/spaceSize, rank, &spaceComm);
+  return spaceComm;
+}
+
+void parareal::AddSettings(settings_t& settings) {
+
+  settings.newSetting("PARALLEL IN TIME",
+                      "NONE",
+                      "Parallel-in-time method wrapped around the time integrator",
+                      {"NONE", "PARAREAL", "MGRIT"});
+
+  settings.newSetting("TIME SLICES",
+                      "1",
+                      "Number of time slices solved concurrently, must divide the number of ranks");
+
+  settings.newSetting("COARSE TIME INTEGRATOR",
+                      "AB3",
+                      "Coarse propagator of the parallel-in-time method",
+                      {"AB3", "LSERK4"});
+
+  settings.newSetting("COARSE POLYNOMIAL DEGREE",
+                      "1",
+                      "Degree of the mesh the coarse propagator runs on (0 for the degree of the mesh)");
+
+  settings.newSetting("COARSE TIME STEP FACTOR",
+                      "1",
+                      "Coarse propagator time step as a multiple of the stable step of its mesh, at most 1/CFL NUMBER");
+
+  settings.newSetting("PARALLEL IN TIME ITERATIONS",
+                      "0",
+                      "Maximum parallel-in-time iterations (0 for the number of time slices)");
+
+  settings.newSetting("PARALLEL IN TIME TOLERANCE",
+                      "1E-8",
+                      "Relative change of the slice end states at which the iterations stop");
+}
+
+void parareal::ReportSettings(settings_t& settings) {
+
+  settings.reportSetting("PARALLEL IN TIME");
+  if (!settings.compareSetting("PARALLEL IN TIME","NONE")) {
+    settings.reportSetting("TIME SLICES");
+    settings.reportSetting("COARSE TIME INTEGRATOR");
+    settings.reportSetting("COARSE POLYNOMIAL DEGREE");
+    settings.reportSetting("COARSE TIME STEP FACTOR");
+    settings.reportSetting("PARALLEL IN TIME ITERATIONS");
+    settings.reportSetting("PARALLEL IN TIME TOLERANCE");
+  }
+}
+
+void parareal::SetCoarseSpace(mesh_t& mesh, mesh_t& meshC,
+                              solver_t* _coarseSolver, settings_t* _coarseSettings) {
+
+  platform_t &platform = solver.platform;
+
+  coarseSolver = _coarseSolver;
+  coarseSettings = _coarseSettings;
+
+  NtransferElements = mesh.Nelements;
+  const int Nfields = N/(mesh.Nelements*mesh.Np);
+  const int Np = mesh.Np, NpC = meshC.Np;
+
+  //explicit steps are bounded by h/(N+1)^2
+  coarseDtScale = (mesh.N+1.)*(mesh.N+1.)/((meshC.N+1.)*(meshC.N+1.));
+
+  //prolongation P interpolates the coarse polynomial at the fine nodes
+  dfloat *P = (dfloat*) calloc(Np*NpC, sizeof(dfloat));
+  if (mesh.elementType==TRIANGLES) {
+    mesh.DegreeRaiseMatrixTri2D(meshC.N, mesh.N, P);
+  } else if (mesh.elementType==TETRAHEDRA) {
+    mesh.DegreeRaiseMatrixTet3D(meshC.N, mesh.N, P);
+  } else {
+    //tensor product of the 1D degree raise
+    const int Nq = mesh.N+1, NqC = meshC.N+1;
+    dfloat *P1 = (dfloat*) calloc(Nq*NqC, sizeof(dfloat));
+    mesh.DegreeRaiseMatrix1D(meshC.N, mesh.N, P1);
+
+    const int NqZ  = (mesh.dim==3) ? Nq : 1;
+    const int NqCZ = (mesh.dim==3) ? NqC : 1;
+    for (int k=0;k<NqZ;k++) for (int j=0;j<Nq;j++) for (int i=0;i<Nq;i++) {
+      const int n = i + j*Nq + k*Nq*Nq;
+      for (int c=0;c<NqCZ;c++) for (int b=0;b<NqC;b++) for (int a=0;a<NqC;a++) {
+        const int m = a + b*NqC + c*NqC*NqC;
+        P[n*NpC+m] = P1[i*NqC+a]*P1[j*NqC+b]*((mesh.dim==3) ? P1[k*NqC+c] : 1.0);
+      }
+    }
+    free(P1);
+  }
+
+  //restriction R = (P^T M P)^{-1} P^T M is the L2 projection onto the coarse space
+  dfloat *PtM = (dfloat*) calloc(NpC*Np, sizeof(dfloat));
+  dfloat *PtMP = (dfloat*) calloc(NpC*NpC, sizeof(dfloat));
+  dfloat *R = (dfloat*) calloc(NpC*Np, sizeof(dfloat));
+  for (int m=0;m<NpC;m++)
+    for (int n=0;n<Np;n++)
+      for (int k=0;k<Np;k++)
+        PtM[m*Np+n] += P[k*NpC+m]*mesh.MM[k*Np+n];
+  for (int m=0;m<NpC;m++)
+    for (int c=0;c<NpC;c++)
+      for (int n=0;n<Np;n++)
+        PtMP[m*NpC+c] += PtM[m*Np+n]*P[n*NpC+c];
+  matrixInverse(NpC, PtMP);
+  for (int m=0;m<NpC;m++)
+    for (int n=0;n<Np;n++)
+      for (int c=0;c<NpC;c++)
+        R[m*Np+n] += PtMP[m*NpC+c]*PtM[c*Np+n];
+
+  o_P = platform.malloc(Np*NpC*sizeof(dfloat), P);
+  o_R = platform.malloc(NpC*Np*sizeof(dfloat), R);
+  free(P); free(PtM); free(PtMP); free(R);
+
+  const dlong NC     = meshC.Nelements*NpC*Nfields;
+  const dlong NhaloC = meshC.totalHaloPairs*NpC*Nfields;
+  o_qc = platform.malloc((NC+NhaloC)*sizeof(dfloat));
+
+  occa::properties kernelInfo = platform.props;
+  kernelInfo["defines/" "p_Nfields"] = Nfields;
+
+  kernelInfo["defines/" "p_NpIn"]  = Np;
+  kernelInfo["defines/" "p_NpOut"] = NpC;
+  restrictKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                        "timeStepperParareal.okl",
+                                        "pararealTransfer",
+                                        kernelInfo);
+
+  kernelInfo["defines/" "p_NpIn"]  = NpC;
+  kernelInfo["defines/" "p_NpOut"] = Np;
+  prolongKernel = platform.buildKernel(TIMESTEPPER_DIR "/okl/"
+                                       "timeStepperParareal.okl",
+                                       "pararealTransfer",
+                                       kernelInfo);
+}
+
+// Propagate o_q0 from start to end with stepper, result in o_prop
+void parareal::Propagate(timeStepper_t* stepper, occa::memory& o_q0,
+                         dfloat start, dfloat end) {
+
+  platform_t &platform = solver.platform;
+
+  //whole number of steps per slice. The step is nudged up so that
+  // round-off in the accumulated time does not add a step
+  const dfloat stepdt = stepper==coarse ? coarseFactor*coarseDtScale*dt : dt;
+  const int Nsteps = mymax(1, (int) ceil((end-start)/stepdt));
+  stepper->SetTimeStep((end-start)/Nsteps
+                       *(1.0+100*std::numeric_limits<dfloat>::epsilon()));
+
+  platform.device.finish();
+  double tic = MPI_Wtime();
+
+  if (stepper==coarse && coarseSolver) {
+    restrictKernel(NtransferElements, o_R, o_q0, o_qc);
+    stepper->Run(o_qc, start, end);
+    prolongKernel(NtransferElements, o_P, o_qc, o_prop);
+  } else {
+    o_prop.copyFrom(o_q0, N*sizeof(dfloat));
+    stepper->Run(o_prop, start, end);
+  }
+
+  platform.device.finish();
+  double toc = MPI_Wtime();
+
+  if (stepper==coarse) {
+    coarseTime += toc-tic;
+    Ncoarse++;
+  } else {
+    fineTime += toc-tic;
+    Nfine++;
+  }
+}
+
+void parareal::SendNext(occa::memory& o_q) {
+  o_q.copyTo(sendq, N*sizeof(dfloat));
+  MPI_Send(sendq, N, MPI_DFLOAT, timeRank+1, 0, timeComm);
+}
+
+void parareal::RecvPrev(occa::memory& o_q) {
+  MPI_Recv(recvq, N, MPI_DFLOAT, timeRank-1, 0, timeComm, MPI_STATUS_IGNORE);
+  o_q.copyFrom(recvq, N*sizeof(dfloat));
+}
+
+void parareal::Run(occa::memory &o_q, dfloat start, dfloat end) {
+
+  platform_t &platform = solver.platform;
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  //this rank's time slice
+  const dfloat Tslice = (end-start)/Nslices;
+  const dfloat t0 = start + timeRank*Tslice;
+  const dfloat t1 = (timeRank==Nslices-1) ? end : t0 + Tslice;
+
+  const int first = (timeRank==0);
+  const int last  = (timeRank==Nslices-1);
+
+  if (first) Report(start,0);
+
+  double tic = MPI_Wtime();
+
+  //initial coarse sweep
+  if (first) o_U.copyFrom(o_q, N*sizeof(dfloat));
+  else       RecvPrev(o_U);
+
+  Propagate(coarse, o_U, t0, t1);
+  o_G.copyFrom(o_prop, N*sizeof(dfloat));
+  o_Unext.copyFrom(o_G, N*sizeof(dfloat));
+  if (!last) SendNext(o_Unext);
+
+  int iter=0;
+  while (iter<maxIterations) {
+    iter++;
+
+    //F-relaxation
+    Propagate(fine, o_U, t0, t1);
+    o_F.copyFrom(o_prop, N*sizeof(dfloat));
+
+    if (fcf) {
+      //C-relaxation, restart each slice from the fine solution of the previous
+      if (!last)  SendNext(o_F);
+      if (!first) {
+        RecvPrev(o_U);
+
+        //F-relaxation
+        Propagate(fine, o_U, t0, t1);
+        o_F.copyFrom(o_prop, N*sizeof(dfloat));
+        Propagate(coarse, o_U, t0, t1);
+        o_G.copyFrom(o_prop, N*sizeof(dfloat));
+      }
+    }
+
+    //coarse correction, sequential in time
+    // Unext = G(Unew) + F(U) - G(U)
+    if (!first) RecvPrev(o_U);
+    Propagate(coarse, o_U, t0, t1);
+
+    platform.linAlg.axpy(N, -1.0, o_G, 1.0, o_F);
+    o_G.copyFrom(o_prop, N*sizeof(dfloat));
+    platform.linAlg.axpy(N,  1.0, o_G, 1.0, o_F);
+
+    //change of this slice's end state
+    platform.linAlg.axpy(N, 1.0, o_F, -1.0, o_Unext);
+    dfloat change = platform.linAlg.norm2(N, o_Unext, comm);
+    dfloat scale  = platform.linAlg.norm2(N, o_F, comm);
+
+    o_Unext.copyFrom(o_F, N*sizeof(dfloat));
+    if (!last) SendNext(o_Unext);
+
+    dfloat err = (scale>0.0) ? change/scale : change;
+    dfloat maxErr;
+    MPI_Allreduce(&err, &maxErr, 1, MPI_DFLOAT, MPI_MAX, timeComm);
+
+    if (first && rank==0)
+      printf("Parallel-in-time iteration %d, relative change %g\n", iter, maxErr);
+
+    if (maxErr<tol) break;
+  }
+
+  //share the final state with every slice
+  if (last) o_Unext.copyTo(sendq, N*sizeof(dfloat));
+  MPI_Bcast(sendq, N, MPI_DFLOAT, Nslices-1, timeComm);
+  o_q.copyFrom(sendq, N*sizeof(dfloat));
+
+  double runTime = MPI_Wtime()-tic;
+
+  //a serial-in-time run would make Nslices fine propagations one after the
+  // other. Compare with the measured run so a coarse propagator that is too
+  // expensive, or too many iterations, show up
+  double times[3] = {runTime, fineTime/mymax(Nfine,1), coarseTime/mymax(Ncoarse,1)};
+  double maxTimes[3];
+  MPI_Allreduce(times, maxTimes, 3, MPI_DOUBLE, MPI_MAX, timeComm);
+
+  const double costRatio = maxTimes[2]/maxTimes[1];
+  const double speedup = Nslices*maxTimes[1]/maxTimes[0];
+
+  //printed by the slice which reports the final solution, so it comes first
+  if (last && rank==0) {
+    printf("Parallel-in-time: %d iterations, coarse/fine propagator cost %5.3f,"
+           " estimated speedup over serial-in-time %5.2f\n", iter, costRatio, speedup);
+    if (speedup<=1.0)
+      LIBP_WARNING("Parallel-in-time run is not faster than serial-in-time."
+                   " Lower the COARSE POLYNOMIAL DEGREE or raise the COARSE TIME STEP FACTOR");
+  }
+
+  if (last) Report(end,iter);
+}
+
+parareal::~parareal() {
+  if (o_U.size()) o_U.free();
+  if (o_Unext.size()) o_Unext.free();
+  if (o_F.size()) o_F.free();
+  if (o_G.size()) o_G.free();
+  if (o_prop.size()) o_prop.free();
+  if (o_qc.size()) o_qc.free();
+  if (o_R.size()) o_R.free();
+  if (o_P.size()) o_P.free();
+  if (h_sendq.size()) h_sendq.free();
+  if (h_recvq.size()) h_recvq.free();
+
+  MPI_Comm_free(&timeComm);
+
+  restrictKernel.free();
+  prolongKernel.free();
+
+  delete coarse;
+  delete fine;
+  if (coarseSolver) delete coarseSolver;
+  if (coarseSettings) delete coarseSettings;
+}
+
+} //namespace TimeStepper
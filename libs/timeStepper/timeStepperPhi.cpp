@@ -0,0 +1,69 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "core.hpp"
+#include "timeStepper.hpp"
+
+namespace TimeStepper {
+
+// Evaluate phi_k(z), k=0,...,kmax, for a real (diagonal) stiff term z = lambda*dt
+//  phi_0(z) = exp(z)
+//  phi_k(z) = sum_{j>=0} z^j/(j+k)!
+//           = (phi_{k-1}(z) - 1/(k-1)!)/z
+//  The recurrence cancels catastrophically near z=0, so the Taylor
+//  series is used there instead. For |z|<1 twenty terms reach round-off.
+void phiFunctions(const dfloat z, const int kmax, dfloat *phi) {
+
+  const double zd = z;
+
+  if (fabs(zd)<1.0) {
+    const int Nterms = 20;
+
+    double kfact = 1.0; // k!
+    for (int k=0;k<=kmax;k++) {
+      //Horner evaluation of sum_{j} z^j k!/(j+k)!
+      double s = 1.0;
+      for (int j=Nterms;j>=1;j--)
+        s = 1.0 + s*zd/(j+k);
+
+      phi[k] = s/kfact;
+      kfact *= (k+1);
+    }
+  } else {
+    double p = exp(zd);
+    double kfact = 1.0; // (k-1)!
+
+    phi[0] = p;
+    for (int k=1;k<=kmax;k++) {
+      p = (p - 1.0/kfact)/zd;
+      phi[k] = p;
+      kfact *= k;
+    }
+  }
+}
+
+} //namespace TimeStepper
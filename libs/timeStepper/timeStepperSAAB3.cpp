@@ -26,12 +26,9 @@ SOFTWARE.
 
 #include "core.hpp"
 #include "timeStepper.hpp"
-#include <complex>
 
 namespace TimeStepper {
 
-using std::complex;
-
 saab3::saab3(dlong _Nelements, dlong _NhaloElements,
              int _Np, int _Nfields,
              dfloat *_lambda, solver_t& _solver):
@@ -46,6 +43,12 @@ saab3::saab3(dlong _Nelements, dlong _NhaloElements,
   lambda = (dfloat *) malloc(Nfields*sizeof(dfloat));
   memcpy(lambda, _lambda, Nfields*sizeof(dfloat));
 
+  //all elements share the same stiff terms by default
+  Ngroups = 1;
+  dlong *group = (dlong *) calloc(Nelements, sizeof(dlong));
+  o_group = platform.malloc(Nelements*sizeof(dlong), group);
+  free(group);
+
   Nstages = 3;
   shiftIndex = 0;
 
@@ -70,11 +73,34 @@ saab3::saab3(dlong _Nelements, dlong _NhaloElements,
   o_saab_a =  platform.malloc(Nfields*Nstages*Nstages*sizeof(dfloat));
 }
 
+//set per-element stiff terms. Element e uses lambda[elementGroup[e]*Nfields+f]
+void saab3::SetLambdaGroups(int _Ngroups, dfloat *_lambda, dlong *elementGroup) {
+
+  platform_t &platform = solver.platform;
+
+  Ngroups = _Ngroups;
+
+  free(lambda);
+  lambda = (dfloat *) malloc(Ngroups*Nfields*sizeof(dfloat));
+  memcpy(lambda, _lambda, Ngroups*Nfields*sizeof(dfloat));
+
+  o_group.copyFrom(elementGroup, Nelements*sizeof(dlong));
+
+  free(saab_x); free(saab_a);
+  o_saab_x.free(); o_saab_a.free();
+
+  saab_x = (dfloat*) malloc(Ngroups*Nfields*sizeof(dfloat));
+  o_saab_x = platform.malloc(Ngroups*Nfields*sizeof(dfloat));
+
+  saab_a = (dfloat*) malloc(Ngroups*Nfields*Nstages*Nstages*sizeof(dfloat));
+  o_saab_a =  platform.malloc(Ngroups*Nfields*Nstages*Nstages*sizeof(dfloat));
+}
+
 void saab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -94,7 +120,7 @@ void saab3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
     if (time>outputTime) {
       //report state
-      solver.Report(time,tstep);
+      Report(time,tstep);
       outputTime += outputInterval;
     }
   }
@@ -116,6 +142,7 @@ void saab3::Step(occa::memory &o_q, dfloat time, dfloat _dt, int order) {
   updateKernel(Nelements,
                dt,
                shiftIndex,
+               o_group,
                o_X,
                o_A,
                o_rhsq,
@@ -127,83 +154,32 @@ void saab3::Step(occa::memory &o_q, dfloat time, dfloat _dt, int order) {
 
 void saab3::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
-  }
-
-  for (int n=0;n<Nfields;n++) {
-
-    if (lambda[n]==0) { //Zero exponential term, usual AB coefficients
+  //AB3 coefficients as phi-function combinations of z = lambda*dt.
+  // phi_k(0) = 1/k! recovers the usual AB coefficients
+  for (int c=0;c<Ngroups*Nfields;c++) {
+    const dfloat z = lambda[c]*dt;
 
-      dfloat _saab_X[1]  = { 1.0 };
-      dfloat _saab_A[Nstages*Nstages]
-                    = {    1.0,      0.0,    0.0,
-                         3./2.,   -1./2.,    0.0,
-                       23./12., -16./12., 5./12.};
+    dfloat phi[4];
+    phiFunctions(z, 3, phi);
 
-      memcpy(saab_x+n                ,_saab_X,    1*sizeof(dfloat));
-      memcpy(saab_a+n*Nstages*Nstages,_saab_A,Nstages*Nstages*sizeof(dfloat));
+    dfloat _saab_X[1]  = { phi[0] };
+    dfloat _saab_A[Nstages*Nstages]
+              ={ phi[1],                         0.0,                    0.0,
+                 phi[1]+phi[2],                 -phi[2],                 0.0,
+                 phi[1]+(dfloat)1.5*phi[2]+phi[3], (dfloat)-2.0*(phi[2]+phi[3]), (dfloat)0.5*phi[2]+phi[3] };
 
-    } else {
-
-      //Compute coefficients via contour integral
-      dfloat alpha = lambda[n]*dt;
-
-      // Initialize complex variables for contour integral
-      complex<double> a11(0.,0.);
-      complex<double> a21(0.,0.);
-      complex<double> a22(0.,0.);
-      complex<double> a31(0.,0.);
-      complex<double> a32(0.,0.);
-      complex<double> a33(0.,0.);
-
-      for(int i = 0; i<Nr; ++i ){
-        complex<double> lr = alpha  + R[i];
-
-        a11 +=  (exp(lr) - 1.)/lr;
-
-        a21 +=  (-2.*lr + (1.+lr)*exp(lr) - 1.)/pow(lr,2);
-        a22 +=  (lr - exp(lr) + 1.)/pow(lr,2);
-
-        a31 += (-2.5*lr - 3.*pow(lr,2) + (1.+pow(lr,2)+1.5*lr)*exp(lr) - 1.)/pow(lr,3);
-        a32 += (4.*lr + 3.*pow(lr,2)- (2.*lr + 2.0)*exp(lr) + 2.)/pow(lr,3);
-        a33 +=-(1.5*lr + pow(lr,2)- (0.5*lr + 1.)*exp(lr) + 1.)/pow(lr,3);
-      }
-
-
-      dfloat aa11=real(a11)/ (double) Nr;
-
-      dfloat aa21=real(a21)/ (double) Nr;
-      dfloat aa22=real(a22)/ (double) Nr;
-
-      dfloat aa31=real(a31)/ (double) Nr;
-      dfloat aa32=real(a32)/ (double) Nr;
-      dfloat aa33=real(a33)/ (double) Nr;
-
-      dfloat _saab_X[1]  = { exp(alpha) };
-      dfloat _saab_A[Nstages*Nstages]
-                      ={   aa11,   0.0,   0.0,
-                           aa21,  aa22,   0.0,
-                           aa31,  aa32,  aa33 };
-
-      memcpy(saab_x+n                ,_saab_X,    1*sizeof(dfloat));
-      memcpy(saab_a+n*Nstages*Nstages,_saab_A,Nstages*Nstages*sizeof(dfloat));
-    }
-
-    // move data to platform
-    o_saab_x.copyFrom(saab_x);
-    o_saab_a.copyFrom(saab_a);
+    memcpy(saab_x+c                ,_saab_X,    1*sizeof(dfloat));
+    memcpy(saab_a+c*Nstages*Nstages,_saab_A,Nstages*Nstages*sizeof(dfloat));
   }
+
+  // move data to platform
+  o_saab_x.copyFrom(saab_x);
+  o_saab_a.copyFrom(saab_a);
 }
 
 saab3::~saab3() {
   if (o_rhsq.size()) o_rhsq.free();
+  if (o_group.size()) o_group.free();
   if (o_saab_x.size()) o_saab_x.free();
   if (o_saab_a.size()) o_saab_a.free();
 
@@ -280,6 +256,7 @@ void saab3_pml::Step(occa::memory &o_q, dfloat time, dfloat _dt, int order) {
   updateKernel(Nelements,
                dt,
                shiftIndex,
+               o_group,
                o_X,
                o_A,
                o_rhsq,
@@ -27,17 +27,13 @@ SOFTWARE.
 #include <math.h>
 #include "solver.hpp"
 #include "timeStepper.hpp"
-#include <complex>
 
 namespace TimeStepper {
 
-using std::complex;
-
 sark4::sark4(dlong _Nelements, dlong _NhaloElements,
              int _Np, int _Nfields,
              dfloat *_lambda, solver_t& _solver, MPI_Comm _comm):
-  timeStepper_t(_Nelements, _NhaloElements, _Np, _Nfields, _solver),
-  comm(_comm),
+  adaptiveRk_t(_Nelements, _NhaloElements, _Np, _Nfields, _solver, _comm),
   Np(_Np),
   Nfields(_Nfields),
   Nelements(_Nelements),
@@ -48,28 +44,23 @@ sark4::sark4(dlong _Nelements, dlong _NhaloElements,
   lambda = (dfloat *) malloc(Nfields*sizeof(dfloat));
   memcpy(lambda, _lambda, Nfields*sizeof(dfloat));
 
+  //all elements share the same stiff terms by default
+  Ngroups = 1;
+  dlong *group = (dlong *) calloc(Nelements, sizeof(dlong));
+  o_group = platform.malloc(Nelements*sizeof(dlong), group);
+  free(group);
+
   Nrk = 5;
   order = 4;
   embeddedOrder = 3;
 
   dlong Nlocal = Nelements*Np*Nfields;
-  dlong Ntotal = (Nelements+NhaloElements)*Np*Nfields;
 
-  o_rkq    = platform.malloc(Ntotal*sizeof(dfloat));
   o_rhsq   = platform.malloc(Nlocal*sizeof(dfloat));
   o_rkrhsq = platform.malloc(Nlocal*Nrk*sizeof(dfloat));
-  o_rkerr  = platform.malloc(Nlocal*sizeof(dfloat));
 
   o_saveq  = platform.malloc(Nlocal*sizeof(dfloat));
 
-  Nblock = (N+BLOCKSIZE-1)/BLOCKSIZE;
-  errtmp = (dfloat*) calloc(Nblock, sizeof(dfloat));
-  o_errtmp = platform.malloc(Nblock*sizeof(dfloat));
-
-  hlong gNlocal = Nlocal;
-  hlong gNtotal;
-  MPI_Allreduce(&gNlocal, &gNtotal, 1, MPI_HLONG, MPI_SUM, comm);
-
   //copy base occa properties from platform
   occa::properties kernelInfo = solver.platform.props;
 
@@ -121,17 +112,46 @@ sark4::sark4(dlong _Nelements, dlong _NhaloElements,
   invfactor1 = 1.0/factor1;
   invfactor2 = 1.0/factor2;
   facold = 1E-4;
-  sqrtinvNtotal = 1.0/sqrt(gNtotal);
+}
+
+//set per-element stiff terms. Element e uses lambda[elementGroup[e]*Nfields+f]
+void sark4::SetLambdaGroups(int _Ngroups, dfloat *_lambda, dlong *elementGroup) {
+
+  platform_t &platform = solver.platform;
+
+  Ngroups = _Ngroups;
+
+  free(lambda);
+  lambda = (dfloat *) malloc(Ngroups*Nfields*sizeof(dfloat));
+  memcpy(lambda, _lambda, Ngroups*Nfields*sizeof(dfloat));
+
+  o_group.copyFrom(elementGroup, Nelements*sizeof(dlong));
+
+  h_rkX.free(); h_rkA.free(); h_rkE.free();
+  o_rkX.free(); o_rkA.free(); o_rkE.free();
+
+  rkX = (dfloat*) platform.hostMalloc(Ngroups*Nfields*Nrk*    sizeof(dfloat), NULL, h_rkX);
+  rkA = (dfloat*) platform.hostMalloc(Ngroups*Nfields*Nrk*Nrk*sizeof(dfloat), NULL, h_rkA);
+  rkE = (dfloat*) platform.hostMalloc(Ngroups*Nfields*Nrk*    sizeof(dfloat), NULL, h_rkE);
+
+  o_rkX = platform.malloc(Ngroups*Nfields*Nrk*    sizeof(dfloat));
+  o_rkA = platform.malloc(Ngroups*Nfields*Nrk*Nrk*sizeof(dfloat));
+  o_rkE = platform.malloc(Ngroups*Nfields*Nrk*    sizeof(dfloat));
 }
 
 void sark4::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
+  if (speculate) {
+    RunSpeculative(o_q, start, end);
+    return;
+  }
+
   dfloat time = start;
 
   int rank;
   MPI_Comm_rank(comm, &rank);
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -176,7 +196,7 @@ void sark4::Run(occa::memory &o_q, dfloat start, dfloat end) {
     if (err<1.0) { //dt is accepted
 
       // check for output during this step and do a mini-step
-      if (time<outputTime && time+dt>=outputTime) {
+      if (output && time<outputTime && time+dt>=outputTime) {
         dfloat savedt = dt;
 
         // save rkq
@@ -199,7 +219,7 @@ void sark4::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
         // output  (print from rkq)
         // if (!rank) printf("\n");
-        solver.Report(outputTime,tstep);
+        Report(outputTime,tstep);
 
         // restore time step
         dt = savedt;
@@ -270,6 +290,7 @@ void sark4::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkStageKernel(Nelements,
                   rk,
                   _dt,
+                  o_group,
                   o_rkX,
                   o_rkA,
                   o_q,
@@ -287,6 +308,7 @@ void sark4::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkUpdateKernel(Nelements,
                    rk,
                    _dt,
+                   o_group,
                    o_rkX,
                    o_rkA,
                    o_rkE,
@@ -298,143 +320,59 @@ void sark4::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
   }
 }
 
-dfloat sark4::Estimater(occa::memory& o_q){
-
-  //Error estimation
-  //E. HAIRER, S.P. NORSETT AND G. WANNER, SOLVING ORDINARY
-  //      DIFFERENTIAL EQUATIONS I. NONSTIFF PROBLEMS. 2ND EDITION.
-  rkErrorEstimateKernel(Nelements*Np*Nfields,
-                        ATOL,
-                        RTOL,
-                        o_q,
-                        o_rkq,
-                        o_rkerr,
-                        o_errtmp);
-
-  o_errtmp.copyTo(errtmp);
-  dfloat localerr = 0;
-  dfloat err = 0;
-  for(dlong n=0;n<Nblock;++n){
-    localerr += errtmp[n];
-  }
-  MPI_Allreduce(&localerr, &err, 1, MPI_DFLOAT, MPI_SUM, comm);
-
-  err = sqrt(err)*sqrtinvNtotal;
-
-  return err;
-}
-
 void sark4::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
-  }
-
-  for (int n=0;n<Nfields;n++) {
-
-    if (lambda[n]==0) { //Zero exponential term, usual RK coefficients
-
-      dfloat _rkX[Nrk]  = {1.0, 1.0, 1.0, 1.0, 1.0 };
-      dfloat _rkA[Nrk*Nrk]
-                    = {      0.0,      0.0,       0.0,      0.0,       0.0,
-                             0.5,      0.0,       0.0,      0.0,       0.0,
-                             0.0,      0.5,       0.0,      0.0,       0.0,
-                             0.0,      0.0,       1.0,      0.0,       0.0,
-                         1.0/6.0,  1.0/3.0,   1.0/3.0,   1.0/6.0,      0.0};
-      dfloat _rkE[Nrk]= {    0.0,      0.0,       0.0,  -1.0/6.0,  1.0/6.0};
-
-      memcpy(rkX+n*Nrk    ,_rkX,    Nrk*sizeof(dfloat));
-      memcpy(rkA+n*Nrk*Nrk,_rkA,Nrk*Nrk*sizeof(dfloat));
-      memcpy(rkE+n*Nrk    ,_rkE,    Nrk*sizeof(dfloat));
+  //RK coefficients as phi-function combinations of z = lambda*dt.
+  // phi_k(0) = 1/k! recovers the usual RK coefficients
+  for (int c=0;c<Ngroups*Nfields;c++) {
+    const dfloat z = lambda[c]*dt;
 
-    } else {
-
-      //Compute RK coefficients via contour integral
-      dfloat alpha = lambda[n]*dt;
+    dfloat p2[4], p1[4]; //phi_k(z/2), phi_k(z)
+    phiFunctions(0.5*z, 3, p2);
+    phiFunctions(    z, 3, p1);
 
-      // Initialize complex variables for contour integral
-      complex<double> ca21(0.,0.);
-      complex<double> ca31(0.,0.);
-      complex<double> ca32(0.,0.);
-      complex<double> ca41(0.,0.);
-      complex<double> ca43(0.,0.);
-      complex<double> ca51(0.,0.);
-      complex<double> ca52(0.,0.);
-      complex<double> ca53(0.,0.);
-      complex<double> ca54(0.,0.);
+    dfloat a21 = 0.5*p2[1];
 
-      for(int i = 0; i<Nr; ++i ){
-        complex<double> lr = alpha  + R[i];
+    dfloat a31 = 0.5*p2[1] - p2[2];
+    dfloat a32 = p2[2];
 
-        ca21 +=  (exp(lr/2.) - 1.)/lr;
+    dfloat a41 = p1[1] - 2.0*p1[2];
+    dfloat a43 = 2.0*p1[2];
 
-        ca31 +=  (4. + exp(lr/2.)*(-4. + lr) + lr)/pow(lr,2);
-        ca32 +=  (4.*exp(lr/2.) -2.*lr -4.)/pow(lr,2);
+    dfloat a51 = p1[1] - 3.0*p1[2] + 4.0*p1[3];
+    dfloat a52 = 2.0*p1[2] - 4.0*p1[3];
+    dfloat a53 = 2.0*p1[2] - 4.0*p1[3];
+    dfloat a54 = -p1[2] + 4.0*p1[3];
 
-        ca41 +=  ((exp(lr) + 1.)*lr + 2. - 2.*exp(lr))/pow(lr,2);
-        ca43 +=  (2.*exp(lr) - 2.*lr - 2.)/pow(lr,2);
+    dfloat _rkX[Nrk]  = {1.0, p2[0], p2[0], p1[0], p1[0] };
+    dfloat _rkA[Nrk*Nrk]
+                    ={   0.0,  0.0,  0.0,   0.0,  0.0,
+                         a21,  0.0,  0.0,   0.0,  0.0,
+                         a31,  a32,  0.0,   0.0,  0.0,
+                         a41,  0.0,  a43,   0.0,  0.0,
+                         a51,  a52,  a53,   a54,  0.0};
+    dfloat _rkE[Nrk]= {  0.0,  0.0,  0.0,  -a54,  a54};
 
-        ca51 +=  (exp(lr)*pow(lr,2) + (- 3.*exp(lr) - 1.)*lr + 4.*exp(lr) - 4.)/pow(lr,3);
-        ca52 +=  ((2.*exp(lr) + 2.)*lr + 4. - 4.*exp(lr))/pow(lr,3);
-        ca53 +=  ((2.*exp(lr) + 2.)*lr + 4. - 4.*exp(lr))/pow(lr,3);
-        ca54 +=  ((-exp(lr) - 3.)*lr - pow(lr,2) + 4.*exp(lr) - 4.)/pow(lr,3);
-      }
-
-
-      dfloat a21=real(ca21)/ (double) Nr;
-
-      dfloat a31=real(ca31)/ (double) Nr;
-      dfloat a32=real(ca32)/ (double) Nr;
-
-      dfloat a41=real(ca41)/ (double) Nr;
-      dfloat a43=real(ca43)/ (double) Nr;
-
-      dfloat a51=real(ca51)/ (double) Nr;
-      dfloat a52=real(ca52)/ (double) Nr;
-      dfloat a53=real(ca53)/ (double) Nr;
-      dfloat a54=real(ca54)/ (double) Nr;
-
-      // first set non-semianalytic part of the integrator
-      dfloat _rkX[Nrk]  = {1.0, exp(0.5*alpha), exp(0.5*alpha), exp(alpha), exp(alpha) };
-      dfloat _rkA[Nrk*Nrk]
-                      ={   0.0,  0.0,  0.0,   0.0,  0.0,
-                           a21,  0.0,  0.0,   0.0,  0.0,
-                           a31,  a32,  0.0,   0.0,  0.0,
-                           a41,  0.0,  a43,   0.0,  0.0,
-                           a51,  a52,  a53,   a54,  0.0};
-      dfloat _rkE[Nrk]= {  0.0,  0.0,  0.0,  -a54,  a54};
-
-      memcpy(rkX+n*Nrk    ,_rkX,    Nrk*sizeof(dfloat));
-      memcpy(rkA+n*Nrk*Nrk,_rkA,Nrk*Nrk*sizeof(dfloat));
-      memcpy(rkE+n*Nrk    ,_rkE,    Nrk*sizeof(dfloat));
-    }
-
-    // move data to platform
-    // o_rkX.copyFrom(rkX, "async: true");
-    // o_rkA.copyFrom(rkA, "async: true");
-    // o_rkE.copyFrom(rkE, "async: true");
-    o_rkX.copyFrom(rkX);
-    o_rkA.copyFrom(rkA);
-    o_rkE.copyFrom(rkE);
+    memcpy(rkX+c*Nrk    ,_rkX,    Nrk*sizeof(dfloat));
+    memcpy(rkA+c*Nrk*Nrk,_rkA,Nrk*Nrk*sizeof(dfloat));
+    memcpy(rkE+c*Nrk    ,_rkE,    Nrk*sizeof(dfloat));
   }
+
+  // move data to platform
+  o_rkX.copyFrom(rkX);
+  o_rkA.copyFrom(rkA);
+  o_rkE.copyFrom(rkE);
 }
 
 sark4::~sark4() {
-  if (o_rkq.size()) o_rkq.free();
+  if (o_group.size()) o_group.free();
+  if (o_rhsq.size()) o_rhsq.free();
   if (o_rkrhsq.size()) o_rkrhsq.free();
-  if (o_rkerr.size()) o_rkerr.free();
-  if (o_errtmp.size()) o_errtmp.free();
+  if (o_saveq.size()) o_saveq.free();
   if (o_rkX.size()) o_rkX.free();
   if (o_rkA.size()) o_rkA.free();
   if (o_rkE.size()) o_rkE.free();
 
-  if (errtmp) free(errtmp);
   if (lambda) free(lambda);
   if (rkC) free(rkC);
 
@@ -444,7 +382,6 @@ sark4::~sark4() {
 
   rkUpdateKernel.free();
   rkStageKernel.free();
-  rkErrorEstimateKernel.free();
 }
 
 /**************************************************/
@@ -457,6 +394,9 @@ sark4_pml::sark4_pml(dlong _Nelements, dlong _NpmlElements, dlong _NhaloElements
   sark4(_Nelements, _NhaloElements, _Np, _Nfields, _lambda, _solver, _comm),
   Npml(_Npmlfields*_Np*_NpmlElements) {
 
+  //Backup/Restore act on the PML stage fields, so the step cannot be rolled back
+  speculate = 0;
+
   if (Npml) {
     platform_t &platform = solver.platform;
 
@@ -535,6 +475,7 @@ void sark4_pml::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkStageKernel(Nelements,
                   rk,
                   _dt,
+                  o_group,
                   o_rkX,
                   o_rkA,
                   o_q,
@@ -561,6 +502,7 @@ void sark4_pml::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkUpdateKernel(Nelements,
                    rk,
                    _dt,
+                   o_group,
                    o_rkX,
                    o_rkA,
                    o_rkE,
@@ -27,17 +27,13 @@ SOFTWARE.
 #include <math.h>
 #include "core.hpp"
 #include "timeStepper.hpp"
-#include <complex>
 
 namespace TimeStepper {
 
-using std::complex;
-
 sark5::sark5(dlong _Nelements, dlong _NhaloElements,
              int _Np, int _Nfields,
              dfloat *_lambda, solver_t& _solver, MPI_Comm _comm):
-  timeStepper_t(_Nelements, _NhaloElements, _Np, _Nfields, _solver),
-  comm(_comm),
+  adaptiveRk_t(_Nelements, _NhaloElements, _Np, _Nfields, _solver, _comm),
   Np(_Np),
   Nfields(_Nfields),
   Nelements(_Nelements),
@@ -48,28 +44,23 @@ sark5::sark5(dlong _Nelements, dlong _NhaloElements,
   lambda = (dfloat *) malloc(Nfields*sizeof(dfloat));
   memcpy(lambda, _lambda, Nfields*sizeof(dfloat));
 
+  //all elements share the same stiff terms by default
+  Ngroups = 1;
+  dlong *group = (dlong *) calloc(Nelements, sizeof(dlong));
+  o_group = platform.malloc(Nelements*sizeof(dlong), group);
+  free(group);
+
   Nrk = 7; //number of stages
   order = 5;
   embeddedOrder = 4;
 
   dlong Nlocal = Nelements*Np*Nfields;
-  dlong Ntotal = (Nelements+NhaloElements)*Np*Nfields;
 
-  o_rkq    = platform.malloc(Ntotal*sizeof(dfloat));
   o_rhsq   = platform.malloc(Nlocal*sizeof(dfloat));
   o_rkrhsq = platform.malloc(Nlocal*Nrk*sizeof(dfloat));
-  o_rkerr  = platform.malloc(Nlocal*sizeof(dfloat));
 
   o_saveq  = platform.malloc(Nlocal*sizeof(dfloat));
 
-  Nblock = (N+BLOCKSIZE-1)/BLOCKSIZE;
-  errtmp = (dfloat*) calloc(Nblock, sizeof(dfloat));
-  o_errtmp = platform.malloc(Nblock*sizeof(dfloat));
-
-  hlong gNlocal = Nlocal;
-  hlong gNtotal;
-  MPI_Allreduce(&gNlocal, &gNtotal, 1, MPI_HLONG, MPI_SUM, comm);
-
   occa::properties kernelInfo = platform.props; //copy base occa properties from solver
 
   //add defines
@@ -120,17 +111,46 @@ sark5::sark5(dlong _Nelements, dlong _NhaloElements,
   invfactor1 = 1.0/factor1;
   invfactor2 = 1.0/factor2;
   facold = 1E-4;
-  sqrtinvNtotal = 1.0/sqrt(gNtotal);
+}
+
+//set per-element stiff terms. Element e uses lambda[elementGroup[e]*Nfields+f]
+void sark5::SetLambdaGroups(int _Ngroups, dfloat *_lambda, dlong *elementGroup) {
+
+  platform_t &platform = solver.platform;
+
+  Ngroups = _Ngroups;
+
+  free(lambda);
+  lambda = (dfloat *) malloc(Ngroups*Nfields*sizeof(dfloat));
+  memcpy(lambda, _lambda, Ngroups*Nfields*sizeof(dfloat));
+
+  o_group.copyFrom(elementGroup, Nelements*sizeof(dlong));
+
+  h_rkX.free(); h_rkA.free(); h_rkE.free();
+  o_rkX.free(); o_rkA.free(); o_rkE.free();
+
+  rkX = (dfloat*) platform.hostMalloc(Ngroups*Nfields*Nrk*    sizeof(dfloat), NULL, h_rkX);
+  rkA = (dfloat*) platform.hostMalloc(Ngroups*Nfields*Nrk*Nrk*sizeof(dfloat), NULL, h_rkA);
+  rkE = (dfloat*) platform.hostMalloc(Ngroups*Nfields*Nrk*    sizeof(dfloat), NULL, h_rkE);
+
+  o_rkX = platform.malloc(Ngroups*Nfields*Nrk*    sizeof(dfloat));
+  o_rkA = platform.malloc(Ngroups*Nfields*Nrk*Nrk*sizeof(dfloat));
+  o_rkE = platform.malloc(Ngroups*Nfields*Nrk*    sizeof(dfloat));
 }
 
 void sark5::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
+  if (speculate) {
+    RunSpeculative(o_q, start, end);
+    return;
+  }
+
   dfloat time = start;
 
   int rank;
   MPI_Comm_rank(comm, &rank);
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -175,7 +195,7 @@ void sark5::Run(occa::memory &o_q, dfloat start, dfloat end) {
     if (err<1.0) { //dt is accepted
 
       // check for output during this step and do a mini-step
-      if (time<outputTime && time+dt>=outputTime) {
+      if (output && time<outputTime && time+dt>=outputTime) {
         dfloat savedt = dt;
 
         // save rkq
@@ -198,7 +218,7 @@ void sark5::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
         // output  (print from rkq)
         // if (!rank) printf("\n");
-        solver.Report(outputTime,tstep);
+        Report(outputTime,tstep);
 
         // restore time step
         dt = savedt;
@@ -269,6 +289,7 @@ void sark5::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkStageKernel(Nelements,
                   rk,
                   _dt,
+                  o_group,
                   o_rkX,
                   o_rkA,
                   o_q,
@@ -286,6 +307,7 @@ void sark5::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkUpdateKernel(Nelements,
                    rk,
                    _dt,
+                   o_group,
                    o_rkX,
                    o_rkA,
                    o_rkE,
@@ -297,200 +319,80 @@ void sark5::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
   }
 }
 
-dfloat sark5::Estimater(occa::memory& o_q){
-
-  //Error estimation
-  //E. HAIRER, S.P. NORSETT AND G. WANNER, SOLVING ORDINARY
-  //      DIFFERENTIAL EQUATIONS I. NONSTIFF PROBLEMS. 2ND EDITION.
-  rkErrorEstimateKernel(Nelements*Np*Nfields,
-                        ATOL,
-                        RTOL,
-                        o_q,
-                        o_rkq,
-                        o_rkerr,
-                        o_errtmp);
-
-  o_errtmp.copyTo(errtmp);
-  dfloat localerr = 0;
-  dfloat err = 0;
-  for(dlong n=0;n<Nblock;++n){
-    localerr += errtmp[n];
-  }
-  MPI_Allreduce(&localerr, &err, 1, MPI_DFLOAT, MPI_SUM, comm);
-
-  err = sqrt(err)*sqrtinvNtotal;
-
-  return err;
-}
-
 void sark5::UpdateCoefficients() {
 
-  const int Nr = 32;
-  complex<dfloat> R[Nr];
-
-  //contour integral integration points
-  for(int ind=1; ind <= Nr; ++ind){
-    const dfloat theta = (dfloat) (ind - 0.5) / (dfloat) Nr;
-    complex<dfloat> z(0., M_PI* theta);
-    R[ind-1] = exp(z);
+  //RK coefficients as phi-function combinations of z = lambda*dt.
+  // phi_k(0) = 1/k! recovers the usual RK coefficients
+  for (int c=0;c<Ngroups*Nfields;c++) {
+    const dfloat z = lambda[c]*dt;
+
+    dfloat p4[4], p2[4], p34[4], p1[4]; //phi_k(z/4), phi_k(z/2), phi_k(3z/4), phi_k(z)
+    phiFunctions(0.25*z, 3, p4);
+    phiFunctions( 0.5*z, 3, p2);
+    phiFunctions(0.75*z, 3, p34);
+    phiFunctions(     z, 3, p1);
+
+    dfloat a21 = 0.25*p4[1];
+
+    dfloat a31 = 0.25*p4[1] - 0.25*p4[2];
+    dfloat a32 = 0.25*p4[2];
+
+    dfloat a41 = 0.5*p2[1] - p2[2];
+    dfloat a43 = p2[2];
+
+    dfloat a51 =  (3./4.)*p34[1] - (9./8.)*p34[2];
+    dfloat a52 = -(3./8.)*p34[1];
+    dfloat a53 =  (3./8.)*p34[1];
+    dfloat a54 =  (9./8.)*p34[2];
+
+    dfloat a61 = -(11./6.)*p1[1] + (59./21.)*p1[2];
+    dfloat a62 =   (8./7.)*p1[1];
+    dfloat a63 = (111./28.)*p1[1] - (87./14.)*p1[2];
+    dfloat a64 = -(12./7.)*p1[1];
+    dfloat a65 = -(47./84.)*p1[1] + (143./42.)*p1[2];
+
+    dfloat a71 = (1799./2700.)*p1[1] - (3479./1350.)*p1[2] + (21./5.)*p1[3];
+    dfloat a73 = (1097./1350.)*p1[1] -   (467./675.)*p1[2] -  (2./3.)*p1[3];
+    dfloat a74 =   -(98./225.)*p1[1] +   (796./225.)*p1[2] - (36./5.)*p1[3];
+    dfloat a75 = -(313./1350.)*p1[1] +   (883./675.)*p1[2] -  (2./5.)*p1[3];
+    dfloat a76 =  (509./2700.)*p1[1] - (2129./1350.)*p1[2] + (61./15.)*p1[3];
+
+    dfloat b1 =  (313./5400.)*p1[1] - (883./2700.)*p1[2] + (1./10.)*p1[3];
+    dfloat b3 = -(313./1350.)*p1[1] +  (883./675.)*p1[2] -  (2./5.)*p1[3];
+    dfloat b4 =   (313./900.)*p1[1] -  (883./450.)*p1[2] +  (3./5.)*p1[3];
+    dfloat b6 =  (313./5400.)*p1[1] - (883./2700.)*p1[2] + (1./10.)*p1[3];
+
+    dfloat _rkX[Nrk]  = {1.0, p4[0], p4[0], p2[0], p34[0], p1[0], p1[0]};
+    dfloat _rkA[Nrk*Nrk]
+                    ={   0,    0,    0,    0,    0,    0,  0,
+                       a21,    0,    0,    0,    0,    0,  0,
+                       a31,  a32,    0,    0,    0,    0,  0,
+                       a41,    0,  a43,    0,    0,    0,  0,
+                       a51,  a52,  a53,  a54,    0,    0,  0,
+                       a61,  a62,  a63,  a64,  a65,    0,  0,
+                       a71,    0,  a73,  a74,  a75,  a76,  0 };
+    dfloat _rkE[Nrk]= { b1, 0, b3, b4, a75, b6, 0};
+
+    memcpy(rkX+c*Nrk    ,_rkX,    Nrk*sizeof(dfloat));
+    memcpy(rkA+c*Nrk*Nrk,_rkA,Nrk*Nrk*sizeof(dfloat));
+    memcpy(rkE+c*Nrk    ,_rkE,    Nrk*sizeof(dfloat));
   }
 
-  for (int n=0;n<Nfields;n++) {
-
-    if (lambda[n]==0) { //Zero exponential term, usual RK coefficients
-
-      dfloat _rkX[Nrk]   = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
-      dfloat _rkA[Nrk*Nrk]  =  {     0,      0,       0,       0,       0,      0,   0,
-                                   1/4,      0,       0,       0,       0,      0,   0,
-                                   1/8,    1/8,       0,       0,       0,      0,   0,
-                                     0,      0,     1/2,       0,       0,      0,   0,
-                                3./16., -3./8.,   3./8.,  9./16.,       0,      0,   0,
-                                -3./7.,  8./7.,   6./7., -12./7.,   8./7.,      0,   0,
-                                7./90.,     0., 16./45.,  2./15., 16./45., 7./90.,   0};
-
-      dfloat _rkE[Nrk]=  {-4./45., 0, 16./45., -8./15., 16./45., -4./45., 0.};
-
-      memcpy(rkX+n*Nrk    ,_rkX,    Nrk*sizeof(dfloat));
-      memcpy(rkA+n*Nrk*Nrk,_rkA,Nrk*Nrk*sizeof(dfloat));
-      memcpy(rkE+n*Nrk    ,_rkE,    Nrk*sizeof(dfloat));
-
-    } else {
-
-      //Compute RK coefficients via contour integral
-      dfloat alpha = lambda[n]*dt;
-
-      // Initialize complex variables for contour integral
-      complex<double> ca21(0., 0.);
-      complex<double> ca31(0., 0.);
-      complex<double> ca32(0., 0.);
-      complex<double> ca41(0., 0.);
-      complex<double> ca43(0., 0.);
-      complex<double> ca51(0., 0.);
-      complex<double> ca52(0., 0.);
-      complex<double> ca53(0., 0.);
-      complex<double> ca54(0., 0.);
-      complex<double> ca61(0., 0.);
-      complex<double> ca62(0., 0.);
-      complex<double> ca63(0., 0.);
-      complex<double> ca64(0., 0.);
-      complex<double> ca65(0., 0.);
-      complex<double> ca71(0., 0.);
-      complex<double> ca73(0., 0.);
-      complex<double> ca74(0., 0.);
-      complex<double> ca75(0., 0.);
-      complex<double> ca76(0., 0.);
-      complex<double> cb1 (0., 0.);
-      complex<double> cb3 (0., 0.);
-      complex<double> cb4 (0., 0.);
-      complex<double> cb6 (0., 0.);
-
-      for(int i = 0; i<Nr; ++i ){
-        complex<double> lr = alpha  + R[i];
-
-        ca21 +=  (exp(lr/4.) - 1.)/lr;
-
-        ca31 +=  (exp(lr/4.)*lr + 4. - 4.*exp(lr/4.))/pow(lr,2);
-        ca32 +=  (4.*exp(lr/4.) - lr - 4.)/pow(lr,2);
-
-        ca41 +=  ((exp(lr/2.) + 1.)*lr + 4. - 4.*exp(lr/2.))/pow(lr,2);
-        ca43 +=  (4.*exp(lr/2.) - 2.*lr - 4.)/pow(lr,2);
-
-        ca51 +=  ((2.*exp((3.*lr)/4.) + 1.)*lr + 4. - 4.*exp((3.*lr)/4.))/(2.*pow(lr,2));
-        ca52 +=   -(exp((3.*lr)/4.) - 1.)/(2.*lr);
-        ca53 +=  (exp((3.*lr)/4.) - 1.)/(2.*lr);
-        ca54 +=  (4.*exp((3.*lr)/4.) - 3.*lr - 4.)/(2.*pow(lr,2));
-
-
-        ca61 +=  ((- 77.*exp(lr) - 41.)*lr + 118.*exp(lr) - 118.)/(42.*pow(lr,2));
-        ca62 +=  (8.*exp(lr) - 8.)/(7.*lr);
-        ca63 +=  ((111.*exp(lr) + 63.)*lr + 174. - 174.*exp(lr))/(28.*pow(lr,2));
-        ca64 += -(12.*exp(lr) - 12.)/(7.*lr);
-        ca65 +=  ((- 47.*exp(lr) - 239.)*lr + 286.*exp(lr) - 286.)/(84.*pow(lr,2));
-
-
-        ca71 +=  ((1799.*exp(lr) - 511.)*pow(lr,2) + (- 6958.*exp(lr) - 4382.)*lr + 11340.*exp(lr) - 11340.)/(2700.*pow(lr,3));
-        // ca72 +=  (8.*exp(lr) - 8.)/(7.*lr);
-        ca73 +=  ((1097.*exp(lr) + 287.)*pow(lr,2) + (1834. - 934.*exp(lr))*lr + 900. - 900.*exp(lr))/(1350.*pow(lr,3));
-        ca74 +=  ((112. - 98.*exp(lr))*pow(lr,2) + (796.*exp(lr) + 824.)*lr + 1620. - 1620.*exp(lr))/(225.*pow(lr,3));
-        ca75 +=  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
-        ca76 +=  ((509.*exp(lr) - 1741.)*pow(lr,2) + (- 4258.*exp(lr) - 6722.)*lr + 10980.*exp(lr) - 10980.)/(2700.*pow(lr,3));
-
-
-        cb1 +=  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(5400.*pow(lr,3));
-        // cb2 +=  (8.*exp(lr) - 8.)/(7.*lr);
-        cb3 +=  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
-
-        cb4 +=  ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(900.*pow(lr,3));
-        // cb5 +=  ((- 313.*exp(lr) - 1183.)*pow(lr,2) + (1766.*exp(lr) - 1226.)*lr + 540. - 540.*exp(lr))/(1350.*pow(lr,3));
-        cb6 += ((313.*exp(lr) + 1183.)*pow(lr,2) + (1226. - 1766.*exp(lr))*lr + 540.*exp(lr) - 540.)/(5400.*pow(lr,3));
-      }
-
-      dfloat a21=real(ca21)/ (double) Nr;
-
-      dfloat a31=real(ca31)/ (double) Nr;
-      dfloat a32=real(ca32)/ (double) Nr;
-
-      dfloat a41=real(ca41)/ (double) Nr;
-      dfloat a43=real(ca43)/ (double) Nr;
-
-      dfloat a51=real(ca51)/ (double) Nr;
-      dfloat a52=real(ca52)/ (double) Nr;
-      dfloat a53=real(ca53)/ (double) Nr;
-      dfloat a54=real(ca54)/ (double) Nr;
-
-      dfloat a61=real(ca61)/ (double) Nr;
-      dfloat a62=real(ca62)/ (double) Nr;
-      dfloat a63=real(ca63)/ (double) Nr;
-      dfloat a64=real(ca64)/ (double) Nr;
-      dfloat a65=real(ca65)/ (double) Nr;
-
-      dfloat a71=real(ca71)/ (double) Nr;
-      dfloat a73=real(ca73)/ (double) Nr;
-      dfloat a74=real(ca74)/ (double) Nr;
-      dfloat a75=real(ca75)/ (double) Nr;
-      dfloat a76=real(ca76)/ (double) Nr;
-
-      dfloat b1=real(cb1)/ (double) Nr;
-      dfloat b3=real(cb3)/ (double) Nr;
-      dfloat b4=real(cb4)/ (double) Nr;
-      dfloat b6=real(cb6)/ (double) Nr;
-
-      dfloat _rkX[Nrk]  = {1.0, exp(0.25*alpha), exp(0.25*alpha),exp(0.5*alpha), exp(0.75*alpha), exp(alpha), exp(alpha)};
-      dfloat _rkA[Nrk*Nrk]={   0,   0,     0,     0,     0,    0,   0,
-                             a21,   0,     0,     0,     0,    0,   0,
-                             a31, a32,     0,     0,     0,    0,   0,
-                             a41,   0,   a43,     0,     0,    0,   0,
-                             a51, a52,   a53,   a54,     0,    0,   0,
-                             a61, a62,   a63,   a64,   a65,    0,   0,
-                             a71,   0,   a73,   a74,   a75,  a76,   0};
-
-      dfloat _rkE[Nrk]= {b1, 0, b3, b4, a75, b6, 0};
-
-      memcpy(rkX+n*Nrk    ,_rkX,    Nrk*sizeof(dfloat));
-      memcpy(rkA+n*Nrk*Nrk,_rkA,Nrk*Nrk*sizeof(dfloat));
-      memcpy(rkE+n*Nrk    ,_rkE,    Nrk*sizeof(dfloat));
-    }
-
-    // move data to platform
-    // o_rkX.copyFrom(rkX, "async: true");
-    // o_rkA.copyFrom(rkA, "async: true");
-    // o_rkE.copyFrom(rkE, "async: true");
-    o_rkX.copyFrom(rkX);
-    o_rkA.copyFrom(rkA);
-    o_rkE.copyFrom(rkE);
-  }
+  // move data to platform
+  o_rkX.copyFrom(rkX);
+  o_rkA.copyFrom(rkA);
+  o_rkE.copyFrom(rkE);
 }
 
 sark5::~sark5() {
-  if (o_rkq.size()) o_rkq.free();
+  if (o_group.size()) o_group.free();
+  if (o_rhsq.size()) o_rhsq.free();
   if (o_rkrhsq.size()) o_rkrhsq.free();
-  if (o_rkerr.size()) o_rkerr.free();
-  if (o_errtmp.size()) o_errtmp.free();
+  if (o_saveq.size()) o_saveq.free();
   if (o_rkX.size()) o_rkX.free();
   if (o_rkA.size()) o_rkA.free();
   if (o_rkE.size()) o_rkE.free();
 
-  if (errtmp) free(errtmp);
   if (lambda) free(lambda);
   if (rkC) free(rkC);
 
@@ -500,7 +402,6 @@ sark5::~sark5() {
 
   rkUpdateKernel.free();
   rkStageKernel.free();
-  rkErrorEstimateKernel.free();
 }
 
 /**************************************************/
@@ -513,6 +414,9 @@ sark5_pml::sark5_pml(dlong _Nelements, dlong _NpmlElements, dlong _NhaloElements
   sark5(_Nelements, _NhaloElements, _Np, _Nfields, _lambda, _solver, _comm),
   Npml(_Npmlfields*_Np*_NpmlElements) {
 
+  //Backup/Restore act on the PML stage fields, so the step cannot be rolled back
+  speculate = 0;
+
   if (Npml) {
     platform_t &platform = solver.platform;
 
@@ -592,6 +496,7 @@ void sark5_pml::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkStageKernel(Nelements,
                   rk,
                   _dt,
+                  o_group,
                   o_rkX,
                   o_rkA,
                   o_q,
@@ -618,6 +523,7 @@ void sark5_pml::Step(occa::memory &o_q, dfloat time, dfloat _dt) {
     rkUpdateKernel(Nelements,
                    rk,
                    _dt,
+                   o_group,
                    o_rkX,
                    o_rkA,
                    o_rkE,
@@ -73,7 +73,7 @@ void ssbdf3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
   dfloat time = start;
 
-  solver.Report(time,0);
+  Report(time,0);
 
   dfloat outputInterval;
   solver.settings.getSetting("OUTPUT INTERVAL", outputInterval);
@@ -90,7 +90,7 @@ void ssbdf3::Run(occa::memory &o_q, dfloat start, dfloat end) {
 
     if (time>outputTime) {
       //report state
-      solver.Report(time,tstep);
+      Report(time,tstep);
       outputTime += outputInterval;
     }
   }
@@ -51,9 +51,14 @@ public:
 
   int Nfields;
 
+  int Nensemble;
+
+  int fusedKernels;
+
   TimeStepper::timeStepper_t* timeStepper;
 
   halo_t* traceHalo;
+  halo_t** multirateTraceHalo;
 
   dfloat *q;
   occa::memory o_q;
@@ -63,6 +68,10 @@ public:
   occa::kernel volumeKernel;
   occa::kernel surfaceKernel;
 
+  occa::kernel volumeSurfaceKernel;
+
+  occa::kernel surfaceKernelMR;
+
   occa::kernel initialConditionKernel;
 
   acoustics_t() = delete;
@@ -84,7 +93,21 @@ public:
 
   void rhsf(occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
 
+  void rhsVolume(dlong N, occa::memory& o_ids,
+                 occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
+  void rhsSurface(dlong N, occa::memory& o_ids,
+                  occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
+  void rhsVolumeSurface(dlong N, occa::memory& o_ids,
+                        occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
+  void rhsf_MR(occa::memory& o_q, occa::memory& o_rhs, occa::memory& o_fQM,
+               const dfloat time, const int level);
+
   dfloat MaxWaveSpeed();
+
+  void SpongeSetup(dfloat width, dlong *elementGroup);
 };
 
 #endif
\ No newline at end of file
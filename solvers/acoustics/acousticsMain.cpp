@@ -52,15 +52,29 @@ int main(int argc, char **argv){
   meshSettings.report();
   acousticsSettings.report();
 
+  // ranks are split into space communicators, one per time slice
+  MPI_Comm spaceComm = comm;
+  if (!acousticsSettings.compareSetting("PARALLEL IN TIME","NONE")) {
+    int Nslices;
+    acousticsSettings.getSetting("TIME SLICES", Nslices);
+    spaceComm = TimeStepper::parareal::SplitComm(comm, Nslices);
+  }
+
   // set up mesh
-  mesh_t& mesh = mesh_t::Setup(platform, meshSettings, comm);
+  mesh_t& mesh = mesh_t::Setup(platform, meshSettings, spaceComm);
 
   // set up acoustics solver
   acoustics_t& acoustics = acoustics_t::Setup(platform, mesh, acousticsSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   acoustics.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
@@ -51,6 +51,9 @@ void acoustics_t::PlotFields(dfloat* Q, char *fileName){
   dfloat* Iy = (dfloat *) malloc(mesh.plotNp*sizeof(dfloat));
   dfloat* Iz = (dfloat *) malloc(mesh.plotNp*sizeof(dfloat));
 
+  // download coordinates if they were released after setup
+  mesh.RestoreHostMirrors();
+
   // compute plot node coordinates on the fly
   for(dlong e=0;e<mesh.Nelements;++e){
     mesh.PlotInterp(mesh.x + e*mesh.Np, Ix, scratch);
@@ -62,6 +65,9 @@ void acoustics_t::PlotFields(dfloat* Q, char *fileName){
       fprintf(fp, "%g %g %g\n", Ix[n],Iy[n],Iz[n]);
     }
   }
+
+  mesh.ReleaseHostMirrors();
+
   fprintf(fp, "        </DataArray>\n");
   fprintf(fp, "      </Points>\n");
 
@@ -76,7 +82,7 @@ void acoustics_t::PlotFields(dfloat* Q, char *fileName){
   fprintf(fp, "      <PointData Scalars=\"scalars\">\n");
   fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Density\" Format=\"ascii\">\n");
   for(dlong e=0;e<mesh.Nelements;++e){
-    mesh.PlotInterp(Q + e*mesh.Np*Nfields, Ip, scratch);
+    mesh.PlotInterp(Q + e*mesh.Np*Nfields*Nensemble, Ip, scratch);
 
     for(int n=0;n<mesh.plotNp;++n){
       fprintf(fp, "       ");
@@ -88,10 +94,10 @@ void acoustics_t::PlotFields(dfloat* Q, char *fileName){
   // write out velocity
   fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Velocity\" NumberOfComponents=\"%d\" Format=\"ascii\">\n", mesh.dim);
   for(dlong e=0;e<mesh.Nelements;++e){
-    mesh.PlotInterp(Q + 1*mesh.Np + e*mesh.Np*Nfields, Iu, scratch);
-    mesh.PlotInterp(Q + 2*mesh.Np + e*mesh.Np*Nfields, Iv, scratch);
+    mesh.PlotInterp(Q + 1*mesh.Np + e*mesh.Np*Nfields*Nensemble, Iu, scratch);
+    mesh.PlotInterp(Q + 2*mesh.Np + e*mesh.Np*Nfields*Nensemble, Iv, scratch);
     if(mesh.dim==3)
-      mesh.PlotInterp(Q + 3*mesh.Np + e*mesh.Np*Nfields, Iw, scratch);
+      mesh.PlotInterp(Q + 3*mesh.Np + e*mesh.Np*Nfields*Nensemble, Iw, scratch);
 
     for(int n=0;n<mesh.plotNp;++n){
       fprintf(fp, "       ");
@@ -56,7 +56,21 @@ void acoustics_t::Run(){
     //compute q.M*q
     mesh.MassMatrixApply(o_q, o_Mq);
 
-    dlong Nentries = mesh.Nelements*mesh.Np*Nfields;
+    dlong Nentries = mesh.Nelements*mesh.Np*Nfields*Nensemble;
+
+    //per-member norms, reduced on the device
+    if (Nensemble>1) {
+      dfloat *norms = (dfloat*) calloc(Nensemble, sizeof(dfloat));
+      platform.linAlg.innerProdMulti(Nentries, Nensemble, mesh.Np*Nfields,
+                                     o_q, o_Mq, mesh.comm, norms);
+
+      if(mesh.rank==0)
+        for(int m=0;m<Nensemble;++m)
+          printf("Member %d solution norm = %17.15lg\n", m, sqrt(norms[m]));
+
+      free(norms);
+    }
+
     dfloat norm2 = sqrt(platform.linAlg.innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
     if(mesh.rank==0)
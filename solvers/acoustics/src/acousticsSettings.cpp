@@ -37,7 +37,26 @@ acousticsSettings_t::acousticsSettings_t(MPI_Comm& _comm):
   newSetting("TIME INTEGRATOR",
              "DOPRI5",
              "Time integration method",
-             {"AB3", "DOPRI5", "LSERK4"});
+             {"AB3", "DOPRI5", "LSERK4", "MRAB3", "SAAB3", "SARK4", "SARK5"});
+
+  newSetting("SPONGE DAMPING",
+             "0.0",
+             "Damping rate of the absorbing layer at the mesh boundary. Requires SAAB3, SARK4 or SARK5");
+
+  newSetting("SPONGE WIDTH",
+             "0.0",
+             "Width of the absorbing layer at the mesh boundary");
+
+  newSetting("FUSED KERNELS",
+             "FALSE",
+             "Evaluate the volume and surface terms in a single kernel",
+             {"TRUE", "FALSE"});
+
+  newSetting("ENSEMBLE MEMBERS",
+             "1",
+             "Number of independent solution instances advanced together. Not supported with MRAB3 or FUSED KERNELS");
+
+  TimeStepper::parareal::AddSettings(*this);
 
   newSetting("CFL NUMBER",
              "1.0",
@@ -73,6 +92,15 @@ void acousticsSettings_t::report() {
     std::cout << "Acoustics Settings:\n\n";
     reportSetting("DATA FILE");
     reportSetting("TIME INTEGRATOR");
+    if (compareSetting("TIME INTEGRATOR","SAAB3") ||
+        compareSetting("TIME INTEGRATOR","SARK4") ||
+        compareSetting("TIME INTEGRATOR","SARK5")) {
+      reportSetting("SPONGE DAMPING");
+      reportSetting("SPONGE WIDTH");
+    }
+    TimeStepper::parareal::ReportSettings(*this);
+    reportSetting("FUSED KERNELS");
+    reportSetting("ENSEMBLE MEMBERS");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
@@ -104,4 +132,9 @@ void acousticsSettings_t::parseFromFile(platformSettings_t& platformSettings,
       LIBP_ABORT(ss.str());
     }
   }
+
+  //the graph partitioner balances the multirate element costs
+  if (!s.hasSetting("PARTITION WEIGHTS") &&
+      compareSetting("TIME INTEGRATOR","MRAB3"))
+    meshSettings.changeSetting("PARTITION WEIGHTS", "MULTIRATE");
 }
\ No newline at end of file
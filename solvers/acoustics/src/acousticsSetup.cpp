@@ -33,29 +33,142 @@ acoustics_t& acoustics_t::Setup(platform_t& platform, mesh_t& mesh,
 
   acoustics->Nfields = (mesh.dim==3) ? 4:3;
 
-  dlong Nlocal = mesh.Nelements*mesh.Np*acoustics->Nfields;
-  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*acoustics->Nfields;
+  //independent solution instances advanced together
+  settings.getSetting("ENSEMBLE MEMBERS", acoustics->Nensemble);
+  if (acoustics->Nensemble<1)
+    LIBP_ABORT(string("ENSEMBLE MEMBERS must be at least 1"))
+  if (acoustics->Nensemble>1
+      && (settings.compareSetting("TIME INTEGRATOR","MRAB3")
+          || settings.compareSetting("FUSED KERNELS","TRUE")))
+    LIBP_ABORT(string("ENSEMBLE MEMBERS > 1 is not supported with MRAB3 or FUSED KERNELS"))
+
+  mesh.mrNlevels=0;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    //make array of time step estimates for each element
+    dfloat *EtoDT = (dfloat *) calloc(mesh.Nelements,sizeof(dfloat));
+    dfloat vmax = acoustics->MaxWaveSpeed();
+    for(dlong e=0;e<mesh.Nelements;++e){
+      dfloat h = mesh.ElementCharacteristicLength(e);
+      EtoDT[e] = h/(vmax*(mesh.N+1.)*(mesh.N+1.));
+    }
+
+    //rebalance the partition so each rank owns an equal share of every level
+    mesh.MultiRatePartition(EtoDT);
+
+    mesh.MultiRateSetup(EtoDT);
+    acoustics->multirateTraceHalo = mesh.MultiRateHaloTraceSetup(acoustics->Nfields);
+    free(EtoDT);
+  }
+
+  //ensemble members are interleaved per element, so they behave as extra fields
+  const int NfieldsTotal = acoustics->Nfields*acoustics->Nensemble;
+
+  dlong Nlocal = mesh.Nelements*mesh.Np*NfieldsTotal;
+  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*NfieldsTotal;
+
+  //the absorbing layer is a linear damping term -sigma*q, which the
+  // semi-analytic steppers integrate exactly, so it does not limit dt
+  const int semiAnalytic = settings.compareSetting("TIME INTEGRATOR","SAAB3")
+                         ||settings.compareSetting("TIME INTEGRATOR","SARK4")
+                         ||settings.compareSetting("TIME INTEGRATOR","SARK5");
+
+  dfloat spongeDamping=0.0, spongeWidth=0.0;
+  settings.getSetting("SPONGE DAMPING", spongeDamping);
+  settings.getSetting("SPONGE WIDTH", spongeWidth);
+  if (spongeDamping!=0.0 && !semiAnalytic)
+    LIBP_ABORT(string("SPONGE DAMPING requires TIME INTEGRATOR SAAB3, SARK4 or SARK5"))
+
+  //stiff terms of the undamped (0) and absorbing (1) element groups
+  dfloat *lambda = (dfloat*) calloc(2*NfieldsTotal, sizeof(dfloat));
+  for (int f=0;f<NfieldsTotal;f++) lambda[NfieldsTotal+f] = -spongeDamping;
+
+  dlong *elementGroup = (dlong*) calloc(mesh.Nelements, sizeof(dlong));
+  if (semiAnalytic) acoustics->SpongeSetup(spongeWidth, elementGroup);
 
   //setup timeStepper
-  if (settings.compareSetting("TIME INTEGRATOR","AB3")){
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")){
+    acoustics->timeStepper = new TimeStepper::mrab3(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, acoustics->Nfields, *acoustics, mesh);
+  } else if (settings.compareSetting("TIME INTEGRATOR","AB3")){
     acoustics->timeStepper = new TimeStepper::ab3(mesh.Nelements, mesh.totalHaloPairs,
-                                              mesh.Np, acoustics->Nfields, *acoustics);
+                                              mesh.Np, NfieldsTotal, *acoustics);
   } else if (settings.compareSetting("TIME INTEGRATOR","LSERK4")){
     acoustics->timeStepper = new TimeStepper::lserk4(mesh.Nelements, mesh.totalHaloPairs,
-                                              mesh.Np, acoustics->Nfields, *acoustics);
+                                              mesh.Np, NfieldsTotal, *acoustics);
   } else if (settings.compareSetting("TIME INTEGRATOR","DOPRI5")){
     acoustics->timeStepper = new TimeStepper::dopri5(mesh.Nelements, mesh.totalHaloPairs,
-                                              mesh.Np, acoustics->Nfields, *acoustics, mesh.comm);
+                                              mesh.Np, NfieldsTotal, *acoustics, mesh.comm);
+  } else if (settings.compareSetting("TIME INTEGRATOR","SAAB3")){
+    TimeStepper::saab3* saab = new TimeStepper::saab3(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, NfieldsTotal, lambda, *acoustics);
+    saab->SetLambdaGroups(2, lambda, elementGroup);
+    acoustics->timeStepper = saab;
+  } else if (settings.compareSetting("TIME INTEGRATOR","SARK4")){
+    TimeStepper::sark4* sark = new TimeStepper::sark4(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, NfieldsTotal, lambda, *acoustics, mesh.comm);
+    sark->SetLambdaGroups(2, lambda, elementGroup);
+    acoustics->timeStepper = sark;
+  } else if (settings.compareSetting("TIME INTEGRATOR","SARK5")){
+    TimeStepper::sark5* sark = new TimeStepper::sark5(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, NfieldsTotal, lambda, *acoustics, mesh.comm);
+    sark->SetLambdaGroups(2, lambda, elementGroup);
+    acoustics->timeStepper = sark;
+  }
+  free(lambda);
+  free(elementGroup);
+
+  //parallel-in-time driver, with the time integrator as fine propagator
+  if (!settings.compareSetting("PARALLEL IN TIME","NONE")) {
+    if (settings.compareSetting("TIME INTEGRATOR","MRAB3"))
+      LIBP_ABORT(string("PARALLEL IN TIME is not supported with MRAB3"))
+
+    int coarseN=0;
+    settings.getSetting("COARSE POLYNOMIAL DEGREE", coarseN);
+    if (coarseN<0) LIBP_ABORT(string("COARSE POLYNOMIAL DEGREE must be non-negative"))
+
+    TimeStepper::timeStepper_t* coarse;
+    acoustics_t* coarseSolver = nullptr;
+    acousticsSettings_t* coarseSettings = nullptr;
+
+    if (coarseN>0 && coarseN<mesh.N) {
+      //coarse propagator is a separate solver on a lower degree copy of the mesh
+      mesh_t &meshC = mesh.SetupNewDegree(coarseN);
+
+      coarseSettings = new acousticsSettings_t(settings);
+      coarseSettings->changeSetting("PARALLEL IN TIME", "NONE");
+      //the absorbing layer needs a semi-analytic stepper
+      if (spongeDamping==0.0)
+        coarseSettings->changeSetting("TIME INTEGRATOR",
+                                      settings.getSetting("COARSE TIME INTEGRATOR"));
+
+      coarseSolver = &(acoustics_t::Setup(platform, meshC, *coarseSettings));
+      coarse = coarseSolver->timeStepper;
+      coarseSolver->timeStepper = nullptr;
+    } else if (settings.compareSetting("COARSE TIME INTEGRATOR","LSERK4")) {
+      coarse = new TimeStepper::lserk4(mesh.Nelements, mesh.totalHaloPairs,
+                                       mesh.Np, NfieldsTotal, *acoustics);
+    } else {
+      coarse = new TimeStepper::ab3(mesh.Nelements, mesh.totalHaloPairs,
+                                    mesh.Np, NfieldsTotal, *acoustics);
+    }
+
+    TimeStepper::parareal* pit = new TimeStepper::parareal(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, NfieldsTotal, *acoustics,
+                                              mesh.comm, settings.comm,
+                                              coarse, acoustics->timeStepper);
+    if (coarseSolver)
+      pit->SetCoarseSpace(mesh, coarseSolver->mesh, coarseSolver, coarseSettings);
+    acoustics->timeStepper = pit;
   }
 
   //setup linear algebra module
-  platform.linAlg.InitKernels({"innerProd"});
+  platform.linAlg.InitKernels({"innerProd", "innerProdMulti"});
 
   // set penalty parameter
   dfloat Lambda2 = 0.5;
 
   /*setup trace halo exchange */
-  acoustics->traceHalo = mesh.HaloTraceSetup(acoustics->Nfields);
+  acoustics->traceHalo = mesh.HaloTraceSetup(NfieldsTotal);
 
   // compute samples of q at interpolation nodes
   acoustics->q = (dfloat*) calloc(Nlocal+Nhalo, sizeof(dfloat));
@@ -63,7 +176,7 @@ acoustics_t& acoustics_t::Setup(platform_t& platform, mesh_t& mesh,
 
   //storage for M*q during reporting
   acoustics->o_Mq = platform.malloc((Nlocal+Nhalo)*sizeof(dfloat), acoustics->q);
-  mesh.MassMatrixKernelSetup(acoustics->Nfields); // mass matrix operator
+  mesh.MassMatrixKernelSetup(NfieldsTotal); // mass matrix operator
 
   // OCCA build stuff
   occa::properties kernelInfo = mesh.props; //copy base occa properties
@@ -75,6 +188,7 @@ acoustics_t& acoustics_t::Setup(platform_t& platform, mesh_t& mesh,
 
 
   kernelInfo["defines/" "p_Nfields"]= acoustics->Nfields;
+  kernelInfo["defines/" "p_Nensemble"]= acoustics->Nensemble;
 
   const dfloat p_half = 1./2.;
   kernelInfo["defines/" "p_half"]= p_half;
@@ -121,6 +235,23 @@ acoustics_t& acoustics_t::Setup(platform_t& platform, mesh_t& mesh,
   acoustics->surfaceKernel = platform.buildKernel(fileName, kernelName,
                                          kernelInfo);
 
+  acoustics->fusedKernels = settings.compareSetting("FUSED KERNELS","TRUE");
+  //fused volume+surface kernel, from the surface file
+  if (acoustics->fusedKernels) {
+    sprintf(kernelName, "acousticsVolumeSurface%s", suffix);
+    acoustics->volumeSurfaceKernel = platform.buildKernel(fileName, kernelName,
+                                                 kernelInfo);
+  }
+
+  //multirate surface kernel reads the traces from the multirate trace buffer
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    sprintf(fileName, DACOUSTICS "/okl/acousticsSurface%s.okl", suffix);
+    sprintf(kernelName, "acousticsMRSurface%s", suffix);
+
+    acoustics->surfaceKernelMR = platform.buildKernel(fileName, kernelName,
+                                             kernelInfo);
+  }
+
   if (mesh.dim==2) {
     sprintf(fileName, DACOUSTICS "/okl/acousticsInitialCondition2D.okl");
     sprintf(kernelName, "acousticsInitialCondition2D");
@@ -138,8 +269,13 @@ acoustics_t& acoustics_t::Setup(platform_t& platform, mesh_t& mesh,
 acoustics_t::~acoustics_t() {
   volumeKernel.free();
   surfaceKernel.free();
+  volumeSurfaceKernel.free();
+  surfaceKernelMR.free();
   initialConditionKernel.free();
 
   if (timeStepper) delete timeStepper;
   if (traceHalo) traceHalo->Free();
+
+  for (int lev=0;lev<mesh.mrNlevels;lev++)
+    if (multirateTraceHalo[lev]) multirateTraceHalo[lev]->Free();
 }
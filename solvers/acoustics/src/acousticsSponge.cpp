@@ -0,0 +1,67 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.hpp"
+
+// Flag the elements whose centroid lies within width of the mesh bounding
+//  box. They form the absorbing layer, damped by the semi-analytic steppers
+void acoustics_t::SpongeSetup(dfloat width, dlong *elementGroup){
+
+  dfloat minX[3] = {0.0, 0.0, 0.0}, maxX[3] = {0.0, 0.0, 0.0};
+  dfloat localMin[3], localMax[3];
+  for (int d=0;d<mesh.dim;d++) {
+    localMin[d] =  std::numeric_limits<dfloat>::max();
+    localMax[d] = -std::numeric_limits<dfloat>::max();
+  }
+
+  dfloat *EXYZ[3] = {mesh.EX, mesh.EY, mesh.EZ};
+
+  for(dlong e=0;e<mesh.Nelements;++e){
+    for (int v=0;v<mesh.Nverts;v++) {
+      for (int d=0;d<mesh.dim;d++) {
+        const dfloat xv = EXYZ[d][e*mesh.Nverts+v];
+        localMin[d] = mymin(localMin[d], xv);
+        localMax[d] = mymax(localMax[d], xv);
+      }
+    }
+  }
+
+  MPI_Allreduce(localMin, minX, mesh.dim, MPI_DFLOAT, MPI_MIN, mesh.comm);
+  MPI_Allreduce(localMax, maxX, mesh.dim, MPI_DFLOAT, MPI_MAX, mesh.comm);
+
+  for(dlong e=0;e<mesh.Nelements;++e){
+    elementGroup[e] = 0;
+    for (int d=0;d<mesh.dim;d++) {
+      dfloat xc = 0.0;
+      for (int v=0;v<mesh.Nverts;v++)
+        xc += EXYZ[d][e*mesh.Nverts+v];
+      xc /= mesh.Nverts;
+
+      if (xc-minX[d]<width || maxX[d]-xc<width)
+        elementGroup[e] = 1;
+    }
+  }
+}
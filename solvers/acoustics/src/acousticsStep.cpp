@@ -35,27 +35,110 @@ dfloat acoustics_t::MaxWaveSpeed(){
 //evaluate ODE rhs = f(q,t)
 void acoustics_t::rhsf(occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
 
+  if (fusedKernels) {
+    // extract q halo on DEVICE
+    traceHalo->ExchangeStart(o_Q, 1, ogs_dfloat);
+
+    // evaluate rhs on internal elements
+    rhsVolumeSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
+
+    traceHalo->ExchangeFinish(o_Q, 1, ogs_dfloat);
+
+    rhsVolumeSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+    return;
+  }
+
   // extract q halo on DEVICE
   traceHalo->ExchangeStart(o_Q, 1, ogs_dfloat);
 
-  volumeKernel(mesh.Nelements,
-               mesh.o_vgeo,
-               mesh.o_D,
-               o_Q,
-               o_RHS);
+  // volume terms do not read the halo
+  rhsVolume(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
+  rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+
+  // compute surface contributions on internal elements
+  rhsSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
 
   traceHalo->ExchangeFinish(o_Q, 1, ogs_dfloat);
 
-  surfaceKernel(mesh.Nelements,
-                mesh.o_sgeo,
-                mesh.o_LIFT,
-                mesh.o_vmapM,
-                mesh.o_vmapP,
-                mesh.o_EToB,
-                T,
-                mesh.o_x,
-                mesh.o_y,
-                mesh.o_z,
-                o_Q,
-                o_RHS);
+  rhsSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+}
+
+//evaluate volume terms of the listed elements
+void acoustics_t::rhsVolume(dlong N, occa::memory& o_ids,
+                            occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (N)
+    volumeKernel(N,
+                 o_ids,
+                 mesh.o_vgeo,
+                 mesh.o_D,
+                 o_Q,
+                 o_RHS);
+}
+
+//evaluate surface terms of the listed elements
+void acoustics_t::rhsSurface(dlong N, occa::memory& o_ids,
+                             occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (N)
+    surfaceKernel(N,
+                  o_ids,
+                  mesh.o_sgeo,
+                  mesh.o_LIFT,
+                  mesh.o_traceM,
+                  mesh.o_traceP,
+                  mesh.o_EToB,
+                  T,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  o_Q,
+                  o_RHS);
+}
+
+//evaluate volume and surface terms of the listed elements in one fused kernel
+void acoustics_t::rhsVolumeSurface(dlong N, occa::memory& o_ids,
+                                   occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (N)
+    volumeSurfaceKernel(N,
+                        o_ids,
+                        mesh.o_vgeo,
+                        mesh.o_sgeo,
+                        mesh.o_D,
+                        mesh.o_LIFT,
+                        mesh.o_traceM,
+                        mesh.o_traceP,
+                        mesh.o_EToB,
+                        T,
+                        mesh.o_x,
+                        mesh.o_y,
+                        mesh.o_z,
+                        o_Q,
+                        o_RHS);
+}
+
+//evaluate ODE rhs = f(q,t) on the elements of multirate level <= lev
+void acoustics_t::rhsf_MR(occa::memory& o_Q, occa::memory& o_RHS, occa::memory& o_fQM,
+                          const dfloat T, const int lev){
+
+  // extract q trace halo and start exchange
+  multirateTraceHalo[lev]->ExchangeStart(o_fQM, 1, ogs_dfloat);
+
+  rhsVolume(mesh.mrNelements[lev], mesh.o_mrElements[lev], o_Q, o_RHS, T);
+
+  // complete trace halo exchange
+  multirateTraceHalo[lev]->ExchangeFinish(o_fQM, 1, ogs_dfloat);
+
+  if (mesh.mrNelements[lev])
+    surfaceKernelMR(mesh.mrNelements[lev],
+                    mesh.o_mrElements[lev],
+                    mesh.o_sgeo,
+                    mesh.o_LIFT,
+                    mesh.o_vmapM,
+                    mesh.o_mapP,
+                    mesh.o_EToB,
+                    T,
+                    mesh.o_x,
+                    mesh.o_y,
+                    mesh.o_z,
+                    o_fQM,
+                    o_RHS);
 }
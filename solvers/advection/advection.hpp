@@ -48,9 +48,15 @@ public:
 class advection_t: public solver_t {
 public:
   mesh_t &mesh;
+
+  int Nensemble;
+
+  int fusedKernels;
+
   TimeStepper::timeStepper_t* timeStepper;
 
   halo_t* traceHalo;
+  halo_t** multirateTraceHalo;
 
   dfloat *q;
   occa::memory o_q;
@@ -60,6 +66,10 @@ public:
   occa::kernel volumeKernel;
   occa::kernel surfaceKernel;
 
+  occa::kernel volumeSurfaceKernel;
+
+  occa::kernel surfaceKernelMR;
+
   occa::kernel initialConditionKernel;
   occa::kernel maxWaveSpeedKernel;
 
@@ -82,6 +92,18 @@ public:
 
   void rhsf(occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
 
+  void rhsVolume(dlong N, occa::memory& o_ids,
+                 occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
+  void rhsSurface(dlong N, occa::memory& o_ids,
+                  occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
+  void rhsVolumeSurface(dlong N, occa::memory& o_ids,
+                        occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
+  void rhsf_MR(occa::memory& o_q, occa::memory& o_rhs, occa::memory& o_fQM,
+               const dfloat time, const int level);
+
   dfloat MaxWaveSpeed(occa::memory& o_Q, const dfloat T);
 };
 
@@ -51,15 +51,29 @@ int main(int argc, char **argv){
   meshSettings.report();
   advectionSettings.report();
 
+  // ranks are split into space communicators, one per time slice
+  MPI_Comm spaceComm = comm;
+  if (!advectionSettings.compareSetting("PARALLEL IN TIME","NONE")) {
+    int Nslices;
+    advectionSettings.getSetting("TIME SLICES", Nslices);
+    spaceComm = TimeStepper::parareal::SplitComm(comm, Nslices);
+  }
+
   // set up mesh
-  mesh_t& mesh = mesh_t::Setup(platform, meshSettings, comm);
+  mesh_t& mesh = mesh_t::Setup(platform, meshSettings, spaceComm);
 
   // set up advection solver
   advection_t& advection = advection_t::Setup(platform, mesh, advectionSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   advection.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
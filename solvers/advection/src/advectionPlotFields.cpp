@@ -51,6 +51,9 @@ void advection_t::PlotFields(dfloat* Q, char *fileName){
   dfloat* Iy = (dfloat *) malloc(mesh.plotNp*sizeof(dfloat));
   dfloat* Iz = (dfloat *) malloc(mesh.plotNp*sizeof(dfloat));
 
+  // download coordinates if they were released after setup
+  mesh.RestoreHostMirrors();
+
   // compute plot node coordinates on the fly
   for(dlong e=0;e<mesh.Nelements;++e){
     mesh.PlotInterp(mesh.x + e*mesh.Np, Ix, scratch);
@@ -62,6 +65,9 @@ void advection_t::PlotFields(dfloat* Q, char *fileName){
       fprintf(fp, "%g %g %g\n", Ix[n],Iy[n],Iz[n]);
     }
   }
+
+  mesh.ReleaseHostMirrors();
+
   fprintf(fp, "        </DataArray>\n");
   fprintf(fp, "      </Points>\n");
 
@@ -73,7 +79,7 @@ void advection_t::PlotFields(dfloat* Q, char *fileName){
   fprintf(fp, "      <PointData Scalars=\"scalars\">\n");
   fprintf(fp, "        <DataArray type=\"Float32\" Name=\"Field\" Format=\"ascii\">\n");
   for(dlong e=0;e<mesh.Nelements;++e){
-    mesh.PlotInterp(Q + e*mesh.Np, Ip, scratch);
+    mesh.PlotInterp(Q + e*mesh.Np*Nensemble, Ip, scratch);
 
     for(int n=0;n<mesh.plotNp;++n){
       fprintf(fp, "       ");
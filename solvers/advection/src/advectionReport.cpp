@@ -33,7 +33,7 @@ void advection_t::Report(dfloat time, int tstep){
   //compute q.M*q
   mesh.MassMatrixApply(o_q, o_Mq);
 
-  dlong Nentries = mesh.Nelements*mesh.Np;
+  dlong Nentries = mesh.Nelements*mesh.Np*Nensemble;
   dfloat norm2 = sqrt(platform.linAlg.innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
   if(mesh.rank==0)
@@ -48,8 +48,16 @@ void advection_t::Report(dfloat time, int tstep){
     string name;
     settings.getSetting("OUTPUT FILE NAME", name);
     char fname[BUFSIZ];
-    sprintf(fname, "%s_%04d_%04d.vtu", name.c_str(), mesh.rank, frame++);
-
-    PlotFields(q, fname);
+    if (Nensemble==1) {
+      sprintf(fname, "%s_%04d_%04d.vtu", name.c_str(), mesh.rank, frame);
+      PlotFields(q, fname);
+    } else {
+      //one file per ensemble member
+      for(int m=0;m<Nensemble;++m){
+        sprintf(fname, "%s_m%03d_%04d_%04d.vtu", name.c_str(), m, mesh.rank, frame);
+        PlotFields(q + m*mesh.Np, fname);
+      }
+    }
+    frame++;
   }
 }
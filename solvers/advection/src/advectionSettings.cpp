@@ -37,7 +37,18 @@ advectionSettings_t::advectionSettings_t(MPI_Comm& _comm):
   newSetting("TIME INTEGRATOR",
              "DOPRI5",
              "Time integration method",
-             {"AB3", "DOPRI5", "LSERK4"});
+             {"AB3", "DOPRI5", "LSERK4", "MRAB3"});
+
+  newSetting("FUSED KERNELS",
+             "FALSE",
+             "Evaluate the volume and surface terms in a single kernel",
+             {"TRUE", "FALSE"});
+
+  newSetting("ENSEMBLE MEMBERS",
+             "1",
+             "Number of independent solution instances advanced together. Not supported with MRAB3 or FUSED KERNELS");
+
+  TimeStepper::parareal::AddSettings(*this);
 
   newSetting("CFL NUMBER",
              "1.0",
@@ -73,6 +84,9 @@ void advectionSettings_t::report() {
     std::cout << "Advection Settings:\n\n";
     reportSetting("DATA FILE");
     reportSetting("TIME INTEGRATOR");
+    TimeStepper::parareal::ReportSettings(*this);
+    reportSetting("FUSED KERNELS");
+    reportSetting("ENSEMBLE MEMBERS");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
     reportSetting("OUTPUT INTERVAL");
@@ -104,4 +118,9 @@ void advectionSettings_t::parseFromFile(platformSettings_t& platformSettings,
       LIBP_ABORT(ss.str());
     }
   }
+
+  //the graph partitioner balances the multirate element costs
+  if (!s.hasSetting("PARTITION WEIGHTS") &&
+      compareSetting("TIME INTEGRATOR","MRAB3"))
+    meshSettings.changeSetting("PARTITION WEIGHTS", "MULTIRATE");
 }
\ No newline at end of file
@@ -31,34 +31,14 @@ advection_t& advection_t::Setup(platform_t& platform, mesh_t& mesh,
 
   advection_t* advection = new advection_t(platform, mesh, settings);
 
-  dlong Nlocal = mesh.Nelements*mesh.Np;
-  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np;
-
-  //setup timeStepper
-  if (settings.compareSetting("TIME INTEGRATOR","AB3")){
-    advection->timeStepper = new TimeStepper::ab3(mesh.Nelements, mesh.totalHaloPairs,
-                                              mesh.Np, 1, *advection);
-  } else if (settings.compareSetting("TIME INTEGRATOR","LSERK4")){
-    advection->timeStepper = new TimeStepper::lserk4(mesh.Nelements, mesh.totalHaloPairs,
-                                              mesh.Np, 1, *advection);
-  } else if (settings.compareSetting("TIME INTEGRATOR","DOPRI5")){
-    advection->timeStepper = new TimeStepper::dopri5(mesh.Nelements, mesh.totalHaloPairs,
-                                              mesh.Np, 1, *advection, mesh.comm);
-  }
-
-  //setup linear algebra module
-  platform.linAlg.InitKernels({"innerProd", "max"});
-
-  /*setup trace halo exchange */
-  advection->traceHalo = mesh.HaloTraceSetup(1); //one field
-
-  // compute samples of q at interpolation nodes
-  advection->q = (dfloat*) calloc(Nlocal+Nhalo, sizeof(dfloat));
-  advection->o_q = platform.malloc((Nlocal+Nhalo)*sizeof(dfloat), advection->q);
-
-  //storage for M*q during reporting
-  advection->o_Mq = platform.malloc((Nlocal+Nhalo)*sizeof(dfloat), advection->q);
-  mesh.MassMatrixKernelSetup(1); // mass matrix operator
+  //independent solution instances advanced together
+  settings.getSetting("ENSEMBLE MEMBERS", advection->Nensemble);
+  if (advection->Nensemble<1)
+    LIBP_ABORT(string("ENSEMBLE MEMBERS must be at least 1"))
+  if (advection->Nensemble>1
+      && (settings.compareSetting("TIME INTEGRATOR","MRAB3")
+          || settings.compareSetting("FUSED KERNELS","TRUE")))
+    LIBP_ABORT(string("ENSEMBLE MEMBERS > 1 is not supported with MRAB3 or FUSED KERNELS"))
 
   // OCCA build stuff
   occa::properties kernelInfo = mesh.props; //copy base occa properties
@@ -69,6 +49,7 @@ advection_t& advection_t::Setup(platform_t& platform, mesh_t& mesh,
   kernelInfo["includes"] += dataFileName;
 
   kernelInfo["defines/" "p_Nfields"]= 1;
+  kernelInfo["defines/" "p_Nensemble"]= advection->Nensemble;
 
   int maxNodes = mymax(mesh.Np, (mesh.Nfp*mesh.Nfaces));
   kernelInfo["defines/" "p_maxNodes"]= maxNodes;
@@ -108,6 +89,13 @@ advection_t& advection_t::Setup(platform_t& platform, mesh_t& mesh,
 
   advection->surfaceKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
 
+  advection->fusedKernels = settings.compareSetting("FUSED KERNELS","TRUE");
+  //fused volume+surface kernel, from the surface file
+  if (advection->fusedKernels) {
+    sprintf(kernelName, "advectionVolumeSurface%s", suffix);
+    advection->volumeSurfaceKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+  }
+
   if (mesh.dim==2) {
     sprintf(fileName, DADVECTION "/okl/advectionInitialCondition2D.okl");
     sprintf(kernelName, "advectionInitialCondition2D");
@@ -123,15 +111,159 @@ advection_t& advection_t::Setup(platform_t& platform, mesh_t& mesh,
 
   advection->maxWaveSpeedKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
 
+  //multirate surface kernel reads the traces from the multirate trace buffer
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    sprintf(fileName, DADVECTION "/okl/advectionSurface%s.okl", suffix);
+    sprintf(kernelName, "advectionMRSurface%s", suffix);
+
+    advection->surfaceKernelMR = platform.buildKernel(fileName, kernelName, kernelInfo);
+  }
+
+  mesh.mrNlevels=0;
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")) {
+    //make array of time step estimates for each element from the
+    //local wave speed of the initial condition
+    dfloat startTime;
+    settings.getSetting("START TIME", startTime);
+
+    occa::memory o_q0 = platform.malloc(mesh.Nelements*mesh.Np*sizeof(dfloat));
+    occa::memory o_maxSpeed = platform.malloc(mesh.Nelements*sizeof(dfloat));
+
+    advection->initialConditionKernel(mesh.Nelements,
+                                      startTime,
+                                      mesh.o_x,
+                                      mesh.o_y,
+                                      mesh.o_z,
+                                      o_q0);
+
+    advection->maxWaveSpeedKernel(mesh.Nelements,
+                                  mesh.o_vgeo,
+                                  mesh.o_sgeo,
+                                  mesh.o_vmapM,
+                                  mesh.o_EToB,
+                                  startTime,
+                                  mesh.o_x,
+                                  mesh.o_y,
+                                  mesh.o_z,
+                                  o_q0,
+                                  o_maxSpeed);
+
+    dfloat *maxSpeed = (dfloat *) calloc(mesh.Nelements,sizeof(dfloat));
+    o_maxSpeed.copyTo(maxSpeed);
+    o_maxSpeed.free();
+    o_q0.free();
+
+    dfloat vmax=0.0, gvmax=0.0;
+    for(dlong e=0;e<mesh.Nelements;++e) vmax = mymax(vmax, maxSpeed[e]);
+    MPI_Allreduce(&vmax, &gvmax, 1, MPI_DFLOAT, MPI_MAX, mesh.comm);
+
+    //bound the number of levels where the flow is (nearly) stagnant
+    dfloat *EtoDT = (dfloat *) calloc(mesh.Nelements,sizeof(dfloat));
+    for(dlong e=0;e<mesh.Nelements;++e){
+      dfloat speed = mymax(maxSpeed[e], 1.0e-3*gvmax);
+      EtoDT[e] = 1.0/(speed*(mesh.N+1.)*(mesh.N+1.));
+    }
+    free(maxSpeed);
+
+    //rebalance the partition so each rank owns an equal share of every level
+    mesh.MultiRatePartition(EtoDT);
+
+    mesh.MultiRateSetup(EtoDT);
+    advection->multirateTraceHalo = mesh.MultiRateHaloTraceSetup(1); //one field
+    free(EtoDT);
+  }
+
+  //ensemble members are interleaved per element, so they behave as extra fields
+  const int Nensemble = advection->Nensemble;
+
+  dlong Nlocal = mesh.Nelements*mesh.Np*Nensemble;
+  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*Nensemble;
+
+  //setup timeStepper
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3")){
+    advection->timeStepper = new TimeStepper::mrab3(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, 1, *advection, mesh);
+  } else if (settings.compareSetting("TIME INTEGRATOR","AB3")){
+    advection->timeStepper = new TimeStepper::ab3(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, Nensemble, *advection);
+  } else if (settings.compareSetting("TIME INTEGRATOR","LSERK4")){
+    advection->timeStepper = new TimeStepper::lserk4(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, Nensemble, *advection);
+  } else if (settings.compareSetting("TIME INTEGRATOR","DOPRI5")){
+    advection->timeStepper = new TimeStepper::dopri5(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, Nensemble, *advection, mesh.comm);
+  }
+
+  //parallel-in-time driver, with the time integrator as fine propagator
+  if (!settings.compareSetting("PARALLEL IN TIME","NONE")) {
+    if (settings.compareSetting("TIME INTEGRATOR","MRAB3"))
+      LIBP_ABORT(string("PARALLEL IN TIME is not supported with MRAB3"))
+
+    int coarseN=0;
+    settings.getSetting("COARSE POLYNOMIAL DEGREE", coarseN);
+    if (coarseN<0) LIBP_ABORT(string("COARSE POLYNOMIAL DEGREE must be non-negative"))
+
+    TimeStepper::timeStepper_t* coarse;
+    advection_t* coarseSolver = nullptr;
+    advectionSettings_t* coarseSettings = nullptr;
+
+    if (coarseN>0 && coarseN<mesh.N) {
+      //coarse propagator is a separate solver on a lower degree copy of the mesh
+      mesh_t &meshC = mesh.SetupNewDegree(coarseN);
+
+      coarseSettings = new advectionSettings_t(settings);
+      coarseSettings->changeSetting("PARALLEL IN TIME", "NONE");
+      coarseSettings->changeSetting("TIME INTEGRATOR",
+                                    settings.getSetting("COARSE TIME INTEGRATOR"));
+
+      coarseSolver = &(advection_t::Setup(platform, meshC, *coarseSettings));
+      coarse = coarseSolver->timeStepper;
+      coarseSolver->timeStepper = nullptr;
+    } else if (settings.compareSetting("COARSE TIME INTEGRATOR","LSERK4")) {
+      coarse = new TimeStepper::lserk4(mesh.Nelements, mesh.totalHaloPairs,
+                                       mesh.Np, Nensemble, *advection);
+    } else {
+      coarse = new TimeStepper::ab3(mesh.Nelements, mesh.totalHaloPairs,
+                                    mesh.Np, Nensemble, *advection);
+    }
+
+    TimeStepper::parareal* pit = new TimeStepper::parareal(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, Nensemble, *advection,
+                                              mesh.comm, settings.comm,
+                                              coarse, advection->timeStepper);
+    if (coarseSolver)
+      pit->SetCoarseSpace(mesh, coarseSolver->mesh, coarseSolver, coarseSettings);
+    advection->timeStepper = pit;
+  }
+
+  //setup linear algebra module
+  platform.linAlg.InitKernels({"innerProd", "innerProdMulti", "max"});
+
+  /*setup trace halo exchange */
+  advection->traceHalo = mesh.HaloTraceSetup(Nensemble); //one field per member
+
+  // compute samples of q at interpolation nodes
+  advection->q = (dfloat*) calloc(Nlocal+Nhalo, sizeof(dfloat));
+  advection->o_q = platform.malloc((Nlocal+Nhalo)*sizeof(dfloat), advection->q);
+
+  //storage for M*q during reporting
+  advection->o_Mq = platform.malloc((Nlocal+Nhalo)*sizeof(dfloat), advection->q);
+  mesh.MassMatrixKernelSetup(Nensemble); // mass matrix operator
+
   return *advection;
 }
 
 advection_t::~advection_t() {
   volumeKernel.free();
   surfaceKernel.free();
+  volumeSurfaceKernel.free();
+  surfaceKernelMR.free();
   initialConditionKernel.free();
   maxWaveSpeedKernel.free();
 
   if (timeStepper) delete timeStepper;
   if (traceHalo) traceHalo->Free();
+
+  for (int lev=0;lev<mesh.mrNlevels;lev++)
+    if (multirateTraceHalo[lev]) multirateTraceHalo[lev]->Free();
 }
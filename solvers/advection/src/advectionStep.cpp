@@ -28,8 +28,8 @@ SOFTWARE.
 
 dfloat advection_t::MaxWaveSpeed(occa::memory& o_Q, const dfloat T){
 
-  //Note: if this is on the critical path in the future, we should pre-allocate this
-  occa::memory o_maxSpeed = platform.malloc(mesh.Nelements*sizeof(dfloat));
+  //transient buffer from the platform pool
+  occa::memory o_maxSpeed = platform.reserve(mesh.Nelements*Nensemble*sizeof(dfloat));
 
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_vgeo,
@@ -43,40 +43,123 @@ dfloat advection_t::MaxWaveSpeed(occa::memory& o_Q, const dfloat T){
                      o_Q,
                      o_maxSpeed);
 
-  const dfloat vmax = platform.linAlg.max(mesh.Nelements, o_maxSpeed, mesh.comm);
+  const dfloat vmax = platform.linAlg.max(mesh.Nelements*Nensemble, o_maxSpeed, mesh.comm);
 
-  o_maxSpeed.free();
+  platform.release(o_maxSpeed);
   return vmax;
 }
 
 //evaluate ODE rhs = f(q,t)
 void advection_t::rhsf(occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
 
+  if (fusedKernels) {
+    // extract q halo on DEVICE
+    traceHalo->ExchangeStart(o_Q, 1, ogs_dfloat);
+
+    // evaluate rhs on internal elements
+    rhsVolumeSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
+
+    traceHalo->ExchangeFinish(o_Q, 1, ogs_dfloat);
+
+    rhsVolumeSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+    return;
+  }
+
   // extract q halo on DEVICE
   traceHalo->ExchangeStart(o_Q, 1, ogs_dfloat);
 
-  volumeKernel(mesh.Nelements,
-               mesh.o_vgeo,
-               mesh.o_D,
-               T,
-               mesh.o_x,
-               mesh.o_y,
-               mesh.o_z,
-               o_Q,
-               o_RHS);
+  // volume terms do not read the halo
+  rhsVolume(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
+  rhsVolume(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+
+  // compute surface contributions on internal elements
+  rhsSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
 
   traceHalo->ExchangeFinish(o_Q, 1, ogs_dfloat);
 
-  surfaceKernel(mesh.Nelements,
-                mesh.o_sgeo,
-                mesh.o_LIFT,
-                mesh.o_vmapM,
-                mesh.o_vmapP,
-                mesh.o_EToB,
-                T,
-                mesh.o_x,
-                mesh.o_y,
-                mesh.o_z,
-                o_Q,
-                o_RHS);
+  rhsSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+}
+
+//evaluate volume terms of the listed elements
+void advection_t::rhsVolume(dlong N, occa::memory& o_ids,
+                            occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (N)
+    volumeKernel(N,
+                 o_ids,
+                 mesh.o_vgeo,
+                 mesh.o_D,
+                 T,
+                 mesh.o_x,
+                 mesh.o_y,
+                 mesh.o_z,
+                 o_Q,
+                 o_RHS);
+}
+
+//evaluate surface terms of the listed elements
+void advection_t::rhsSurface(dlong N, occa::memory& o_ids,
+                             occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (N)
+    surfaceKernel(N,
+                  o_ids,
+                  mesh.o_sgeo,
+                  mesh.o_LIFT,
+                  mesh.o_traceM,
+                  mesh.o_traceP,
+                  mesh.o_EToB,
+                  T,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  o_Q,
+                  o_RHS);
+}
+
+//evaluate volume and surface terms of the listed elements in one fused kernel
+void advection_t::rhsVolumeSurface(dlong N, occa::memory& o_ids,
+                                   occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (N)
+    volumeSurfaceKernel(N,
+                        o_ids,
+                        mesh.o_vgeo,
+                        mesh.o_sgeo,
+                        mesh.o_D,
+                        mesh.o_LIFT,
+                        mesh.o_traceM,
+                        mesh.o_traceP,
+                        mesh.o_EToB,
+                        T,
+                        mesh.o_x,
+                        mesh.o_y,
+                        mesh.o_z,
+                        o_Q,
+                        o_RHS);
+}
+
+//evaluate ODE rhs = f(q,t) on the elements of multirate level <= lev
+void advection_t::rhsf_MR(occa::memory& o_Q, occa::memory& o_RHS, occa::memory& o_fQM,
+                          const dfloat T, const int lev){
+
+  // extract q trace halo and start exchange
+  multirateTraceHalo[lev]->ExchangeStart(o_fQM, 1, ogs_dfloat);
+
+  rhsVolume(mesh.mrNelements[lev], mesh.o_mrElements[lev], o_Q, o_RHS, T);
+
+  // complete trace halo exchange
+  multirateTraceHalo[lev]->ExchangeFinish(o_fQM, 1, ogs_dfloat);
+
+  if (mesh.mrNelements[lev])
+    surfaceKernelMR(mesh.mrNelements[lev],
+                    mesh.o_mrElements[lev],
+                    mesh.o_sgeo,
+                    mesh.o_LIFT,
+                    mesh.o_vmapM,
+                    mesh.o_mapP,
+                    mesh.o_EToB,
+                    T,
+                    mesh.o_x,
+                    mesh.o_y,
+                    mesh.o_z,
+                    o_fQM,
+                    o_RHS);
 }
@@ -58,9 +58,15 @@ int main(int argc, char **argv){
   // set up bns solver
   bns_t& bns = bns_t::Setup(platform, mesh, bnsSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   bns.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
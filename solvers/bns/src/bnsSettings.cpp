@@ -140,4 +140,13 @@ void bnsSettings_t::parseFromFile(platformSettings_t& platformSettings,
       LIBP_ABORT(ss.str());
     }
   }
+
+  //the graph partitioner balances the PML and multirate element costs
+  if (!s.hasSetting("PARTITION WEIGHTS")) {
+    if (compareSetting("TIME INTEGRATOR","MRAB3") ||
+        compareSetting("TIME INTEGRATOR","MRSAAB3"))
+      meshSettings.changeSetting("PARTITION WEIGHTS", "PML+MULTIRATE");
+    else
+      meshSettings.changeSetting("PARTITION WEIGHTS", "PML");
+  }
 }
\ No newline at end of file
@@ -40,16 +40,6 @@ bns_t& bns_t::Setup(platform_t& platform, mesh_t& mesh,
   bns->Nfields    = (mesh.dim==3) ? 10:6;
   bns->Npmlfields = mesh.dim*bns->Nfields;
 
-  //setup cubature
-  mesh.CubatureSetup();
-
-  //Setup PML
-  bns->PmlSetup();
-
-  //setup timeStepper
-  dlong Nlocal = mesh.Nelements*mesh.Np*bns->Nfields;
-  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*bns->Nfields;
-
   bns->semiAnalytic = 0;
   if (settings.compareSetting("TIME INTEGRATOR","SARK4")
     ||settings.compareSetting("TIME INTEGRATOR","SARK5")
@@ -99,6 +89,21 @@ bns_t& bns_t::Setup(platform_t& platform, mesh_t& mesh,
 #endif
   }
 
+  //rebalance the partition so each rank owns an equal share of every level
+  if (settings.compareSetting("TIME INTEGRATOR","MRAB3") ||
+      settings.compareSetting("TIME INTEGRATOR","MRSAAB3"))
+    mesh.MultiRatePartition(EtoDT);
+
+  //setup cubature
+  mesh.CubatureSetup();
+
+  //Setup PML
+  bns->PmlSetup();
+
+  //setup timeStepper
+  dlong Nlocal = mesh.Nelements*mesh.Np*bns->Nfields;
+  dlong Nhalo  = mesh.totalHaloPairs*mesh.Np*bns->Nfields;
+
   mesh.mrNlevels=0;
   if (settings.compareSetting("TIME INTEGRATOR","MRAB3") ||
       settings.compareSetting("TIME INTEGRATOR","MRSAAB3")) {
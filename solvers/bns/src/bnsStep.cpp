@@ -48,12 +48,19 @@ void bns_t::rhsf_pml(occa::memory& o_Q, occa::memory& o_pmlQ,
   rhsPmlRelaxation(mesh.NpmlElements, mesh.o_pmlElements, mesh.o_pmlIds,
                    o_Q, o_pmlQ, o_RHS, o_pmlRHS);
 
+  // compute surface contribution to bns RHS on internal elements
+  rhsSurface(mesh.NnonPmlInternalElements, mesh.o_nonPmlElements, o_Q, o_RHS, T);
+  rhsPmlSurface(mesh.NpmlInternalElements, mesh.o_pmlElements, mesh.o_pmlIds,
+                o_Q, o_pmlQ, o_RHS, o_pmlRHS, T);
+
   // complete trace halo exchange
   traceHalo->ExchangeFinish(o_Q, 1, ogs_dfloat);
 
-  // compute surface contribution to bns RHS
-  rhsSurface(mesh.NnonPmlElements, mesh.o_nonPmlElements, o_Q, o_RHS, T);
-  rhsPmlSurface(mesh.NpmlElements, mesh.o_pmlElements, mesh.o_pmlIds,
+  // compute surface contribution to bns RHS on halo elements
+  rhsSurface(mesh.NnonPmlElements-mesh.NnonPmlInternalElements,
+             mesh.o_nonPmlHaloElements, o_Q, o_RHS, T);
+  rhsPmlSurface(mesh.NpmlElements-mesh.NpmlInternalElements,
+                mesh.o_pmlHaloElements, mesh.o_pmlHaloIds,
                 o_Q, o_pmlQ, o_RHS, o_pmlRHS, T);
 }
 
@@ -208,8 +215,8 @@ void bns_t::rhsSurface(dlong N, occa::memory& o_ids,
                   o_ids,
                   mesh.o_sgeo,
                   mesh.o_LIFT,
-                  mesh.o_vmapM,
-                  mesh.o_vmapP,
+                  mesh.o_traceM,
+                  mesh.o_traceP,
                   mesh.o_EToB,
                   mesh.o_x,
                   mesh.o_y,
@@ -232,8 +239,8 @@ void bns_t::rhsPmlSurface(dlong N, occa::memory& o_ids, occa::memory& o_pmlids,
                     o_pmlids,
                     mesh.o_sgeo,
                     mesh.o_LIFT,
-                    mesh.o_vmapM,
-                    mesh.o_vmapP,
+                    mesh.o_traceM,
+                    mesh.o_traceP,
                     mesh.o_EToB,
                     mesh.o_x,
                     mesh.o_y,
@@ -108,6 +108,12 @@ public:
 
   void rhsf(occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
 
+  void rhsGradSurface(dlong N, occa::memory& o_ids,
+                      occa::memory& o_q, const dfloat time);
+
+  void rhsSurface(dlong N, occa::memory& o_ids,
+                  occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
+
   dfloat MaxWaveSpeed(occa::memory& o_Q, const dfloat T);
 };
 
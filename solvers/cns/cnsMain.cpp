@@ -58,9 +58,15 @@ int main(int argc, char **argv){
   // set up cns solver
   cns_t& cns = cns_t::Setup(platform, mesh, cnsSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   cns.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
@@ -51,6 +51,9 @@ void cns_t::PlotFields(dfloat* Q, dfloat *V, char *fileName){
   dfloat* Iy = (dfloat *) malloc(mesh.plotNp*sizeof(dfloat));
   dfloat* Iz = (dfloat *) malloc(mesh.plotNp*sizeof(dfloat));
 
+  // download coordinates if they were released after setup
+  mesh.RestoreHostMirrors();
+
   // compute plot node coordinates on the fly
   for(dlong e=0;e<mesh.Nelements;++e){
     mesh.PlotInterp(mesh.x + e*mesh.Np, Ix, scratch);
@@ -62,6 +65,9 @@ void cns_t::PlotFields(dfloat* Q, dfloat *V, char *fileName){
       fprintf(fp, "%g %g %g\n", Ix[n],Iy[n],Iz[n]);
     }
   }
+
+  mesh.ReleaseHostMirrors();
+
   fprintf(fp, "        </DataArray>\n");
   fprintf(fp, "      </Points>\n");
 
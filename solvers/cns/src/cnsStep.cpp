@@ -28,8 +28,8 @@ SOFTWARE.
 
 dfloat cns_t::MaxWaveSpeed(occa::memory& o_Q, const dfloat T){
 
-  //Note: if this is on the critical path in the future, we should pre-allocate this
-  occa::memory o_maxSpeed = platform.malloc(mesh.Nelements*sizeof(dfloat));
+  //transient buffer from the platform pool
+  occa::memory o_maxSpeed = platform.reserve(mesh.Nelements*sizeof(dfloat));
 
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_vgeo,
@@ -47,7 +47,7 @@ dfloat cns_t::MaxWaveSpeed(occa::memory& o_Q, const dfloat T){
 
   const dfloat vmax = platform.linAlg.max(mesh.Nelements, o_maxSpeed, mesh.comm);
 
-  o_maxSpeed.free();
+  platform.release(o_maxSpeed);
   return vmax;
 }
 
@@ -64,24 +64,14 @@ void cns_t::rhsf(occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
                    o_Q,
                    o_gradq);
 
+  // compute surface contributions to gradients on internal elements
+  rhsGradSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, T);
+
   // complete trace halo exchange
   fieldTraceHalo->ExchangeFinish(o_Q, 1, ogs_dfloat);
 
-  // compute surface contributions to gradients
-  gradSurfaceKernel(mesh.Nelements,
-                    mesh.o_sgeo,
-                    mesh.o_LIFT,
-                    mesh.o_vmapM,
-                    mesh.o_vmapP,
-                    mesh.o_EToB,
-                    mesh.o_x,
-                    mesh.o_y,
-                    mesh.o_z,
-                    T,
-                    mu,
-                    gamma,
-                    o_Q,
-                    o_gradq);
+  // compute surface contributions to gradients on halo elements
+  rhsGradSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, T);
 
   // extract viscousStresses trace halo and start exchange
   gradTraceHalo->ExchangeStart(o_gradq, 1, ogs_dfloat);
@@ -119,42 +109,76 @@ void cns_t::rhsf(occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
                  o_RHS);
   }
 
+  // compute surface contribution to cns RHS on internal elements
+  rhsSurface(mesh.NinternalElements, mesh.o_internalElementIds, o_Q, o_RHS, T);
+
   // complete trace halo exchange
   gradTraceHalo->ExchangeFinish(o_gradq, 1, ogs_dfloat);
 
+  rhsSurface(mesh.NhaloElements, mesh.o_haloElementIds, o_Q, o_RHS, T);
+}
+
+//evaluate surface contributions to gradients of the listed elements
+void cns_t::rhsGradSurface(dlong N, occa::memory& o_ids,
+                           occa::memory& o_Q, const dfloat T){
+  if (N)
+    gradSurfaceKernel(N,
+                      o_ids,
+                      mesh.o_sgeo,
+                      mesh.o_LIFT,
+                      mesh.o_traceM,
+                      mesh.o_traceP,
+                      mesh.o_EToB,
+                      mesh.o_x,
+                      mesh.o_y,
+                      mesh.o_z,
+                      T,
+                      mu,
+                      gamma,
+                      o_Q,
+                      o_gradq);
+}
+
+//evaluate surface contributions to cns RHS of the listed elements
+void cns_t::rhsSurface(dlong N, occa::memory& o_ids,
+                       occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  if (!N) return;
+
   if (cubature) {
-      cubatureSurfaceKernel(mesh.Nelements,
-                            mesh.o_vgeo,
-                            mesh.o_cubsgeo,
-                            mesh.o_vmapM,
-                            mesh.o_vmapP,
-                            mesh.o_EToB,
-                            mesh.o_intInterp,
-                            mesh.o_intLIFT,
-                            mesh.o_intx,
-                            mesh.o_inty,
-                            mesh.o_intz,
-                            T,
-                            mu,
-                            gamma,
-                            o_Q,
-                            o_gradq,
-                            o_RHS);
-    } else {
-      surfaceKernel(mesh.Nelements,
-                    mesh.o_sgeo,
-                    mesh.o_LIFT,
-                    mesh.o_vmapM,
-                    mesh.o_vmapP,
-                    mesh.o_EToB,
-                    mesh.o_x,
-                    mesh.o_y,
-                    mesh.o_z,
-                    T,
-                    mu,
-                    gamma,
-                    o_Q,
-                    o_gradq,
-                    o_RHS);
-    }
+    cubatureSurfaceKernel(N,
+                          o_ids,
+                          mesh.o_vgeo,
+                          mesh.o_cubsgeo,
+                          mesh.o_traceM,
+                          mesh.o_traceP,
+                          mesh.o_EToB,
+                          mesh.o_intInterp,
+                          mesh.o_intLIFT,
+                          mesh.o_intx,
+                          mesh.o_inty,
+                          mesh.o_intz,
+                          T,
+                          mu,
+                          gamma,
+                          o_Q,
+                          o_gradq,
+                          o_RHS);
+  } else {
+    surfaceKernel(N,
+                  o_ids,
+                  mesh.o_sgeo,
+                  mesh.o_LIFT,
+                  mesh.o_traceM,
+                  mesh.o_traceP,
+                  mesh.o_EToB,
+                  mesh.o_x,
+                  mesh.o_y,
+                  mesh.o_z,
+                  T,
+                  mu,
+                  gamma,
+                  o_Q,
+                  o_gradq,
+                  o_RHS);
+  }
 }
@@ -100,11 +100,16 @@ public:
   occa::kernel partialGradientKernel;
   occa::kernel partialIpdgKernel;
 
+  //blocked operator for multiple right-hand sides
+  int NblockRhs;
+  occa::memory o_AqLBlock;
+  occa::kernel partialBlockAxKernel;
+
   elliptic_t() = delete;
   elliptic_t(platform_t &_platform, mesh_t &_mesh,
               settings_t& _settings, dfloat _lambda):
     solver_t(_platform, _settings), mesh(_mesh),
-    linAlg(_platform.linAlg), lambda(_lambda) {}
+    linAlg(_platform.linAlg), lambda(_lambda), NblockRhs(0) {}
 
   ~elliptic_t();
 
@@ -120,10 +125,18 @@ public:
   int Solve(linearSolver_t& linearSolver, occa::memory &o_x, occa::memory &o_r,
             const dfloat tol, const int MAXIT, const int verbose);
 
+  int BlockSolve(blockLinearSolver_t& linearSolver, const int Nrhs,
+                 occa::memory &o_x, occa::memory &o_r,
+                 const dfloat tol, const int MAXIT, const int verbose);
+
   void PlotFields(dfloat* Q, char *fileName);
 
   void Operator(occa::memory& o_q, occa::memory& o_Aq);
 
+  void BlockSetup(const int Nrhs);
+  void BlockOperator(const int Nrhs, const dlong stride,
+                     occa::memory& o_q, occa::memory& o_Aq);
+
   void BuildOperatorMatrixIpdg(parAlmond::parCOO& A);
   void BuildOperatorMatrixContinuous(parAlmond::parCOO& A);
 
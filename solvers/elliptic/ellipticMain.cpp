@@ -67,9 +67,15 @@ int main(int argc, char **argv){
   elliptic_t& elliptic = elliptic_t::Setup(platform, mesh, ellipticSettings,
                                            lambda, NBCTypes, BCType);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   elliptic.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
@@ -76,6 +76,8 @@ public:
   ~ParAlmondPrecon();
   ParAlmondPrecon(elliptic_t& elliptic);
   void Operator(occa::memory& o_r, occa::memory& o_Mr);
+  void BlockOperator(const int Nrhs, const dlong stride,
+                     occa::memory& o_r, occa::memory& o_Mr);
 };
 
 // Matrix-free p-Multigrid levels followed by AMG
@@ -91,6 +93,8 @@ public:
   MultiGridPrecon(elliptic_t& elliptic);
   ~MultiGridPrecon() = default;
   void Operator(occa::memory& o_r, occa::memory& o_Mr);
+  void BlockOperator(const int Nrhs, const dlong stride,
+                     occa::memory& o_r, occa::memory& o_Mr);
 };
 
 // Cast problem into spectrally-equivalent N=1 FEM space and precondition with AMG
@@ -192,6 +196,12 @@ public:
   static occa::memory o_smootherUpdate;
   static occa::memory o_transferScratch;
 
+  //scratch of the blocked smoothers
+  static size_t blockSmootherBytes;
+  static occa::memory o_blockSmootherResidual;
+  static occa::memory o_blockSmootherResidual2;
+  static occa::memory o_blockSmootherUpdate;
+
   //jacobi data
   occa::memory o_invDiagA;
 
@@ -215,12 +225,24 @@ public:
   void smoothJacobi    (occa::memory &o_r, occa::memory &o_X, bool xIsZero);
   void smoothChebyshev (occa::memory &o_r, occa::memory &o_X, bool xIsZero);
 
+  //blocked ops on Nrhs vectors stored stride entries apart
+  void residualBlock(const int Nrhs, const dlong stride,
+                     occa::memory &o_RHS, occa::memory &o_X, occa::memory &o_RES);
+  void smoothBlock(const int Nrhs, const dlong stride,
+                   occa::memory &o_RHS, occa::memory &o_X, bool x_is_zero);
+
+  void smoothJacobiBlock    (const int Nrhs, const dlong stride,
+                             occa::memory &o_r, occa::memory &o_X, bool xIsZero);
+  void smoothChebyshevBlock (const int Nrhs, const dlong stride,
+                             occa::memory &o_r, occa::memory &o_X, bool xIsZero);
+
   void Report();
 
   void SetupSmoother();
   dfloat maxEigSmoothAx();
 
   void AllocateStorage();
+  void AllocateBlockStorage(const int Nrhs, const dlong stride);
 };
 
 
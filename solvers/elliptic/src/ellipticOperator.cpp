@@ -144,3 +144,53 @@ void elliptic_t::Operator(occa::memory &o_q, occa::memory &o_Aq){
   }
 }
 
+void elliptic_t::BlockOperator(const int Nrhs, const dlong stride,
+                               occa::memory &o_q, occa::memory &o_Aq){
+
+  //build the blocked kernel on first use, e.g. on multigrid levels
+  if (Nrhs>NblockRhs) BlockSetup(Nrhs);
+
+  //no blocked kernel for this discretization, apply A one column at a time
+  if(!partialBlockAxKernel.isInitialized()) {
+    solver_t::BlockOperator(Nrhs, stride, o_q, o_Aq);
+    return;
+  }
+
+  const dlong Lstride = mesh.Np*mesh.Nelements;
+
+  // the gathered halo exchange shares one buffer, so exchange one column
+  // at a time, overlapping the first exchange with the local elements
+  occa::memory o_q0 = o_q;
+  ogsMasked->GatheredHaloExchangeStart(o_q0, 1, ogs_dfloat);
+
+  if(mesh.NlocalGatherElements)
+    partialBlockAxKernel(mesh.NlocalGatherElements,
+                         mesh.o_localGatherElementList,
+                         ogsMasked->o_GlobalToLocal,
+                         mesh.o_ggeo, mesh.o_D, mesh.o_S,
+                         mesh.o_MM, lambda,
+                         Nrhs, stride, Lstride,
+                         o_q, o_AqLBlock);
+
+  ogsMasked->GatheredHaloExchangeFinish(o_q0, 1, ogs_dfloat);
+
+  for (int n=1;n<Nrhs;n++) {
+    occa::memory o_qn = o_q + n*stride*sizeof(dfloat);
+    ogsMasked->GatheredHaloExchangeStart(o_qn, 1, ogs_dfloat);
+    ogsMasked->GatheredHaloExchangeFinish(o_qn, 1, ogs_dfloat);
+  }
+
+  if(mesh.NglobalGatherElements)
+    partialBlockAxKernel(mesh.NglobalGatherElements,
+                         mesh.o_globalGatherElementList,
+                         ogsMasked->o_GlobalToLocal,
+                         mesh.o_ggeo, mesh.o_D, mesh.o_S,
+                         mesh.o_MM, lambda,
+                         Nrhs, stride, Lstride,
+                         o_q, o_AqLBlock);
+
+  //gather every result column to Aq
+  ogsMasked->GatherMany(o_Aq, o_AqLBlock, Nrhs, stride, Lstride,
+                        ogs_dfloat, ogs_add, ogs_trans);
+}
+
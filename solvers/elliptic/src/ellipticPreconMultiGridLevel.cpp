@@ -180,6 +180,134 @@ void MGLevel::smoothChebyshev (occa::memory &o_r, occa::memory &o_X, bool xIsZer
   linAlg.axpy(elliptic.Ndofs, 1.f, o_d, 1.0, o_X);
 }
 
+//column n of a block vector with columns stride entries apart
+static occa::memory Column(occa::memory &o_X, const dlong stride, const int n) {
+  return o_X + n*stride*sizeof(dfloat);
+}
+
+void MGLevel::residualBlock(const int Nrhs, const dlong stride,
+                            occa::memory &o_RHS, occa::memory &o_X, occa::memory &o_RES) {
+  elliptic.BlockOperator(Nrhs, stride, o_X, o_RES);
+
+  // subtract res = rhs - A*x
+  for (int n=0;n<Nrhs;n++) {
+    occa::memory o_RHSn = Column(o_RHS, stride, n);
+    occa::memory o_RESn = Column(o_RES, stride, n);
+    linAlg.axpy(elliptic.Ndofs, 1.f, o_RHSn, -1.f, o_RESn);
+  }
+}
+
+void MGLevel::smoothBlock(const int Nrhs, const dlong stride,
+                          occa::memory &o_RHS, occa::memory &o_X, bool x_is_zero) {
+  AllocateBlockStorage(Nrhs, stride);
+
+  if (stype==JACOBI) {
+    smoothJacobiBlock(Nrhs, stride, o_RHS, o_X, x_is_zero);
+  } else if (stype==CHEBYSHEV) {
+    smoothChebyshevBlock(Nrhs, stride, o_RHS, o_X, x_is_zero);
+  }
+}
+
+void MGLevel::smoothJacobiBlock(const int Nrhs, const dlong stride,
+                                occa::memory &o_r, occa::memory &o_X, bool xIsZero) {
+
+  occa::memory &o_RES = o_blockSmootherResidual;
+
+  if (xIsZero) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_rn = Column(o_r, stride, n);
+      occa::memory o_Xn = Column(o_X, stride, n);
+      linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_rn, 0.0, o_Xn);
+    }
+    return;
+  }
+
+  //res = r-Ax
+  elliptic.BlockOperator(Nrhs, stride, o_X, o_RES);
+
+  for (int n=0;n<Nrhs;n++) {
+    occa::memory o_rn   = Column(o_r, stride, n);
+    occa::memory o_Xn   = Column(o_X, stride, n);
+    occa::memory o_RESn = Column(o_RES, stride, n);
+    linAlg.axpy(elliptic.Ndofs, 1.f, o_rn, -1.f, o_RESn);
+
+    //smooth the fine problem x = x + S(r-Ax)
+    linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_RESn, 1.0, o_Xn);
+  }
+}
+
+void MGLevel::smoothChebyshevBlock(const int Nrhs, const dlong stride,
+                                   occa::memory &o_r, occa::memory &o_X, bool xIsZero) {
+
+  const dfloat theta = 0.5*(lambda1+lambda0);
+  const dfloat delta = 0.5*(lambda1-lambda0);
+  const dfloat invTheta = 1.0/theta;
+  const dfloat sigma = theta/delta;
+  dfloat rho_n = 1./sigma;
+  dfloat rho_np1;
+
+  occa::memory &o_RES = o_blockSmootherResidual;
+  occa::memory &o_Ad  = o_blockSmootherResidual2;
+  occa::memory &o_d   = o_blockSmootherUpdate;
+
+  //res = S*(r-Ax), skipping the Ax if x is zero
+  if (!xIsZero)
+    elliptic.BlockOperator(Nrhs, stride, o_X, o_RES);
+
+  for (int n=0;n<Nrhs;n++) {
+    occa::memory o_rn   = Column(o_r, stride, n);
+    occa::memory o_RESn = Column(o_RES, stride, n);
+    occa::memory o_dn   = Column(o_d, stride, n);
+
+    if(xIsZero){
+      linAlg.amxpy(elliptic.Ndofs, 1.0, o_invDiagA, o_rn, 0.f, o_RESn);
+    } else {
+      linAlg.axpy(elliptic.Ndofs, 1.f, o_rn, -1.f, o_RESn);
+      linAlg.amx(elliptic.Ndofs, 1.f, o_invDiagA, o_RESn);
+    }
+
+    //d = invTheta*res
+    linAlg.axpy(elliptic.Ndofs, invTheta, o_RESn, 0.f, o_dn);
+  }
+
+  for (int k=0;k<ChebyshevIterations;k++) {
+    //x_k+1 = x_k + d_k
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_dn = Column(o_d, stride, n);
+      occa::memory o_Xn = Column(o_X, stride, n);
+      if (xIsZero&&(k==0))
+        linAlg.axpy(elliptic.Ndofs, 1.f, o_dn, 0.f, o_Xn);
+      else
+        linAlg.axpy(elliptic.Ndofs, 1.f, o_dn, 1.f, o_Xn);
+    }
+
+    //r_k+1 = r_k - SAd_k
+    elliptic.BlockOperator(Nrhs, stride, o_d, o_Ad);
+
+    rho_np1 = 1.0/(2.*sigma-rho_n);
+    dfloat rhoDivDelta = 2.0*rho_np1/delta;
+
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_Adn  = Column(o_Ad, stride, n);
+      occa::memory o_RESn = Column(o_RES, stride, n);
+      occa::memory o_dn   = Column(o_d, stride, n);
+      linAlg.amxpy(elliptic.Ndofs, -1.f, o_invDiagA, o_Adn, 1.f, o_RESn);
+
+      //d_k+1 = rho_k+1*rho_k*d_k  + 2*rho_k+1*r_k+1/delta
+      linAlg.axpy(elliptic.Ndofs, rhoDivDelta, o_RESn, rho_np1*rho_n, o_dn);
+    }
+
+    rho_n = rho_np1;
+  }
+
+  //x_k+1 = x_k + d_k
+  for (int n=0;n<Nrhs;n++) {
+    occa::memory o_dn = Column(o_d, stride, n);
+    occa::memory o_Xn = Column(o_X, stride, n);
+    linAlg.axpy(elliptic.Ndofs, 1.f, o_dn, 1.0, o_Xn);
+  }
+}
+
 
 /******************************************
 *
@@ -194,6 +322,10 @@ occa::memory MGLevel::o_smootherResidual;
 occa::memory MGLevel::o_smootherResidual2;
 occa::memory MGLevel::o_smootherUpdate;
 occa::memory MGLevel::o_transferScratch;
+size_t  MGLevel::blockSmootherBytes=0;
+occa::memory MGLevel::o_blockSmootherResidual;
+occa::memory MGLevel::o_blockSmootherResidual2;
+occa::memory MGLevel::o_blockSmootherUpdate;
 
 //build a level and connect it to the next one
 MGLevel::MGLevel(elliptic_t& _elliptic,
@@ -301,6 +433,26 @@ void MGLevel::AllocateStorage() {
   }
 }
 
+// storage for the blocked smoothers, shared by all levels and allocated
+// on first use
+void MGLevel::AllocateBlockStorage(const int Nrhs, const dlong stride) {
+  const size_t Nbytes = Nrhs*stride*sizeof(dfloat);
+  if (blockSmootherBytes < Nbytes) {
+    if (o_blockSmootherResidual.size()) {
+      o_blockSmootherResidual.free();
+      o_blockSmootherResidual2.free();
+      o_blockSmootherUpdate.free();
+    }
+
+    dfloat *dummy = (dfloat *) calloc(Nrhs*stride,sizeof(dfloat));
+    o_blockSmootherResidual  = elliptic.platform.malloc(Nbytes,dummy);
+    o_blockSmootherResidual2 = elliptic.platform.malloc(Nbytes,dummy);
+    o_blockSmootherUpdate    = elliptic.platform.malloc(Nbytes,dummy);
+    free(dummy);
+    blockSmootherBytes = Nbytes;
+  }
+}
+
 void MGLevel::Report() {
 
   hlong hNrows = (hlong) Nrows;
@@ -36,6 +36,21 @@ void ParAlmondPrecon::Operator(occa::memory& o_r, occa::memory& o_Mr) {
   if(elliptic.allNeumann) elliptic.ZeroMean(o_Mr);
 }
 
+// One AMG cycle for all right-hand sides
+void ParAlmondPrecon::BlockOperator(const int Nrhs, const dlong stride,
+                                    occa::memory& o_r, occa::memory& o_Mr) {
+
+  parAlmond.BlockOperator(Nrhs, stride, o_r, o_Mr);
+
+  // zero mean of RHS
+  if(elliptic.allNeumann) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_Mrn = o_Mr + n*stride*sizeof(dfloat);
+      elliptic.ZeroMean(o_Mrn);
+    }
+  }
+}
+
 ParAlmondPrecon::ParAlmondPrecon(elliptic_t& _elliptic):
   elliptic(_elliptic), settings(_elliptic.settings),
   parAlmond(elliptic.platform, settings, elliptic.mesh.comm) {
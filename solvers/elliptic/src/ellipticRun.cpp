@@ -35,8 +35,19 @@ void elliptic_t::Run(){
   } else {
     NglobalDofs = mesh.NelementsGlobal*mesh.Np*Nfields;
   }
-  linearSolver_t *linearSolver = linearSolver_t::Setup(Ndofs, Nhalo,
-                                                       platform, settings, mesh.comm);
+  int Nrhs = 1;
+  settings.getSetting("RIGHT HAND SIDES", Nrhs);
+  if (Nrhs<1)
+    LIBP_ABORT(string("RIGHT HAND SIDES must be at least 1"))
+
+  linearSolver_t *linearSolver = NULL;
+  blockLinearSolver_t *blockSolver = NULL;
+  if (Nrhs==1)
+    linearSolver = linearSolver_t::Setup(Ndofs, Nhalo,
+                                         platform, settings, mesh.comm);
+  else
+    blockSolver = blockLinearSolver_t::Setup(Ndofs, Nhalo, Nrhs,
+                                             platform, settings, mesh.comm);
 
   occa::properties kernelInfo = mesh.props; //copy base occa properties
 
@@ -172,6 +183,25 @@ void elliptic_t::Run(){
     ogsMasked->Gather(o_x, o_xL, ogs_dfloat, ogs_add, ogs_notrans);
   }
 
+  //block rhs: the original rhs followed by Nrhs-1 random right-hand
+  // sides, one column of Ndofs+Nhalo entries each
+  occa::memory o_R, o_X;
+  if (Nrhs>1) {
+    const dlong Ncol = Ndofs+Nhalo;
+    dfloat *R = (dfloat*) calloc(Nrhs*Ncol, sizeof(dfloat));
+    o_r.copyTo(R, Ndofs*sizeof(dfloat));
+    srand48(mesh.rank+1);
+    for (int n=1;n<Nrhs;n++) {
+      for (dlong i=0;i<Ndofs;i++) {
+        R[n*Ncol+i] = (dfloat) drand48();
+      }
+    }
+    dfloat *X = (dfloat*) calloc(Nrhs*Ncol, sizeof(dfloat));
+    o_R = platform.malloc(Nrhs*Ncol*sizeof(dfloat), R);
+    o_X = platform.malloc(Nrhs*Ncol*sizeof(dfloat), X);
+    free(R); free(X);
+  }
+
   int maxIter = 5000;
   int verbose = settings.compareSetting("VERBOSE", "TRUE") ? 1 : 0;
 
@@ -180,7 +210,15 @@ void elliptic_t::Run(){
 
   //call the solver
   dfloat tol = 1e-8;
-  int iter = Solve(*linearSolver, o_x, o_r, tol, maxIter, verbose);
+  int iter;
+  if (Nrhs==1) {
+    iter = Solve(*linearSolver, o_x, o_r, tol, maxIter, verbose);
+  } else {
+    iter = BlockSolve(*blockSolver, Nrhs, o_X, o_R, tol, maxIter, verbose);
+
+    //the first column holds the solution for the original rhs
+    o_x.copyFrom(o_X, Ndofs*sizeof(dfloat));
+  }
 
 
   //add the boundary data to the masked nodes
@@ -241,5 +279,9 @@ void elliptic_t::Run(){
   o_rL.free(); o_xL.free();
   o_r.free(); o_x.free();
   o_MxL.free();
-  delete linearSolver;
+  if (Nrhs>1) {
+    o_R.free(); o_X.free();
+  }
+  if (linearSolver) delete linearSolver;
+  if (blockSolver) delete blockSolver;
 }
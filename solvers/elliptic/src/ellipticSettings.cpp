@@ -45,6 +45,10 @@ void ellipticAddRunSettings(settings_t& settings) {
                       "1.0",
                       "Coefficient in Screened Poisson Equation");
 
+  settings.newSetting("RIGHT HAND SIDES",
+                      "1",
+                      "Number of right-hand sides solved together by the block linear solver. The first is the problem's right-hand side, the others are random");
+
   settings.newSetting("OUTPUT TO FILE",
                       "FALSE",
                       "Flag for writing fields to VTU files",
@@ -107,6 +111,8 @@ void ellipticSettings_t::report() {
     reportSetting("DATA FILE");
 
     reportSetting("LAMBDA");
+    if (!compareSetting("RIGHT HAND SIDES","1"))
+      reportSetting("RIGHT HAND SIDES");
     reportSetting("DISCRETIZATION");
     reportSetting("LINEAR SOLVER");
     reportSetting("PRECONDITIONER");
@@ -171,9 +171,59 @@ elliptic_t& elliptic_t::Setup(platform_t& platform, mesh_t& mesh,
   return *elliptic;
 }
 
+//build the blocked Ax kernel for up to Nrhs right-hand sides
+void elliptic_t::BlockSetup(const int Nrhs){
+
+  NblockRhs = Nrhs;
+
+  if (partialBlockAxKernel.isInitialized()) partialBlockAxKernel.free();
+  if (o_AqLBlock.isInitialized()) o_AqLBlock.free();
+
+  //blocked kernels exist for the continuous 2D and 3D element types.
+  // Otherwise BlockOperator applies the operator one column at a time.
+  if (!disc_c0) return;
+  if (mesh.dim==3 && (mesh.elementType==TRIANGLES ||
+                      mesh.elementType==QUADRILATERALS)) return;
+  if (mesh.elementType==HEXAHEDRA &&
+      mesh.settings.compareSetting("ELEMENT MAP", "TRILINEAR")) return;
+
+  //buffer for local Ax of every right-hand side
+  dlong Ntotal = mesh.Np*mesh.Nelements;
+  o_AqLBlock = platform.malloc(Nrhs*Ntotal*sizeof(dfloat));
+
+  occa::properties kernelInfo = mesh.props; //copy base occa properties
+
+  // set kernel name suffix
+  char *suffix;
+  if(mesh.elementType==TRIANGLES)
+    suffix = strdup("Tri2D");
+  else if(mesh.elementType==QUADRILATERALS)
+    suffix = strdup("Quad2D");
+  else if(mesh.elementType==TETRAHEDRA)
+    suffix = strdup("Tet3D");
+  else
+    suffix = strdup("Hex3D");
+
+  int blockMax = 256;
+  if (platform.device.mode() == "CUDA") blockMax = 512;
+
+  int NblockV = mymax(1,blockMax/(mesh.Np*Nrhs));
+  kernelInfo["defines/" "p_NblockV"]= NblockV;
+  kernelInfo["defines/" "p_Nrhs"]= Nrhs;
+
+  char fileName[BUFSIZ], kernelName[BUFSIZ];
+  sprintf(fileName,  DELLIPTIC "/okl/ellipticBlockAx%s.okl", suffix);
+  sprintf(kernelName, "ellipticPartialBlockAx%s", suffix);
+
+  partialBlockAxKernel = platform.buildKernel(fileName, kernelName,
+                                              kernelInfo);
+  free(suffix);
+}
+
 elliptic_t::~elliptic_t() {
   maskKernel.free();
   partialAxKernel.free();
+  partialBlockAxKernel.free();
   partialGradientKernel.free();
   partialIpdgKernel.free();
 
@@ -37,3 +37,23 @@ int elliptic_t::Solve(linearSolver_t& linearSolver,
 
   return Niter;
 }
+
+int elliptic_t::BlockSolve(blockLinearSolver_t& linearSolver, const int Nrhs,
+                           occa::memory &o_x, occa::memory &o_r,
+                           const dfloat tol, const int MAXIT, const int verbose){
+
+  //build the blocked operator for this many right-hand sides
+  if (Nrhs>NblockRhs) BlockSetup(linearSolver.maxNrhs);
+
+  // if there is a nullspace, remove the constant vector from each r
+  if(allNeumann) {
+    for (int n=0;n<Nrhs;n++) {
+      occa::memory o_rn = o_r + n*(Ndofs+Nhalo)*sizeof(dfloat);
+      ZeroMean(o_rn);
+    }
+  }
+
+  int Niter = linearSolver.Solve(*this, *precon, Nrhs, o_x, o_r, tol, MAXIT, verbose);
+
+  return Niter;
+}
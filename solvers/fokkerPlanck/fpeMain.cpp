@@ -57,9 +57,15 @@ int main(int argc, char **argv){
   // set up fpe solver
   fpe_t& fpe = fpe_t::Setup(platform, mesh, fpeSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   fpe.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
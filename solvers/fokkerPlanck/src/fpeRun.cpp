@@ -55,6 +55,10 @@ void fpe_t::Run(){
   } else if (settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
     dt = Nsubcycles*dtAdvc;
     subStepper->SetTimeStep(dtAdvc);
+  } else if (settings.compareSetting("TIME INTEGRATOR","ARK3")
+           ||settings.compareSetting("TIME INTEGRATOR","ARK4")) {
+    //diffusion is implicit, initial step is adapted by the error controller
+    dt = dtAdvc;
   } else {
     dt = mymin(dtAdvc, dtDiff);
   }
@@ -46,7 +46,7 @@ fpeSettings_t::fpeSettings_t(MPI_Comm& _comm):
   newSetting("TIME INTEGRATOR",
              "DOPRI5",
              "Time integration method",
-             {"AB3", "DOPRI5", "LSERK4", "EXTBDF3", "SSBDF3"});
+             {"AB3", "DOPRI5", "LSERK4", "EXTBDF3", "SSBDF3", "ARK3", "ARK4"});
 
   newSetting("CFL NUMBER",
              "1.0",
@@ -63,6 +63,14 @@ fpe_t& fpe_t::Setup(platform_t& platform, mesh_t& mesh,
     fpe->timeStepper = new TimeStepper::ssbdf3(mesh.Nelements, mesh.totalHaloPairs,
                                               mesh.Np, 1, *fpe);
     gamma = ((TimeStepper::ssbdf3*) fpe->timeStepper)->getGamma();
+  } else if (settings.compareSetting("TIME INTEGRATOR","ARK3")){
+    fpe->timeStepper = new TimeStepper::ark3(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, 1, *fpe, mesh.comm);
+    gamma = ((TimeStepper::ark3*) fpe->timeStepper)->getGamma();
+  } else if (settings.compareSetting("TIME INTEGRATOR","ARK4")){
+    fpe->timeStepper = new TimeStepper::ark4(mesh.Nelements, mesh.totalHaloPairs,
+                                              mesh.Np, 1, *fpe, mesh.comm);
+    gamma = ((TimeStepper::ark4*) fpe->timeStepper)->getGamma();
   }
 
   fpe->Nsubcycles=1;
@@ -73,7 +81,9 @@ fpe_t& fpe_t::Setup(platform_t& platform, mesh_t& mesh,
   fpe->elliptic=NULL;
   fpe->linearSolver=NULL;
   if (settings.compareSetting("TIME INTEGRATOR","EXTBDF3")
-    ||settings.compareSetting("TIME INTEGRATOR","SSBDF3")){
+    ||settings.compareSetting("TIME INTEGRATOR","SSBDF3")
+    ||settings.compareSetting("TIME INTEGRATOR","ARK3")
+    ||settings.compareSetting("TIME INTEGRATOR","ARK4")){
 
     int NBCTypes = 7;
     int BCType[NBCTypes] = {0,1,1,2,1,1,1}; // bc=3 => outflow => Neumann   => vBCType[3] = 2, etc.
@@ -104,7 +114,7 @@ fpe_t& fpe_t::Setup(platform_t& platform, mesh_t& mesh,
   }
 
   //setup linear algebra module
-  platform.linAlg.InitKernels({"innerProd", "axpy", "max"});
+  platform.linAlg.InitKernels({"innerProd", "axpy", "max", "set"});
 
   /*setup trace halo exchange */
   fpe->traceHalo = mesh.HaloTraceSetup(1); //one field
@@ -192,12 +202,18 @@ fpe_t& fpe_t::Setup(platform_t& platform, mesh_t& mesh,
 
   // diffusion kernels
   if (settings.compareSetting("TIME INTEGRATOR","EXTBDF3")
-    ||settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
+    ||settings.compareSetting("TIME INTEGRATOR","SSBDF3")
+    ||settings.compareSetting("TIME INTEGRATOR","ARK3")
+    ||settings.compareSetting("TIME INTEGRATOR","ARK4")) {
     sprintf(fileName, DFPE "/okl/fpeDiffusionRhs%s.okl", suffix);
     sprintf(kernelName, "fpeDiffusionRhs%s", suffix);
     fpe->diffusionRhsKernel =  platform.buildKernel(fileName, kernelName,
                                            kernelInfo);
-  } else {
+  }
+
+  //IMEX Runge-Kutta evaluates the diffusion operator explicitly at the first stage
+  if (!settings.compareSetting("TIME INTEGRATOR","EXTBDF3")
+    &&!settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
     // gradient kernel
     sprintf(fileName, DFPE "/okl/fpeGradient%s.okl", suffix);
     sprintf(kernelName, "fpeGradient%s", suffix);
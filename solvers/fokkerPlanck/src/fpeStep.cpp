@@ -28,8 +28,8 @@ SOFTWARE.
 
 dfloat fpe_t::MaxWaveSpeed(occa::memory& o_Q, const dfloat T){
 
-  //Note: if this is on the critical path in the future, we should pre-allocate this
-  occa::memory o_maxSpeed = platform.malloc(mesh.Nelements*sizeof(dfloat));
+  //transient buffer from the platform pool
+  occa::memory o_maxSpeed = platform.reserve(mesh.Nelements*sizeof(dfloat));
 
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_vgeo,
@@ -45,7 +45,7 @@ dfloat fpe_t::MaxWaveSpeed(occa::memory& o_Q, const dfloat T){
 
   const dfloat vmax = platform.linAlg.max(mesh.Nelements, o_maxSpeed, mesh.comm);
 
-  o_maxSpeed.free();
+  platform.release(o_maxSpeed);
   return vmax;
 }
 
@@ -62,6 +62,8 @@ void fpe_t::rhs_imex_f(occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
 
 // Evaluation of rhs g function
 void fpe_t::rhs_imex_g(occa::memory& o_Q, occa::memory& o_RHS, const dfloat T){
+  //Diffusion accumulates into RHS
+  platform.linAlg.set(mesh.Nelements*mesh.Np, 0.0, o_RHS);
   Diffusion(o_Q, o_RHS, T);
 }
 
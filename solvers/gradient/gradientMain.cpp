@@ -58,9 +58,15 @@ int main(int argc, char **argv){
   // set up gradient solver
   gradient_t& gradient = gradient_t::Setup(platform, mesh, gradientSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   gradient.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
@@ -61,13 +61,15 @@ public:
   occa::kernel advectionVolumeKernel;
   occa::kernel advectionSurfaceKernel;
 
-  occa::kernel subCycleAdvectionKernel;
+  occa::kernel subCycleCoefficientsKernel;
+  occa::kernel subCycleInterpolateKernel;
 
   int NVfields;
-  int order, maxOrder, shiftIndex;
+  int order;
   dfloat nu, T0, dt;
 
-  occa::memory o_Ue, o_Uh;
+  //advecting velocity, and the coefficients of its interpolant in time
+  occa::memory o_Ue, o_Uc;
 
   subcycler_t() = delete;
   subcycler_t(ins_t& ins);
@@ -76,6 +78,9 @@ public:
 
   void Report(dfloat time, int tstep){};
 
+  void SetupVelocity(occa::memory& o_Uh, const dfloat T, const dfloat dt,
+                     const int order, const int shiftIndex, const int maxOrder);
+
   void rhsf(occa::memory& o_q, occa::memory& o_rhs, const dfloat time);
 };
 
@@ -57,9 +57,15 @@ int main(int argc, char **argv){
   // set up ins solver
   ins_t& ins = ins_t::Setup(platform, mesh, insSettings);
 
+  // drop host copies of device-resident mesh data if requested
+  mesh.ReleaseHostMirrors();
+
   // run
   ins.Run();
 
+  // report the device memory footprint
+  platform.MemoryReport();
+
   // close down MPI
   MPI_Finalize();
   return LIBP_SUCCESS;
@@ -62,8 +62,8 @@ void ins_t::Advection(const dfloat alpha, occa::memory& o_U,
                           mesh.o_cubsgeo,
                           mesh.o_intInterp,
                           mesh.o_intLIFT,
-                          mesh.o_vmapM,
-                          mesh.o_vmapP,
+                          mesh.o_traceM,
+                          mesh.o_traceP,
                           mesh.o_EToB,
                           T,
                           mesh.o_intx,
@@ -77,8 +77,8 @@ void ins_t::Advection(const dfloat alpha, occa::memory& o_U,
     advectionSurfaceKernel(mesh.Nelements,
                           mesh.o_sgeo,
                           mesh.o_LIFT,
-                          mesh.o_vmapM,
-                          mesh.o_vmapP,
+                          mesh.o_traceM,
+                          mesh.o_traceP,
                           mesh.o_EToB,
                           T,
                           mesh.o_x,
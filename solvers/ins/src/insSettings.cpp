@@ -93,6 +93,12 @@ insSettings_t::insSettings_t(MPI_Comm& _comm):
   ellipticAddSettings(*this, "PRESSURE ");
   parAlmond::AddSettings(*this, "PRESSURE ");
   initialGuessAddSettings(*this, "PRESSURE ");
+
+  //default to adaptive projection initial guesses for all INS solves
+  changeSetting("VELOCITY INITIAL GUESS STRATEGY", "ADAPTIVE");
+  changeSetting("VELOCITY INITIAL GUESS HISTORY SPACE DIMENSION", "8");
+  changeSetting("PRESSURE INITIAL GUESS STRATEGY", "ADAPTIVE");
+  changeSetting("PRESSURE INITIAL GUESS HISTORY SPACE DIMENSION", "8");
 }
 
 void insSettings_t::report() {
@@ -125,6 +131,8 @@ void insSettings_t::report() {
     reportSetting("VELOCITY LINEAR SOLVER");
     reportSetting("VELOCITY INITIAL GUESS STRATEGY");
     reportSetting("VELOCITY INITIAL GUESS HISTORY SPACE DIMENSION");
+    if (compareSetting("VELOCITY INITIAL GUESS STRATEGY","ADAPTIVE"))
+      reportSetting("VELOCITY INITIAL GUESS BASIS PRECISION");
     reportSetting("VELOCITY PRECONDITIONER");
 
     if (compareSetting("VELOCITY PRECONDITIONER","MULTIGRID")) {
@@ -147,6 +155,8 @@ void insSettings_t::report() {
     reportSetting("PRESSURE LINEAR SOLVER");
     reportSetting("PRESSURE INITIAL GUESS STRATEGY");
     reportSetting("PRESSURE INITIAL GUESS HISTORY SPACE DIMENSION");
+    if (compareSetting("PRESSURE INITIAL GUESS STRATEGY","ADAPTIVE"))
+      reportSetting("PRESSURE INITIAL GUESS BASIS PRECISION");
     reportSetting("PRESSURE PRECONDITIONER");
 
     if (compareSetting("PRESSURE PRECONDITIONER","MULTIGRID")) {
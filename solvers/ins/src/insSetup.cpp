@@ -329,12 +329,18 @@ ins_t& ins_t::Setup(platform_t& platform, mesh_t& mesh,
     }
 
     sprintf(fileName, DINS "/okl/insSubcycleAdvection.okl");
-    sprintf(kernelName, "insSubcycleAdvectionKernel");
-    ins->subcycler->subCycleAdvectionKernel = platform.buildKernel(fileName, kernelName,
+    sprintf(kernelName, "insSubcycleAdvectionCoefficients");
+    ins->subcycler->subCycleCoefficientsKernel = platform.buildKernel(fileName, kernelName,
+                                             kernelInfo);
+    sprintf(kernelName, "insSubcycleAdvectionInterpolate");
+    ins->subcycler->subCycleInterpolateKernel = platform.buildKernel(fileName, kernelName,
                                              kernelInfo);
 
     ins->subcycler->o_Ue = platform.malloc((Nlocal+Nhalo)*ins->NVfields*sizeof(dfloat), ins->u);
 
+    //interpolant coefficients, one slot per history state
+    ins->subcycler->o_Uc = platform.malloc(3*(Nlocal+Nhalo)*ins->NVfields*sizeof(dfloat));
+
   } else {
     //regular advection kernels
     if (ins->cubature) {
@@ -482,7 +488,8 @@ ins_t::~ins_t() {
   if (wLinearSolver) delete wLinearSolver;
   if (subStepper) delete subStepper;
   if (subcycler) {
-    subcycler->subCycleAdvectionKernel.free();
+    subcycler->subCycleCoefficientsKernel.free();
+    subcycler->subCycleInterpolateKernel.free();
     delete subcycler;
   }
 
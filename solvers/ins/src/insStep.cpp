@@ -28,8 +28,8 @@ SOFTWARE.
 
 dfloat ins_t::MaxWaveSpeed(occa::memory& o_U, const dfloat T){
 
-  //Note: if this is on the critical path in the future, we should pre-allocate this
-  occa::memory o_maxSpeed = platform.malloc(mesh.Nelements*sizeof(dfloat));
+  //transient buffer from the platform pool
+  occa::memory o_maxSpeed = platform.reserve(mesh.Nelements*sizeof(dfloat));
 
   maxWaveSpeedKernel(mesh.Nelements,
                      mesh.o_vgeo,
@@ -46,7 +46,7 @@ dfloat ins_t::MaxWaveSpeed(occa::memory& o_U, const dfloat T){
 
   const dfloat vmax = platform.linAlg.max(mesh.Nelements, o_maxSpeed, mesh.comm);
 
-  o_maxSpeed.free();
+  platform.release(o_maxSpeed);
   return vmax;
 }
 
@@ -123,13 +123,8 @@ void ins_t::rhs_subcycle_f(occa::memory& o_U, occa::memory& o_UHAT,
   if (order>=3)
     LIBP_ABORT("Subcycling supports only order 3 interpolation for now.")
 
-  subcycler->order = order;
-  subcycler->maxOrder = maxOrder;
-  subcycler->shiftIndex = shiftIndex;
-  subcycler->T0 = T;
-  subcycler->dt = dt;
-
-  subcycler->o_Uh = o_U; //history
+  //the advecting velocity's interpolant serves every history state
+  subcycler->SetupVelocity(o_U, T, dt, order, shiftIndex, maxOrder);
 
   //At each iteration of n, we step the partial sum
   // sum_i=n^order B[i]*U(t-i*dt) from t-n*dt to t-(n-1)*dt
@@ -37,41 +37,43 @@ subcycler_t::subcycler_t(ins_t& ins):
   advectionSurfaceKernel = ins.advectionSurfaceKernel;
 }
 
+//interpolate the velocity history in time once per macro step. The
+// coefficients are exchanged here, so substeps need no Ue halo exchange
+void subcycler_t::SetupVelocity(occa::memory& o_Uh, const dfloat T, const dfloat _dt,
+                                const int _order, const int shiftIndex, const int maxOrder){
+
+  order = _order;
+  T0 = T;
+  dt = _dt;
+
+  const dlong fieldOffset = mesh.Nelements*mesh.Np*NVfields;
+  const dlong coeffOffset = (mesh.Nelements+mesh.totalHaloPairs)*mesh.Np*NVfields;
+
+  subCycleCoefficientsKernel(mesh.Nelements,
+                             shiftIndex,
+                             order,
+                             maxOrder,
+                             fieldOffset,
+                             coeffOffset,
+                             o_Uh,
+                             o_Uc);
+
+  for (int k=0;k<=order;k++) {
+    occa::memory o_Uck = o_Uc + k*coeffOffset*sizeof(dfloat);
+    vTraceHalo->Exchange(o_Uck, 1, ogs_dfloat);
+  }
+}
+
 //evaluate ODE rhs = f(q,t)
 void subcycler_t::rhsf(occa::memory& o_U, occa::memory& o_RHS, const dfloat T){
 
-  //interpolate velocity history for advective field (halo elements first)
-  if(mesh.NhaloElements)
-    subCycleAdvectionKernel(mesh.NhaloElements,
-                           mesh.o_haloElementIds,
-                           shiftIndex,
-                           order,
-                           maxOrder,
-                           mesh.Nelements*mesh.Np*NVfields,
-                           T,
-                           T0,
-                           dt,
-                           o_Uh,
-                           o_Ue);
-
-  // extract Ue halo
-  vTraceHalo->ExchangeStart(o_Ue, 1, ogs_dfloat);
-
-  if(mesh.NinternalElements)
-    subCycleAdvectionKernel(mesh.NinternalElements,
-                           mesh.o_internalElementIds,
-                           shiftIndex,
-                           order,
-                           maxOrder,
-                           mesh.Nelements*mesh.Np*NVfields,
-                           T,
-                           T0,
-                           dt,
-                           o_Uh,
-                           o_Ue);
-
-  // finish exchange of Ue
-  vTraceHalo->ExchangeFinish(o_Ue, 1, ogs_dfloat);
+  //advecting velocity at T, halo elements included
+  subCycleInterpolateKernel(mesh.Nelements+mesh.totalHaloPairs,
+                            order,
+                            (mesh.Nelements+mesh.totalHaloPairs)*mesh.Np*NVfields,
+                            (T-T0)/dt,
+                            o_Uc,
+                            o_Ue);
 
   // extract u halo on DEVICE
   vTraceHalo->ExchangeStart(o_U, 1, ogs_dfloat);
@@ -103,8 +105,8 @@ void subcycler_t::rhsf(occa::memory& o_U, occa::memory& o_RHS, const dfloat T){
                           mesh.o_cubsgeo,
                           mesh.o_intInterp,
                           mesh.o_intLIFT,
-                          mesh.o_vmapM,
-                          mesh.o_vmapP,
+                          mesh.o_traceM,
+                          mesh.o_traceP,
                           mesh.o_EToB,
                           T,
                           mesh.o_intx,
@@ -118,8 +120,8 @@ void subcycler_t::rhsf(occa::memory& o_U, occa::memory& o_RHS, const dfloat T){
     advectionSurfaceKernel(mesh.Nelements,
                           mesh.o_sgeo,
                           mesh.o_LIFT,
-                          mesh.o_vmapM,
-                          mesh.o_vmapP,
+                          mesh.o_traceM,
+                          mesh.o_traceP,
                           mesh.o_EToB,
                           T,
                           mesh.o_x,
@@ -59,6 +59,13 @@ insBin       = insDir           + "/insMain"
 inputRC = testDir + "/setup.rc"
 
 TOL = 1.0e-5
+
+#reference norms are from double precision runs, so a
+#single precision build is checked to a looser tolerance
+precision = os.environ.get("LIBP_PRECISION", "double")
+if precision!="double" and precision!="single":
+  exit("Invalid precision requested.")
+TOL_SINGLE = 1.0e-3
 alignWidth = 40
 
 numeric_const_pattern = r"[-+]? (?: (?: \d* \. \d+ ) | (?: \d+ \.? ) )(?: [Ee] [+-]? \d+ ) ?"
@@ -96,17 +103,42 @@ def writeSetup(settings):
   file.write(str_settings)
   file.close()
 
-def test(name, cmd, settings, referenceNorm, ranks=1):
+def runSolver(cmd, settings, ranks=1):
 
   #create input file
   writeSetup(settings)
 
+  run = subprocess.run(["mpirun", "--oversubscribe", "-np", str(ranks), cmd, inputRC],
+                        stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+
+  #clean up
+  os.remove(inputRC)
+
+  return run
+
+#solution norm of a run, used as the reference for runs which must reproduce it
+def solutionNorm(cmd, settings, ranks=1):
+
+  run = runSolver(cmd, settings, ranks)
+
+  lines = run.stdout.decode().splitlines()
+  if len(lines)==0 or "Solution norm = " not in lines[-1]:
+    return float("nan")
+
+  return float(lines[-1].split()[3])
+
+#output is a message required somewhere in the output. check optionally
+# inspects the whole output and returns a failure message, or None
+def test(name, cmd, settings, referenceNorm, ranks=1, tol=TOL, output=None, check=None):
+
   #print test name
   print(bcolors.TEST + f"{name:.<{alignWidth}}" + bcolors.ENDC, end="", flush=True)
 
+  if precision=="single":
+    tol = max(tol, TOL_SINGLE)
+
   #run test
-  run = subprocess.run(["mpirun", "--oversubscribe", "-np", str(ranks), cmd, inputRC],
-                        stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+  run = runSolver(cmd, settings, ranks)
 
   if len(run.stdout.decode().splitlines())==0:
     #this failure is bad, dump the whole output for debug
@@ -117,14 +149,26 @@ def test(name, cmd, settings, referenceNorm, ranks=1):
     print(run.stderr.decode())
     failed = 1
   else:
+    #optionally require a message somewhere in the output
+    expected = output
+
     #collect last line of output
     output = run.stdout.decode().splitlines()[-1]
 
     #check last line's syntax
     failed=0;
-    if "Solution norm = " in output:
+    checkFailure = check(run.stdout.decode()) if check is not None else None
+    if expected is not None and expected not in run.stdout.decode():
+      print(bcolors.FAIL + "FAIL" + bcolors.ENDC)
+      print(bcolors.WARNING + "Missing output: " + expected + bcolors.ENDC)
+      failed = 1
+    elif checkFailure is not None:
+      print(bcolors.FAIL + "FAIL" + bcolors.ENDC)
+      print(bcolors.WARNING + checkFailure + bcolors.ENDC)
+      failed = 1
+    elif "Solution norm = " in output:
       norm = float(output.split()[3])
-      if abs(norm - referenceNorm) < TOL:
+      if abs(norm - referenceNorm) < tol:
         print(bcolors.PASS + "PASS" + bcolors.ENDC)
       else:
         #failed residual check
@@ -141,9 +185,6 @@ def test(name, cmd, settings, referenceNorm, ranks=1):
       print(run.stderr.decode())
       failed = 1
 
-  #clean up
-  os.remove(inputRC)
-
   return failed
 
 if __name__ == "__main__":
@@ -27,14 +27,30 @@
 #####################################################################################
 
 from test import *
+import math
 
 data2D = acousticsDir + "/data/acousticsGaussian2D.h"
 data3D = acousticsDir + "/data/acousticsGaussian3D.h"
 
+#the multirate partition must lower the work imbalance it reports
+def multiratePartitionImproves(stdout):
+  for line in stdout.splitlines():
+    if line.startswith("MultiRate partition: work imbalance"):
+      before = float(line.split()[4])
+      after  = float(line.split()[6])
+      if after < before:
+        return None
+      return "Work imbalance did not drop: " + line
+  return "Missing output: MultiRate partition"
+
 def acousticsSettings(rcformat="2.0", data_file=data2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=-1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                       time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
+                      multirate_partition="FALSE", fused_kernels="FALSE",
+                      sponge_damping=0.0, sponge_width=0.0,
+                      parallel_in_time="NONE", time_slices=1, coarse_degree=1,
+                      geometric_factor_precision="DFLOAT",
                       output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
@@ -50,6 +66,14 @@ def acousticsSettings(rcformat="2.0", data_file=data2D,
           setting_t("PLATFORM NUMBER", platform_number),
           setting_t("DEVICE NUMBER", device_number),
           setting_t("TIME INTEGRATOR", time_integrator),
+          setting_t("MULTIRATE PARTITION", multirate_partition),
+          setting_t("FUSED KERNELS", fused_kernels),
+          setting_t("SPONGE DAMPING", sponge_damping),
+          setting_t("SPONGE WIDTH", sponge_width),
+          setting_t("PARALLEL IN TIME", parallel_in_time),
+          setting_t("TIME SLICES", time_slices),
+          setting_t("COARSE POLYNOMIAL DEGREE", coarse_degree),
+          setting_t("GEOMETRIC FACTOR PRECISION", geometric_factor_precision),
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
@@ -80,11 +104,147 @@ def main():
                                                degree=2),
                     referenceNorm=31.6576028812776)
 
+  #float geometric factors perturb the operators at float round-off
+  failCount += test(name="testAcousticsQuad_floatGeo",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               geometric_factor_precision="FLOAT"),
+                    referenceNorm=10.1299609797959, tol=1e-4)
+
+  failCount += test(name="testAcousticsHex_floatGeo",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=12,data_file=data3D,dim=3,
+                                               degree=2, geometric_factor_precision="FLOAT"),
+                    referenceNorm=31.6576028812776, tol=1e-4)
+
   failCount += test(name="testAcousticsTri_MPI", ranks=4,
                     cmd=acousticsBin,
                     settings=acousticsSettings(element=3,data_file=data2D,dim=2,output_to_file="TRUE"),
                     referenceNorm=10.1300558638317)
 
+  #fused kernels must reproduce the unfused norms
+  failCount += test(name="testAcousticsTri_fused",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=10.1302322430996)
+
+  failCount += test(name="testAcousticsQuad_fused",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=10.1299609797959)
+
+  failCount += test(name="testAcousticsTet_fused",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=6,data_file=data3D,dim=3,degree=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=31.6577046152384)
+
+  failCount += test(name="testAcousticsHex_fused",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=12,data_file=data3D,dim=3,degree=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=31.6576028812776)
+
+  failCount += test(name="testAcousticsTri_fused_MPI", ranks=4,
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=10.1300558638317)
+
+  #a uniform box has a single multirate level, so MRAB3 must match AB3
+  failCount += test(name="testAcousticsQuad_MRAB3",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               time_integrator="MRAB3"),
+                    referenceNorm=solutionNorm(acousticsBin,
+                                               acousticsSettings(element=4,data_file=data2D,dim=2,
+                                                                 time_integrator="AB3")))
+
+  #the graded mesh has three multirate levels, refined towards x=-1, so
+  # check the level coupling against a single rate integrator
+  failCount += test(name="testAcousticsQuad_MRAB3_graded",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               mesh=testDir+"/gradedQuad.msh",
+                                               time_integrator="MRAB3"),
+                    referenceNorm=solutionNorm(acousticsBin,
+                                               acousticsSettings(element=4,data_file=data2D,dim=2,
+                                                                 mesh=testDir+"/gradedQuad.msh",
+                                                                 time_integrator="DOPRI5")),
+                    tol=1.0e-3, output="|     2 |")
+
+  #the fine levels sit on a few ranks of the initial partition, balancing
+  # every level must lower the work imbalance and keep the solution
+  failCount += test(name="testAcousticsQuad_MRAB3_graded_partition_MPI", ranks=4,
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               mesh=testDir+"/gradedQuad.msh",
+                                               time_integrator="MRAB3",
+                                               multirate_partition="TRUE"),
+                    referenceNorm=solutionNorm(acousticsBin,
+                                               acousticsSettings(element=4,data_file=data2D,dim=2,
+                                                                 mesh=testDir+"/gradedQuad.msh",
+                                                                 time_integrator="MRAB3"),
+                                               ranks=4),
+                    tol=1.0e-4, check=multiratePartitionImproves)
+
+  failCount += test(name="testAcousticsTri_MRAB3_partition_MPI", ranks=4,
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                               time_integrator="MRAB3",
+                                               multirate_partition="TRUE"),
+                    referenceNorm=solutionNorm(acousticsBin,
+                                               acousticsSettings(element=3,data_file=data2D,dim=2,
+                                                                 time_integrator="AB3"),
+                                               ranks=4))
+
+  #an absorbing layer covering the whole box damps every field uniformly, so
+  # the semi-analytic steppers must return exp(-sigma*T) times the undamped norm
+  failCount += test(name="testAcousticsTri_SARK5_sponge",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                               time_integrator="SARK5",
+                                               sponge_damping=1.0, sponge_width=10.0),
+                    referenceNorm=math.exp(-1.0)*10.1302322430996, tol=1.0e-4)
+
+  failCount += test(name="testAcousticsQuad_SAAB3_sponge",
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               time_integrator="SAAB3",
+                                               sponge_damping=1.0, sponge_width=10.0),
+                    referenceNorm=math.exp(-1.0)*solutionNorm(acousticsBin,
+                                               acousticsSettings(element=4,data_file=data2D,dim=2,
+                                                                 time_integrator="AB3")),
+                    tol=1.0e-4)
+
+  #parareal converges to the fine propagator, here run on 2 time slices
+  # of 2 space ranks each, with a degree 1 coarse propagator, and compared
+  # with a serial-in-time 2 rank run
+  failCount += test(name="testAcousticsTri_parareal_MPI", ranks=4,
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=3,data_file=data2D,dim=2,
+                                               time_integrator="LSERK4",
+                                               parallel_in_time="PARAREAL", time_slices=2),
+                    referenceNorm=solutionNorm(acousticsBin,
+                                               acousticsSettings(element=3,data_file=data2D,dim=2,
+                                                                 time_integrator="LSERK4"),
+                                               ranks=2),
+                    tol=1.0e-4, output="Parallel-in-time:")
+
+  failCount += test(name="testAcousticsQuad_parareal_MPI", ranks=4,
+                    cmd=acousticsBin,
+                    settings=acousticsSettings(element=4,data_file=data2D,dim=2,
+                                               time_integrator="LSERK4",
+                                               parallel_in_time="PARAREAL", time_slices=4,
+                                               coarse_degree=2),
+                    referenceNorm=solutionNorm(acousticsBin,
+                                               acousticsSettings(element=4,data_file=data2D,dim=2,
+                                                                 time_integrator="LSERK4"),
+                                               ranks=1),
+                    tol=1.0e-4, output="Parallel-in-time:")
+
   #clean up
   for file_name in os.listdir(testDir):
     if file_name.endswith('.vtu'):
@@ -35,6 +35,9 @@ def advectionSettings(rcformat="2.0", data_file=advectionData2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=-1,
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                       time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
+                      multirate_partition="FALSE", fused_kernels="FALSE",
+                      ensemble_members=1, device_step_controller="FALSE",
+                      trace_connectivity="NODAL", accumulation_precision="DFLOAT",
                       output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
@@ -50,6 +53,12 @@ def advectionSettings(rcformat="2.0", data_file=advectionData2D,
           setting_t("PLATFORM NUMBER", platform_number),
           setting_t("DEVICE NUMBER", device_number),
           setting_t("TIME INTEGRATOR", time_integrator),
+          setting_t("MULTIRATE PARTITION", multirate_partition),
+          setting_t("FUSED KERNELS", fused_kernels),
+          setting_t("ENSEMBLE MEMBERS", ensemble_members),
+          setting_t("DEVICE STEP CONTROLLER", device_step_controller),
+          setting_t("TRACE CONNECTIVITY", trace_connectivity),
+          setting_t("ACCUMULATION PRECISION", accumulation_precision),
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
@@ -83,6 +92,96 @@ def main():
                     settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,output_to_file="TRUE"),
                     referenceNorm=0.723627520020827)
 
+  #fused kernels must reproduce the unfused norms
+  failCount += test(name="testAdvectionTri_fused",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=0.723924419144375)
+
+  failCount += test(name="testAdvectionQuad_fused",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=0.722791610885232)
+
+  failCount += test(name="testAdvectionTet_fused",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=6,data_file=advectionData3D,dim=3,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=0.835495461081062)
+
+  failCount += test(name="testAdvectionHex_fused",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=12,data_file=advectionData3D,dim=3,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=0.833820360927384)
+
+  failCount += test(name="testAdvectionTri_fused_MPI", ranks=4,
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               fused_kernels="TRUE"),
+                    referenceNorm=0.723627520020827)
+
+  #compact trace connectivity must reproduce the nodal norms
+  failCount += test(name="testAdvectionQuad_compactTrace",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               trace_connectivity="COMPACT"),
+                    referenceNorm=0.722791610885232)
+
+  failCount += test(name="testAdvectionHex_compactTrace_fused",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=12,data_file=advectionData3D,dim=3,
+                                               fused_kernels="TRUE",
+                                               trace_connectivity="COMPACT"),
+                    referenceNorm=0.833820360927384)
+
+  #double accumulation of the stage updates, identical to dfloat in a double build
+  failCount += test(name="testAdvectionQuad_accumulateDouble",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               accumulation_precision="DOUBLE"),
+                    referenceNorm=0.722791610885232)
+
+  #four identical members, so the total norm is twice the single member norm
+  failCount += test(name="testAdvectionQuad_ensemble",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               ensemble_members=4),
+                    referenceNorm=2*0.722791610885232)
+
+  failCount += test(name="testAdvectionHex_ensemble",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=12,data_file=advectionData3D,dim=3,
+                                               ensemble_members=4),
+                    referenceNorm=2*0.833820360927384)
+
+  failCount += test(name="testAdvectionTri_ensemble_MPI", ranks=4,
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               ensemble_members=4),
+                    referenceNorm=2*0.723627520020827)
+
+  #a uniform box has a single multirate level, so MRAB3 must match AB3
+  failCount += test(name="testAdvectionQuad_MRAB3",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                               time_integrator="MRAB3"),
+                    referenceNorm=solutionNorm(advectionBin,
+                                               advectionSettings(element=4,data_file=advectionData2D,dim=2,
+                                                                 time_integrator="AB3")))
+
+  failCount += test(name="testAdvectionTri_MRAB3_partition_MPI", ranks=4,
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                               time_integrator="MRAB3",
+                                               multirate_partition="TRUE"),
+                    referenceNorm=solutionNorm(advectionBin,
+                                               advectionSettings(element=3,data_file=advectionData2D,dim=2,
+                                                                 time_integrator="AB3"),
+                                               ranks=4))
+
   #clean up
   for file_name in os.listdir(testDir):
     if file_name.endswith('.vtu'):
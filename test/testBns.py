@@ -37,8 +37,9 @@ def bnsSettings(rcformat="2.0", data_file=bnsData2D,
                viscosity=0.01, speed_of_sound=1.0,
                pml_order=4, pml_sigx=50, pml_sigy=50, pml_sigz=50,
                pml_type="COLLOCATION",
-               time_integrator="SARK4", cfl=1.0, start_time=0.0, final_time=0.1,
-               output_to_file="FALSE"):
+               time_integrator="SARK4", multirate_partition="FALSE",
+               cfl=1.0, start_time=0.0, final_time=0.1,
+               trace_connectivity="NODAL", output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -60,6 +61,8 @@ def bnsSettings(rcformat="2.0", data_file=bnsData2D,
           setting_t("PML SIGMAZ MAX", pml_sigz),
           setting_t("PML INTEGRATION", pml_type),
           setting_t("TIME INTEGRATOR", time_integrator),
+          setting_t("MULTIRATE PARTITION", multirate_partition),
+          setting_t("TRACE CONNECTIVITY", trace_connectivity),
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
@@ -112,6 +115,20 @@ def main():
                                          pml_type="CUBATURE"),
                     referenceNorm=52.4199503907978)
 
+  #compact trace connectivity must reproduce the nodal norms
+  failCount += test(name="testBnsQuad_compactTrace",
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=4,data_file=bnsData2D,dim=2,
+                                         trace_connectivity="COMPACT"),
+                    referenceNorm=14.2051862745618)
+
+  failCount += test(name="testBnsHex_pmlcub_compactTrace",
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=12,data_file=bnsData3D,dim=3, degree=2,
+                                         pml_type="CUBATURE",
+                                         trace_connectivity="COMPACT"),
+                    referenceNorm=52.4199503907978)
+
   failCount += test(name="testBnsTri_MPI", ranks=4,
                     cmd=bnsBin,
                     settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,output_to_file="TRUE"),
@@ -37,7 +37,7 @@ def cnsSettings(rcformat="2.0", data_file=cnsData2D,
                gamma=1.4, viscosity=0.01, isothermal="FALSE",
                advection_type="COLLOCATION",
                 time_integrator="DOPRI5", cfl=1.0, start_time=0.0, final_time=1.0,
-                output_to_file="FALSE"):
+                trace_connectivity="NODAL", output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -56,6 +56,7 @@ def cnsSettings(rcformat="2.0", data_file=cnsData2D,
           setting_t("ISOTHERMAL", isothermal),
           setting_t("ADVECTION TYPE", advection_type),
           setting_t("TIME INTEGRATOR", time_integrator),
+          setting_t("TRACE CONNECTIVITY", trace_connectivity),
           setting_t("CFL NUMBER", cfl),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
@@ -164,6 +165,22 @@ def main():
                                          nx=8, ny=8, nz=8, degree=2),
                     referenceNorm=31.6604814034179)
 
+  #compact trace connectivity must reproduce the nodal norms
+  failCount += test(name="testCnsQuad_compactTrace",
+                    cmd=cnsBin,
+                    settings=cnsSettings(element=4,data_file=cnsData2D,dim=2,
+                                         trace_connectivity="COMPACT"),
+                    referenceNorm=27.4598265040507)
+
+  failCount += test(name="testCnsHex_Isothermal_cub_compactTrace",
+                    cmd=cnsBin,
+                    settings=cnsSettings(element=12,data_file=cnsData3D,dim=3,
+                                         isothermal="TRUE",
+                                         advection_type="CUBATURE",
+                                         nx=8, ny=8, nz=8, degree=2,
+                                         trace_connectivity="COMPACT"),
+                    referenceNorm=31.6604814034179)
+
   failCount += test(name="testCnsTri_MPI", ranks=4,
                     cmd=cnsBin,
                     settings=cnsSettings(element=3,data_file=cnsData2D,dim=2, output_to_file="TRUE"),
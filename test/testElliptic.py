@@ -43,6 +43,9 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
                      paralmond_strength="SYMMETRIC",
                      paralmond_aggregation="UNSMOOTHED",
                      paralmond_smoother="CHEBYSHEV",
+                     right_hand_sides=1,
+                     geometric_factor_precision="DFLOAT",
+                     host_mirrors="KEEP",
                      output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
@@ -68,6 +71,9 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
           setting_t("PARALMOND STRENGTH", paralmond_strength),
           setting_t("PARALMOND AGGREGATION", paralmond_aggregation),
           setting_t("PARALMOND SMOOTHER", paralmond_smoother),
+          setting_t("RIGHT HAND SIDES", right_hand_sides),
+          setting_t("GEOMETRIC FACTOR PRECISION", geometric_factor_precision),
+          setting_t("HOST MIRRORS", host_mirrors),
           setting_t("OUTPUT TO FILE", "FALSE"),
           setting_t("VERBOSE", output_to_file)]
 
@@ -102,6 +108,19 @@ def main():
                     settings=ellipticSettings(element=4,data_file=ellipticData3D,mesh="sphereQuad.msh", dim=3, precon="NONE"),
                     referenceNorm=3.274235742251)
 
+  #float geometric factors perturb the operator at float round-off
+  failCount += test(name="testEllipticQuad_C0_floatGeo",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2, precon="NONE",
+                                              geometric_factor_precision="FLOAT"),
+                    referenceNorm=0.499999999969716, tol=1e-4)
+
+  failCount += test(name="testEllipticHex_C0_floatGeo",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, precon="NONE",
+                                              geometric_factor_precision="FLOAT"),
+                    referenceNorm=0.353553390458384, tol=1e-4)
+
 
   #C0 precons
   #tri
@@ -247,6 +266,24 @@ def main():
                                               boundary_flag=-1, Lambda=0.0),
                     referenceNorm=0.059540839002614)
 
+  # smallest periodic boxes, where the rendezvous node matching must agree
+  # with the single rank numbering
+  failCount += test(name="testEllipticQuad_C0_periodic_MPI", ranks=4,
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              nx=3, ny=3, boundary_flag=-1),
+                    referenceNorm=solutionNorm(ellipticBin,
+                                               ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                                                nx=3, ny=3, boundary_flag=-1)))
+
+  failCount += test(name="testEllipticHex_C0_periodic_MPI", ranks=4,
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              nx=3, ny=3, nz=3, boundary_flag=-1),
+                    referenceNorm=solutionNorm(ellipticBin,
+                                               ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                                                nx=3, ny=3, nz=3, boundary_flag=-1)))
+
   ################
   #IPDG tests
   ################
@@ -429,6 +466,60 @@ def main():
                                               precon="OAS"),
                     referenceNorm=0.500000001211135)
 
+  #OAS runs a multigrid patch solver and an AMG solve on the degree 1 level of the
+  #mesh hierarchy, which aliases the affine factors of the tet mesh. Host mirrors
+  #are released with the hierarchy levels in place
+  failCount += test(name="testEllipticTet_C0_Multigrid_OAS_MPI", ranks=4,
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=6,data_file=ellipticData3D,dim=3,
+                                              precon="OAS", host_mirrors="RELEASE"),
+                    referenceNorm=0.353553400508458)
+
+  failCount += test(name="testEllipticHex_C0_Multigrid_MPI", ranks=4,
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="MULTIGRID", host_mirrors="RELEASE"),
+                    referenceNorm=0.353553400508458)
+
+  #block solver tests, the first right-hand side is the single rhs problem
+  failCount += test(name="testEllipticTri_C0_Block",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", right_hand_sides=4),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testEllipticHex_C0_Block_Jacobi",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="JACOBI", right_hand_sides=4),
+                    referenceNorm=0.353553390458384)
+
+  failCount += test(name="testEllipticQuad_Ipdg_Block_PGMRES",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", discretization="IPDG",
+                                              linear_solver="PGMRES", right_hand_sides=3),
+                    referenceNorm=0.499999999969716)
+
+  failCount += test(name="testEllipticTri_C0_Block_Multigrid_MPI", ranks=4,
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="MULTIGRID", right_hand_sides=4),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testEllipticQuad_C0_Block_ParAlmond",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=4,data_file=ellipticData2D,dim=2,
+                                              precon="PARALMOND", right_hand_sides=4),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testEllipticHex_C0_Block_Multigrid_Jacobi",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3,
+                                              precon="MULTIGRID", multigrid_smoother="DAMPEDJACOBI",
+                                              right_hand_sides=3),
+                    referenceNorm=0.353553400508458)
+
   #clean up
   for file_name in os.listdir(testDir):
     if file_name.endswith('.vtu'):
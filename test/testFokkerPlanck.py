@@ -186,6 +186,28 @@ def main():
                                          advection_type="CUBATURE"),
                     referenceNorm=0.390359551549932)
 
+  #IMEX additive Runge-Kutta, against a small step EXTBDF3 run
+  failCount += test(name="testFpeHex_ark4",
+                    cmd=fpeBin,
+                    settings=fpeSettings(element=12,data_file=fpeData3D,dim=3,
+                                         nx=6, ny=6, nz=6, degree=2,
+                                         time_integrator="ARK4"),
+                    referenceNorm=solutionNorm(fpeBin,
+                                               fpeSettings(element=12,data_file=fpeData3D,dim=3,
+                                                           nx=6, ny=6, nz=6, degree=2,
+                                                           time_integrator="EXTBDF3", cfl=0.1)),
+                    tol=1.0e-4)
+
+  failCount += test(name="testFpeQuad_ark3_MPI", ranks=4,
+                    cmd=fpeBin,
+                    settings=fpeSettings(element=4,data_file=fpeData2D,dim=2,
+                                         time_integrator="ARK3"),
+                    referenceNorm=solutionNorm(fpeBin,
+                                               fpeSettings(element=4,data_file=fpeData2D,dim=2,
+                                                           time_integrator="EXTBDF3", cfl=0.1),
+                                               ranks=4),
+                    tol=1.0e-4)
+
   #test MPI
   failCount += test(name="testFpeTri_MPI", ranks=4,
                     cmd=fpeBin,
@@ -33,6 +33,7 @@ gradientData3D = gradientDir + "/data/gradientCos3D.h"
 
 def gradientSettings(rcformat="2.0", data_file=gradientData2D,
                      mesh="BOX", dim=2, element=4, nx=10, ny=10, nz=10, boundary_flag=1,
+                     partitioner="GEOMETRIC", ordering="NONE", setup_cache="NONE",
                      degree=4, thread_model=device, platform_number=0, device_number=0,
                      output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
@@ -44,6 +45,9 @@ def gradientSettings(rcformat="2.0", data_file=gradientData2D,
           setting_t("BOX NY", ny),
           setting_t("BOX NZ", nz),
           setting_t("BOX BOUNDARY FLAG", boundary_flag),
+          setting_t("MESH PARTITIONER", partitioner),
+          setting_t("ELEMENT ORDERING", ordering),
+          setting_t("SETUP CACHE", setup_cache),
           setting_t("POLYNOMIAL DEGREE", degree),
           setting_t("THREAD MODEL", thread_model),
           setting_t("PLATFORM NUMBER", platform_number),
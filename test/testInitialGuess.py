@@ -155,6 +155,20 @@ def main():
                                          pressure_initial_guess_strategy="CLASSIC"),
                     referenceNorm=1.17790533313334)
 
+  #the projected guesses may only change the solution at the solver tolerance,
+  #so the reference is the same run measured without any initial guess
+  noneNorm = solutionNorm(insBin,
+                          insSettings(element=3,data_file=insData2D,dim=2,
+                                      velocity_initial_guess_strategy="NONE",
+                                      pressure_initial_guess_strategy="NONE"))
+
+  failCount += test(name="testInitialGuess_VadaptivePadaptive",
+                    cmd=insBin,
+                    settings=insSettings(element=3,data_file=insData2D,dim=2,
+                                         velocity_initial_guess_strategy="ADAPTIVE",
+                                         pressure_initial_guess_strategy="ADAPTIVE"),
+                    referenceNorm=noneNorm, tol=1e-8)
+
 
   #test wth MPI
   failCount += test(name="testInitialGuess_MPI", ranks=4,
@@ -50,7 +50,7 @@ def insSettings(rcformat="2.0", data_file=insData2D,
                pressure_multigrid_smoother="CHEBYSHEV",
                pressure_paralmond_cycle="KCYCLE",
                 pressure_paralmond_smoother="CHEBYSHEV",
-                output_to_file="FALSE"):
+                trace_connectivity="NODAL", output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
           setting_t("MESH FILE", mesh),
@@ -73,6 +73,7 @@ def insSettings(rcformat="2.0", data_file=insData2D,
           setting_t("CFL NUMBER", cfl),
           setting_t("NUMBER OF SUBCYCLES", num_subcycles),
           setting_t("SUBCYCLING TIME INTEGRATOR", subcycle_integrator),
+          setting_t("TRACE CONNECTIVITY", trace_connectivity),
           setting_t("START TIME", start_time),
           setting_t("FINAL TIME", final_time),
           setting_t("VELOCITY DISCRETIZATION", velocity_discretization),
@@ -94,6 +95,10 @@ def insSettings(rcformat="2.0", data_file=insData2D,
 def main():
   failCount=0;
 
+  #INS solves default to ADAPTIVE projection initial guesses. The references
+  #below were measured without projection, which only changes the solution
+  #at the linear solver tolerance (QR and NONE agree to 1e-10 on testInsTri)
+
   #test non-subcycle
   failCount += test(name="testInsTri",
                     cmd=insBin,
@@ -202,6 +207,22 @@ def main():
                                          time_integrator="SSBDF3"),
                     referenceNorm=1.17790533322325)
 
+  #compact trace connectivity must reproduce the nodal norms
+  failCount += test(name="testInsQuad_compactTrace",
+                    cmd=insBin,
+                    settings=insSettings(element=4,data_file=insData2D,dim=2,
+                                         trace_connectivity="COMPACT"),
+                    referenceNorm=0.818161265312564)
+
+  failCount += test(name="testInsHex_ss_cub_compactTrace",
+                    cmd=insBin,
+                    settings=insSettings(element=12,data_file=insData3D,dim=3,
+                                         nx=6, ny=6, nz=6, degree=2,
+                                         advection_type="CUBATURE",
+                                         time_integrator="SSBDF3",
+                                         trace_connectivity="COMPACT"),
+                    referenceNorm=1.17790533322325)
+
   #test wth MPI
   failCount += test(name="testInsTri_MPI", ranks=4,
                     cmd=insBin,
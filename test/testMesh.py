@@ -28,6 +28,7 @@
 
 from test import *
 from testGradient import *
+import shutil
 
 def main():
   failCount=0;
@@ -113,6 +114,64 @@ def main():
                                               mesh=testDir+"/cubeHex.msh"),
                     referenceNorm=0.942816869518335)
 
+  failCount += test(name="testMeshTri_ReadMsh_Graph_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=3,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareTri.msh",
+                                              partitioner="GRAPH"),
+                    referenceNorm=0.580787485719841)
+
+  failCount += test(name="testMeshHex_ReadMsh_Graph_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=12,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeHex.msh",
+                                              partitioner="GRAPH"),
+                    referenceNorm=0.942816869518335)
+
+  failCount += test(name="testMeshQuad_ReadMsh_Graph_RCM_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareQuad.msh",
+                                              partitioner="GRAPH", ordering="RCM"),
+                    referenceNorm=0.580787485654967)
+
+  failCount += test(name="testMeshTet_ReadMsh_Hilbert_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=6,data_file=gradientData3D,dim=3,
+                                              mesh=testDir+"/cubeTet.msh",
+                                              partitioner="HILBERT", ordering="HILBERT"),
+                    referenceNorm=0.942816947760423)
+
+  failCount += test(name="testMeshQuad_ReadMsh_RCM_MPI", ranks=2,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareQuad.msh",
+                                              ordering="RCM"),
+                    referenceNorm=0.580787485654967)
+
+  #the second run must load the partition and node numbering saved by the
+  #first, as settings that do not change the mesh are not part of the cache key
+  cacheDir = testDir + "/setupCache"
+  shutil.rmtree(cacheDir, ignore_errors=True)
+
+  failCount += test(name="testMeshQuad_ReadMsh_Graph_SetupCache_save_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareQuad.msh",
+                                              partitioner="GRAPH", setup_cache=cacheDir),
+                    referenceNorm=0.580787485654967)
+
+  failCount += test(name="testMeshQuad_ReadMsh_Graph_SetupCache_load_MPI", ranks=4,
+                    cmd=gradientBin,
+                    settings=gradientSettings(element=4,data_file=gradientData2D,dim=2,
+                                              mesh=testDir+"/squareQuad.msh",
+                                              partitioner="GRAPH", setup_cache=cacheDir)
+                             + [setting_t("MEMORY REPORT", "TRUE")],
+                    referenceNorm=0.580787485654967,
+                    output="Loaded mesh connectivity from setup cache")
+
+  shutil.rmtree(cacheDir, ignore_errors=True)
+
   return failCount
 
 if __name__ == "__main__":
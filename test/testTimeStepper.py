@@ -46,6 +46,22 @@ def main():
                                                dim=2, time_integrator="DOPRI5"),
                     referenceNorm=0.723924419144375)
 
+  #the speculative controller accepts steps one reduction late, so it lands on
+  # a slightly different step sequence than the synchronous controller
+  failCount += test(name="testTimeStepper_dopri5_device_controller",
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="DOPRI5",
+                                               device_step_controller="TRUE"),
+                    referenceNorm=0.723924419144375, tol=1.0e-4)
+
+  failCount += test(name="testTimeStepper_dopri5_device_controller_MPI", ranks=4,
+                    cmd=advectionBin,
+                    settings=advectionSettings(element=3,data_file=advectionData2D,
+                                               dim=2, time_integrator="DOPRI5",
+                                               device_step_controller="TRUE"),
+                    referenceNorm=0.723627520020827, tol=1.0e-4)
+
   failCount += test(name="testTimeStepper_lserk4",
                     cmd=advectionBin,
                     settings=advectionSettings(element=3,data_file=advectionData2D,
@@ -64,6 +80,24 @@ def main():
                                          time_integrator="SSBDF3"),
                     referenceNorm=0.67676248716463)
 
+  #the adaptive ARK steppers are compared against a small step EXTBDF3 run
+  # with a tolerance matching their local error control
+  fpeReferenceNorm = solutionNorm(fpeBin,
+                                  fpeSettings(element=3,data_file=fpeData2D,dim=2,
+                                              time_integrator="EXTBDF3", cfl=0.1))
+
+  failCount += test(name="testTimeStepper_ark3",
+                    cmd=fpeBin,
+                    settings=fpeSettings(element=3,data_file=fpeData2D,dim=2,
+                                         time_integrator="ARK3"),
+                    referenceNorm=fpeReferenceNorm, tol=1.0e-4)
+
+  failCount += test(name="testTimeStepper_ark4",
+                    cmd=fpeBin,
+                    settings=fpeSettings(element=3,data_file=fpeData2D,dim=2,
+                                         time_integrator="ARK4"),
+                    referenceNorm=fpeReferenceNorm, tol=1.0e-4)
+
   failCount += test(name="testTimeStepper_ab3_pml",
                     cmd=bnsBin,
                     settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
@@ -94,11 +128,17 @@ def main():
                                          time_integrator="SARK4"),
                     referenceNorm=14.2114867833305)
 
+  #the adaptive SARK5 stepper is compared against a small step SAAB3 run,
+  # which integrates the PML damping the same way, with a tolerance matching
+  # its local error control
   failCount += test(name="testTimeStepper_sark5_pml",
                     cmd=bnsBin,
                     settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
                                          time_integrator="SARK5"),
-                    referenceNorm=14.2397306802799)
+                    referenceNorm=solutionNorm(bnsBin,
+                                               bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                                           time_integrator="SAAB3", cfl=0.1)),
+                    tol=1.0e-4)
 
   failCount += test(name="testTimeStepper_mrab3_pml",
                     cmd=bnsBin,
@@ -106,6 +146,17 @@ def main():
                                          time_integrator="MRAB3", cfl=0.25),
                     referenceNorm=14.2550696512202)
 
+  #repartitioning by multirate level must reproduce the unpartitioned run
+  failCount += test(name="testTimeStepper_mrab3_pml_partition", ranks=4,
+                    cmd=bnsBin,
+                    settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                         time_integrator="MRAB3", cfl=0.25,
+                                         multirate_partition="TRUE"),
+                    referenceNorm=solutionNorm(bnsBin,
+                                               bnsSettings(element=3,data_file=bnsData2D,dim=2,
+                                                           time_integrator="MRAB3", cfl=0.25),
+                                               ranks=4))
+
   failCount += test(name="testTimeStepper_mrsaab3_pml",
                     cmd=bnsBin,
                     settings=bnsSettings(element=3,data_file=bnsData2D,dim=2,